@@ -392,5 +392,69 @@ static void BM_PROU3(benchmark::State& state) {  // benchmark
 
 BENCHMARK(BM_PROU3);  // register benchmark
 
+//=================================
+// NTT benchmarks: fully reduced vs Harvey's lazy butterflies in the scalar kernel
+
+static void NTTLazyArgs(benchmark::internal::Benchmark* b) {
+    for (int lazy : {0, 1}) {
+        for (int bits : {30, 60}) {
+            for (int n : {1 << 12, 1 << 16})
+                b->Args({lazy, bits, n});
+        }
+    }
+}
+
+static void BM_NTT_LAZY(benchmark::State& state) {
+    auto selected{intnat::GetNTTKernelType()};
+    bool lazy{ChineseRemainderTransformFTT<NativeVector>::GetLazyReduction()};
+    intnat::SetNTTKernelType(intnat::NTT_KERNEL_SCALAR);
+    ChineseRemainderTransformFTT<NativeVector>::SetLazyReduction(state.range(0) != 0);
+    uint32_t n = state.range(2);
+    uint32_t m = n << 1;
+
+    NativeInteger modulusQ(LastPrime<NativeInteger>(state.range(1), m));
+    NativeInteger rootOfUnity = RootOfUnity(m, modulusQ);
+
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    NativeVector x = dug.GenerateVector(n, modulusQ);
+
+    ChineseRemainderTransformFTT<NativeVector> crtFTT;
+    crtFTT.PreCompute(rootOfUnity, m, modulusQ);
+
+    for (auto _ : state)
+        crtFTT.ForwardTransformToBitReverseInPlace(rootOfUnity, m, &x);
+
+    ChineseRemainderTransformFTT<NativeVector>::SetLazyReduction(lazy);
+    intnat::SetNTTKernelType(selected);
+}
+
+BENCHMARK(BM_NTT_LAZY)->Unit(benchmark::kMicrosecond)->Apply(NTTLazyArgs);  // register benchmark
+
+static void BM_INTT_LAZY(benchmark::State& state) {
+    auto selected{intnat::GetNTTKernelType()};
+    bool lazy{ChineseRemainderTransformFTT<NativeVector>::GetLazyReduction()};
+    intnat::SetNTTKernelType(intnat::NTT_KERNEL_SCALAR);
+    ChineseRemainderTransformFTT<NativeVector>::SetLazyReduction(state.range(0) != 0);
+    uint32_t n = state.range(2);
+    uint32_t m = n << 1;
+
+    NativeInteger modulusQ(LastPrime<NativeInteger>(state.range(1), m));
+    NativeInteger rootOfUnity = RootOfUnity(m, modulusQ);
+
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    NativeVector x = dug.GenerateVector(n, modulusQ);
+
+    ChineseRemainderTransformFTT<NativeVector> crtFTT;
+    crtFTT.PreCompute(rootOfUnity, m, modulusQ);
+
+    for (auto _ : state)
+        crtFTT.InverseTransformFromBitReverseInPlace(rootOfUnity, m, &x);
+
+    ChineseRemainderTransformFTT<NativeVector>::SetLazyReduction(lazy);
+    intnat::SetNTTKernelType(selected);
+}
+
+BENCHMARK(BM_INTT_LAZY)->Unit(benchmark::kMicrosecond)->Apply(NTTLazyArgs);  // register benchmark
+
 // execute the benchmarks
 BENCHMARK_MAIN();
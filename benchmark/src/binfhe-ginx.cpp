@@ -35,6 +35,10 @@
 
 #include "benchmark/benchmark.h"
 #include "binfhecontext.h"
+#include "utils/parallel.h"
+
+#include <utility>
+#include <vector>
 
 using namespace lbcrypto;
 
@@ -141,6 +145,130 @@ BENCHMARK_CAPTURE(FHEW_BINGATE, STD128_XOR, STD128, XOR)->Unit(benchmark::kMicro
 
 BENCHMARK_CAPTURE(FHEW_BINGATE, STD128_XNOR, STD128, XNOR)->Unit(benchmark::kMicrosecond);
 
+// benchmark for the CMUX gate
+template <class ParamSet>
+void FHEW_CMUX(benchmark::State& state, ParamSet param_set) {
+    BINFHE_PARAMSET param(param_set);
+
+    BinFHEContext cc = GenerateFHEWContext(param);
+
+    LWEPrivateKey sk = cc.KeyGen();
+
+    cc.BTKeyGen(sk);
+
+    std::vector<LWECiphertext> ctvector = {cc.Encrypt(sk, 1), cc.Encrypt(sk, 0), cc.Encrypt(sk, 1)};
+
+    for (auto _ : state) {
+        LWECiphertext ct = cc.EvalBinGate(CMUX, ctvector);
+    }
+}
+
+BENCHMARK_CAPTURE(FHEW_CMUX, MEDIUM, MEDIUM)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(FHEW_CMUX, STD128, STD128)->Unit(benchmark::kMicrosecond);
+
+// the same multiplexer built from three NAND gates, for comparison
+template <class ParamSet>
+void FHEW_CMUX_NAND(benchmark::State& state, ParamSet param_set) {
+    BINFHE_PARAMSET param(param_set);
+
+    BinFHEContext cc = GenerateFHEWContext(param);
+
+    LWEPrivateKey sk = cc.KeyGen();
+
+    cc.BTKeyGen(sk);
+
+    LWECiphertext ct0 = cc.Encrypt(sk, 1);
+    LWECiphertext ct1 = cc.Encrypt(sk, 0);
+    LWECiphertext sel = cc.Encrypt(sk, 1);
+
+    for (auto _ : state) {
+        LWECiphertext ctNAND0 = cc.EvalBinGate(NAND, ct0, cc.EvalNOT(sel));
+        LWECiphertext ctNAND1 = cc.EvalBinGate(NAND, ct1, sel);
+        LWECiphertext ct      = cc.EvalBinGate(NAND, ctNAND0, ctNAND1);
+    }
+}
+
+BENCHMARK_CAPTURE(FHEW_CMUX_NAND, MEDIUM, MEDIUM)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(FHEW_CMUX_NAND, STD128, STD128)->Unit(benchmark::kMicrosecond);
+
+// benchmark for a layer of independent gates evaluated with EvalBinGateBatch; the argument is the number of gates
+template <class ParamSet, class BinGate>
+void FHEW_BINGATE_BATCH(benchmark::State& state, ParamSet param_set, BinGate bin_gate) {
+    BINGATE gate(bin_gate);
+    BINFHE_PARAMSET param(param_set);
+
+    BinFHEContext cc = GenerateFHEWContext(param);
+
+    LWEPrivateKey sk = cc.KeyGen();
+
+    cc.BTKeyGen(sk);
+
+    std::vector<std::pair<LWECiphertext, LWECiphertext>> ctpairs;
+    for (int64_t i = 0; i < state.range(0); ++i)
+        ctpairs.emplace_back(cc.Encrypt(sk, i & 1), cc.Encrypt(sk, 1));
+
+    for (auto _ : state) {
+        std::vector<LWECiphertext> ct = cc.EvalBinGateBatch(gate, ctpairs);
+    }
+    state.SetItemsProcessed(state.iterations() * ctpairs.size());
+}
+
+BENCHMARK_CAPTURE(FHEW_BINGATE_BATCH, MEDIUM_AND, MEDIUM, AND)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->Arg(1)
+    ->Arg(16)
+    ->Arg(256);
+
+BENCHMARK_CAPTURE(FHEW_BINGATE_BATCH, STD128_AND, STD128, AND)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->Arg(1)
+    ->Arg(16)
+    ->Arg(256);
+
+static void ThreadArgs(benchmark::internal::Benchmark* b) {
+    const int maxThreads = OpenFHEParallelControls.GetMachineThreads();
+    for (int threads = 1; threads < maxThreads; threads *= 2)
+        b->Arg(threads);
+    b->Arg(maxThreads);
+}
+
+// benchmark for the scaling of EvalBinGateBatch over threads; the argument is the number of threads
+template <class ParamSet, class BinGate>
+void FHEW_BINGATE_BATCH_THREADS(benchmark::State& state, ParamSet param_set, BinGate bin_gate) {
+    BINGATE gate(bin_gate);
+    BINFHE_PARAMSET param(param_set);
+
+    BinFHEContext cc = GenerateFHEWContext(param);
+
+    LWEPrivateKey sk = cc.KeyGen();
+
+    cc.BTKeyGen(sk);
+
+    std::vector<std::pair<LWECiphertext, LWECiphertext>> ctpairs;
+    for (int64_t i = 0; i < 64; ++i)
+        ctpairs.emplace_back(cc.Encrypt(sk, i & 1), cc.Encrypt(sk, 1));
+
+    OpenFHEParallelControls.SetNumThreads(state.range(0));
+    for (auto _ : state) {
+        std::vector<LWECiphertext> ct = cc.EvalBinGateBatch(gate, ctpairs);
+    }
+    OpenFHEParallelControls.Enable();
+
+    state.SetItemsProcessed(state.iterations() * ctpairs.size());
+}
+
+BENCHMARK_CAPTURE(FHEW_BINGATE_BATCH_THREADS, MEDIUM_AND, MEDIUM, AND)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->Apply(ThreadArgs);
+
+BENCHMARK_CAPTURE(FHEW_BINGATE_BATCH_THREADS, STD128_AND, STD128, AND)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->Apply(ThreadArgs);
+
 // benchmark for key switching
 template <class ParamSet>
 void FHEW_KEYSWITCH(benchmark::State& state, ParamSet param_set) {
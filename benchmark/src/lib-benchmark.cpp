@@ -192,6 +192,65 @@ BENCHMARK(NativeINTT)->Unit(benchmark::kMicrosecond)->Apply(RingArgs);         /
 BENCHMARK(NativeNTTInPlace)->Unit(benchmark::kMicrosecond)->Apply(RingArgs);   // ->Complexity(benchmark::oAuto);
 BENCHMARK(NativeINTTInPlace)->Unit(benchmark::kMicrosecond)->Apply(RingArgs);  // ->Complexity(benchmark::oAuto);
 
+/*
+ * Native NTT benchmarks for each SIMD kernel supported by the CPU
+ */
+
+[[maybe_unused]] static void KernelRingArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"kernel", "modbits", "ringdm"});
+    for (int64_t k = intnat::NTT_KERNEL_SCALAR; k <= intnat::GetSupportedNTTKernelType(); ++k) {
+        for (int64_t bits : {49, 60}) {
+            for (int64_t r : {4096, 65536})
+                b->Args({k, bits, r});
+        }
+    }
+}
+
+[[maybe_unused]] static void NativeNTTKernel(benchmark::State& state) {
+    auto selected{intnat::GetNTTKernelType()};
+    intnat::SetNTTKernelType(static_cast<intnat::NTTKernelType>(state.range(0)));
+    uint32_t n = state.range(2);
+    uint32_t m = n << 1;
+
+    NativeInteger modulusQ(LastPrime<NativeInteger>(state.range(1), m));
+    NativeInteger rootOfUnity = RootOfUnity(m, modulusQ);
+
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    NativeVector x = dug.GenerateVector(n, modulusQ);
+
+    ChineseRemainderTransformFTT<NativeVector> crtFTT;
+    crtFTT.PreCompute(rootOfUnity, m, modulusQ);
+
+    for (auto _ : state)
+        crtFTT.ForwardTransformToBitReverseInPlace(rootOfUnity, m, &x);
+
+    intnat::SetNTTKernelType(selected);
+}
+
+[[maybe_unused]] static void NativeINTTKernel(benchmark::State& state) {
+    auto selected{intnat::GetNTTKernelType()};
+    intnat::SetNTTKernelType(static_cast<intnat::NTTKernelType>(state.range(0)));
+    uint32_t n = state.range(2);
+    uint32_t m = n << 1;
+
+    NativeInteger modulusQ(LastPrime<NativeInteger>(state.range(1), m));
+    NativeInteger rootOfUnity = RootOfUnity(m, modulusQ);
+
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    NativeVector x = dug.GenerateVector(n, modulusQ);
+
+    ChineseRemainderTransformFTT<NativeVector> crtFTT;
+    crtFTT.PreCompute(rootOfUnity, m, modulusQ);
+
+    for (auto _ : state)
+        crtFTT.InverseTransformFromBitReverseInPlace(rootOfUnity, m, &x);
+
+    intnat::SetNTTKernelType(selected);
+}
+
+BENCHMARK(NativeNTTKernel)->Unit(benchmark::kMicrosecond)->Apply(KernelRingArgs);
+BENCHMARK(NativeINTTKernel)->Unit(benchmark::kMicrosecond)->Apply(KernelRingArgs);
+
 /*
  * BFVrns benchmarks
  */
@@ -0,0 +1,194 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Description:
+  This code compares the built-in PRNG engines: raw throughput, uniform sampling of native vectors, and key
+  generation/encryption. Key generation and encryption use the engine of the process, which is selected with
+  --prng=blake2 (default), --prng=chacha20 or --prng=aesctr.
+ */
+
+#define _USE_MATH_DEFINES
+
+#include "benchmark/benchmark.h"
+#include "math/discreteuniformgenerator.h"
+#include "math/distributiongenerator.h"
+#include "math/nbtheory.h"
+#include "utils/prng/aesctrengine.h"
+#include "utils/prng/blake2engine.h"
+#include "utils/prng/chacha20engine.h"
+#include "gen-cryptocontext.h"
+#include "scheme/ckksrns/gen-cryptocontext-ckksrns.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace lbcrypto;
+
+static std::shared_ptr<PRNG> makeEngine(PRNGEngineType type) {
+    const PRNGSeed seed = PseudoRandomNumberGenerator::GenerateSeed();
+    if (type == PRNGEngineType::CHACHA20) {
+        default_prng::ChaCha20Engine::chacha20_key_array_t key;
+        std::copy_n(seed.begin(), key.size(), key.begin());
+        return std::make_shared<default_prng::ChaCha20Engine>(key, 0);
+    }
+    if (type == PRNGEngineType::AESCTR) {
+        default_prng::AesCtrEngine::aesctr_seed_array_t seedMaterial;
+        std::copy_n(seed.begin(), seedMaterial.size(), seedMaterial.begin());
+        return std::make_shared<default_prng::AesCtrEngine>(seedMaterial);
+    }
+    return std::make_shared<default_prng::Blake2Engine>(seed, 0);
+}
+
+static void BM_PRNG_Fill(benchmark::State& state, PRNGEngineType type) {
+    auto prng = makeEngine(type);
+    std::vector<PRNG::result_type> words(1 << 16);
+    while (state.KeepRunning()) {
+        if (type == PRNGEngineType::CHACHA20)
+            static_cast<default_prng::ChaCha20Engine&>(*prng).Fill(words.data(), words.size());
+        else if (type == PRNGEngineType::AESCTR)
+            static_cast<default_prng::AesCtrEngine&>(*prng).Fill(words.data(), words.size());
+        else
+            static_cast<default_prng::Blake2Engine&>(*prng).Fill(words.data(), words.size());
+        benchmark::DoNotOptimize(words.data());
+    }
+    state.SetBytesProcessed(state.iterations() * words.size() * sizeof(PRNG::result_type));
+}
+
+BENCHMARK_CAPTURE(BM_PRNG_Fill, BLAKE2, PRNGEngineType::BLAKE2)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_PRNG_Fill, CHACHA20, PRNGEngineType::CHACHA20)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_PRNG_Fill, AESCTR, PRNGEngineType::AESCTR)->Unit(benchmark::kMicrosecond);
+
+// the AES-CTR engine without AES-NI
+static void BM_PRNG_Fill_AESCTR_Portable(benchmark::State& state) {
+    const PRNGSeed seed = PseudoRandomNumberGenerator::GenerateSeed();
+    default_prng::AesCtrEngine::aesctr_seed_array_t seedMaterial;
+    std::copy_n(seed.begin(), seedMaterial.size(), seedMaterial.begin());
+    default_prng::AesCtrEngine prng(seedMaterial, false);
+    std::vector<PRNG::result_type> words(1 << 16);
+    while (state.KeepRunning()) {
+        prng.Fill(words.data(), words.size());
+        benchmark::DoNotOptimize(words.data());
+    }
+    state.SetBytesProcessed(state.iterations() * words.size() * sizeof(PRNG::result_type));
+}
+
+BENCHMARK(BM_PRNG_Fill_AESCTR_Portable)->Unit(benchmark::kMicrosecond);
+
+static void BM_DUG_GenerateVector(benchmark::State& state, PRNGEngineType type) {
+    const uint32_t n = state.range(0);
+    NativeInteger modulus(FirstPrime<NativeInteger>(MAX_MODULUS_SIZE, 2 * n));
+    DiscreteUniformGeneratorImpl<NativeVector> dug(modulus);
+    dug.SetPRNG(makeEngine(type));
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(dug.GenerateVector(n));
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK_CAPTURE(BM_DUG_GenerateVector, BLAKE2, PRNGEngineType::BLAKE2)
+    ->Unit(benchmark::kMicrosecond)
+    ->Arg(1 << 14)
+    ->Arg(1 << 16);
+BENCHMARK_CAPTURE(BM_DUG_GenerateVector, CHACHA20, PRNGEngineType::CHACHA20)
+    ->Unit(benchmark::kMicrosecond)
+    ->Arg(1 << 14)
+    ->Arg(1 << 16);
+BENCHMARK_CAPTURE(BM_DUG_GenerateVector, AESCTR, PRNGEngineType::AESCTR)
+    ->Unit(benchmark::kMicrosecond)
+    ->Arg(1 << 14)
+    ->Arg(1 << 16);
+
+static CryptoContext<DCRTPoly> GenerateCKKSContext() {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetRingDim(1 << 14);
+    parameters.SetMultiplicativeDepth(10);
+    parameters.SetScalingModSize(50);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+    return cc;
+}
+
+static void BM_KeyGen(benchmark::State& state) {
+    CryptoContext<DCRTPoly> cc = GenerateCKKSContext();
+    while (state.KeepRunning()) {
+        KeyPair<DCRTPoly> kp = cc->KeyGen();
+        cc->EvalMultKeyGen(kp.secretKey);
+    }
+}
+
+BENCHMARK(BM_KeyGen)->Unit(benchmark::kMillisecond);
+
+static void BM_Encrypt(benchmark::State& state) {
+    CryptoContext<DCRTPoly> cc = GenerateCKKSContext();
+    KeyPair<DCRTPoly> kp       = cc->KeyGen();
+    std::vector<double> x(cc->GetEncodingParams()->GetBatchSize(), 0.5);
+    Plaintext ptxt = cc->MakeCKKSPackedPlaintext(x);
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(cc->Encrypt(kp.publicKey, ptxt));
+    }
+}
+
+BENCHMARK(BM_Encrypt)->Unit(benchmark::kMicrosecond);
+
+int main(int argc, char** argv) {
+    // the process-wide engine has to be chosen before anything is sampled
+    PRNGEngineType engine = PRNGEngineType::BLAKE2;
+    int argcBenchmark     = 0;
+    for (int i = 0; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--prng=chacha20") == 0)
+            engine = PRNGEngineType::CHACHA20;
+        else if (std::strcmp(argv[i], "--prng=aesctr") == 0)
+            engine = PRNGEngineType::AESCTR;
+        else if (std::strcmp(argv[i], "--prng=blake2") != 0)
+            argv[argcBenchmark++] = argv[i];
+    }
+    PseudoRandomNumberGenerator::InitPRNGEngine(engine);
+    std::cout << "process PRNG engine: "
+              << (engine == PRNGEngineType::CHACHA20 ? "ChaCha20" :
+                  engine == PRNGEngineType::AESCTR   ? "AES-CTR" :
+                                                       "BLAKE2")
+              << std::endl;
+
+    benchmark::Initialize(&argcBenchmark, argv);
+    if (benchmark::ReportUnrecognizedArguments(argcBenchmark, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
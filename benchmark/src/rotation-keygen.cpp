@@ -0,0 +1,125 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Description:
+  This code measures how the generation of rotation keys and CKKS bootstrapping keys scales with the number
+  of threads. The argument of every benchmark is the number of OpenMP threads.
+ */
+
+#define _USE_MATH_DEFINES
+
+#include "benchmark/benchmark.h"
+#include "gen-cryptocontext.h"
+#include "scheme/ckksrns/gen-cryptocontext-ckksrns.h"
+#include "scheme/ckksrns/ckksrns-fhe.h"
+
+#include <vector>
+
+using namespace lbcrypto;
+
+static void ThreadArgs(benchmark::internal::Benchmark* b) {
+    const int maxThreads = OpenFHEParallelControls.GetMachineThreads();
+    for (int threads = 1; threads < maxThreads; threads *= 2)
+        b->Arg(threads);
+    b->Arg(maxThreads);
+}
+
+static void BM_EvalRotateKeyGen(benchmark::State& state) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetRingDim(1 << 14);
+    parameters.SetMultiplicativeDepth(10);
+    parameters.SetScalingModSize(50);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    KeyPair<DCRTPoly> kp = cc->KeyGen();
+    std::vector<int32_t> indices;
+    for (int32_t i = 1; i <= 32; ++i)
+        indices.push_back(i);
+
+    OpenFHEParallelControls.SetNumThreads(state.range(0));
+    while (state.KeepRunning()) {
+        cc->EvalRotateKeyGen(kp.secretKey, indices);
+
+        state.PauseTiming();
+        cc->ClearEvalAutomorphismKeys();
+        state.ResumeTiming();
+    }
+    OpenFHEParallelControls.Enable();
+
+    state.SetItemsProcessed(state.iterations() * indices.size());
+}
+
+BENCHMARK(BM_EvalRotateKeyGen)->Unit(benchmark::kMillisecond)->UseRealTime()->Apply(ThreadArgs);
+
+static void BM_EvalBootstrapKeyGen(benchmark::State& state) {
+    const SecretKeyDist secretKeyDist       = UNIFORM_TERNARY;
+    const std::vector<uint32_t> levelBudget = {4, 4};
+
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetSecretKeyDist(secretKeyDist);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    parameters.SetRingDim(1 << 12);
+    parameters.SetScalingModSize(59);
+    parameters.SetFirstModSize(60);
+    parameters.SetScalingTechnique(FLEXIBLEAUTO);
+    parameters.SetMultiplicativeDepth(10 + FHECKKSRNS::GetBootstrapDepth(levelBudget, secretKeyDist));
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+    cc->Enable(ADVANCEDSHE);
+    cc->Enable(FHE);
+
+    const uint32_t numSlots = cc->GetRingDimension() / 2;
+    cc->EvalBootstrapSetup(levelBudget);
+    KeyPair<DCRTPoly> kp = cc->KeyGen();
+
+    OpenFHEParallelControls.SetNumThreads(state.range(0));
+    while (state.KeepRunning()) {
+        cc->EvalBootstrapKeyGen(kp.secretKey, numSlots);
+
+        state.PauseTiming();
+        cc->ClearEvalAutomorphismKeys();
+        state.ResumeTiming();
+    }
+    OpenFHEParallelControls.Enable();
+}
+
+BENCHMARK(BM_EvalBootstrapKeyGen)->Unit(benchmark::kMillisecond)->UseRealTime()->Apply(ThreadArgs);
+
+BENCHMARK_MAIN();
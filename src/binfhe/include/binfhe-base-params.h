@@ -87,6 +87,19 @@ public:
         return m_RGSWParams;
     }
 
+    /**
+   * Returns parameters that share the LWE parameters with this object and use
+   * a copy of the RingGSW parameters with the gadget base set to baseG
+   *
+   * @param baseG the new gadget base
+   * @return the new parameters
+   */
+    std::shared_ptr<BinFHECryptoParams> WithBaseG(uint32_t baseG) const {
+        if (m_RGSWParams->GetBaseG() == baseG)
+            return std::make_shared<BinFHECryptoParams>(*this);
+        return std::make_shared<BinFHECryptoParams>(m_LWEParams, m_RGSWParams->WithBaseG(baseG));
+    }
+
     /**
    * Compare two BinFHE sets of parameters
    * @return
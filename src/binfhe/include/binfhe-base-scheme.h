@@ -43,6 +43,7 @@
 
 #include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace lbcrypto {
@@ -114,6 +115,21 @@ public:
     LWECiphertext EvalBinGate(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate, const RingGSWBTKey& EK,
                               const std::vector<LWECiphertext>& ctvector, bool extended = false) const;
 
+    /**
+   * Evaluates a binary gate on many pairs of ciphertexts. The pairs are independent, so their accumulators are
+   * computed concurrently, one pair per thread
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param gate the gate; can be AND, OR, NAND, NOR, XOR, or XNOR
+   * @param EK a shared pointer to the bootstrapping keys
+   * @param ctpairs the pairs of input ciphertexts
+   * @return the resulting ciphertexts in the order of the input pairs
+   */
+    std::vector<LWECiphertext> EvalBinGateBatch(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate,
+                                                const RingGSWBTKey& EK,
+                                                const std::vector<std::pair<LWECiphertext, LWECiphertext>>& ctpairs,
+                                                bool extended = false) const;
+
     /**
    * Evaluates NOT gate
    *
@@ -134,6 +150,18 @@ public:
     LWECiphertext Bootstrap(const std::shared_ptr<BinFHECryptoParams>& params, const RingGSWBTKey& EK,
                             ConstLWECiphertext& ct, bool extended = false) const;
 
+    /**
+   * Bootstraps many ciphertexts concurrently, one ciphertext per thread
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param EK a shared pointer to the bootstrapping keys
+   * @param ctvector the input ciphertexts
+   * @return the resulting ciphertexts in the order of the inputs
+   */
+    std::vector<LWECiphertext> BootstrapBatch(const std::shared_ptr<BinFHECryptoParams>& params,
+                                              const RingGSWBTKey& EK, const std::vector<LWECiphertext>& ctvector,
+                                              bool extended = false) const;
+
     /**
    * Evaluate an arbitrary function
    *
@@ -148,6 +176,25 @@ public:
                            ConstLWECiphertext& ct, const std::vector<NativeInteger>& LUT,
                            const NativeInteger& beta) const;
 
+    /**
+   * Evaluate several arbitrary functions of the same input with multi-value bootstrapping: the look-up tables
+   * share a single test polynomial, so k functions cost as many bootstraps as one. If the ring dimension does not
+   * leave room for k tables at the modulus of the input, the input is switched to a smaller modulus first, which
+   * coarsens the tables and adds rounding noise; this is meant for small plaintext moduli. Negacyclic and
+   * periodic functions are evaluated as two separate groups if both kinds are given. If any function is neither,
+   * all of them are evaluated as arbitrary functions, which requires the modulus of the input q <= N
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param EK a shared pointer to the bootstrapping keys
+   * @param ct input ciphertext
+   * @param LUTs the look-up tables of the to-be-evaluated functions
+   * @param beta the error bound
+   * @return the resulting ciphertexts, one per look-up table
+   */
+    std::vector<LWECiphertext> EvalFunc(const std::shared_ptr<BinFHECryptoParams>& params, const RingGSWBTKey& EK,
+                                        ConstLWECiphertext& ct, const std::vector<std::vector<NativeInteger>>& LUTs,
+                                        const NativeInteger& beta) const;
+
     /**
    * Evaluate a round down function
    *
@@ -231,6 +278,38 @@ private:
     LWECiphertext BootstrapFunc(const std::shared_ptr<BinFHECryptoParams>& params, const RingGSWBTKey& EK,
                                 ConstLWECiphertext& ct, const Func f, const NativeInteger& fmod) const;
 
+    /**
+   * Core bootstrapping operation for several functions of the same input
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param ek a shared pointer to the bootstrapping keys
+   * @param ct input ciphertext
+   * @param f functions to evaluate, called as f(i, x, q, fmod) for the i-th function
+   * @param fmod modulus over which the functions are defined
+   * @param numFuncs number of functions; at most 2N/q
+   * @return the output RingLWE accumulator, with function i in coefficient i
+   */
+    template <typename Func>
+    RLWECiphertext BootstrapFuncMultiCore(const std::shared_ptr<BinFHECryptoParams>& params, ConstRingGSWACCKey& ek,
+                                          ConstLWECiphertext& ct, const Func f, const NativeInteger& fmod,
+                                          uint32_t numFuncs) const;
+
+    /**
+   * Bootstraps a ciphertext once and extracts one ciphertext per function
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param EK a shared pointer to the bootstrapping keys
+   * @param ct input ciphertext
+   * @param f functions to evaluate, called as f(i, x, q, fmod) for the i-th function
+   * @param fmod modulus over which the functions are defined
+   * @param numFuncs number of functions
+   * @return the resulting ciphertexts, one per function
+   */
+    template <typename Func>
+    std::vector<LWECiphertext> BootstrapFuncMulti(const std::shared_ptr<BinFHECryptoParams>& params,
+                                                  const RingGSWBTKey& EK, ConstLWECiphertext& ct, const Func f,
+                                                  const NativeInteger& fmod, uint32_t numFuncs) const;
+
 protected:
     std::shared_ptr<LWEEncryptionScheme> LWEscheme{std::make_shared<LWEEncryptionScheme>()};
     std::shared_ptr<RingGSWAccumulator> ACCscheme{nullptr};
@@ -0,0 +1,191 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  Header file for BinFHECircuit class, which evaluates a DAG of Boolean gates with a BinFHEContext
+ */
+
+#ifndef BINFHE_BINFHECIRCUIT_H
+#define BINFHE_BINFHECIRCUIT_H
+
+#include "binfhecontext.h"
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <vector>
+
+namespace lbcrypto {
+
+/**
+ * @brief A Boolean circuit over FHEW ciphertexts. The circuit is built once from inputs, gates and NOTs, and can then
+ * be executed any number of times with a BinFHEContext. Execute() runs every gate as soon as its operands are
+ * available, so independent gates are bootstrapped concurrently on the OpenMP threads, and drops each intermediate
+ * ciphertext as soon as its last consumer has read it.
+ *
+ * Before execution the circuit is simplified so that it needs as few bootstraps as possible:
+ * - NOT gates are never bootstrapped; double negations cancel out and a NOT is applied (linearly) to the operand
+ *   of the gate that reads it;
+ * - negated operands of XOR/XNOR and pairs of negated operands of AND/OR/NAND/NOR are folded into the gate type;
+ * - a two-input gate whose result is only ever used negated is replaced by its complement;
+ * - gates that no output depends on are not evaluated.
+ *
+ * Multi-input gates (AND3, OR3, AND4, OR4, MAJORITY) combine their operands linearly before a single bootstrap,
+ * and CMUX needs two blind rotations, exactly as in BinFHEContext::EvalBinGate; they should be used instead of
+ * chains of two-input gates.
+ * Note that AND3/OR3 and AND4/OR4 expect operands encrypted with plaintext modulus 6 and 8, respectively, so they
+ * cannot be fed by other gates, whose results use plaintext modulus 4.
+ */
+class BinFHECircuit {
+public:
+    using NodeId = uint32_t;
+
+    /**
+   * Adds an input of the circuit. Inputs are bound to ciphertexts in the order they are added
+   *
+   * @return the id of the new node
+   */
+    NodeId AddInput();
+
+    /**
+   * Adds a two-input gate
+   *
+   * @param gate the gate; can be AND, OR, NAND, NOR, XOR, or XNOR
+   * @param in1 first operand
+   * @param in2 second operand
+   * @return the id of the new node
+   */
+    NodeId AddGate(BINGATE gate, NodeId in1, NodeId in2);
+
+    /**
+   * Adds a gate on a vector of operands
+   *
+   * @param gate the gate; can be MAJORITY, AND3, OR3, AND4, OR4, or CMUX
+   * @param inputs the operands
+   * @return the id of the new node
+   */
+    NodeId AddGate(BINGATE gate, const std::vector<NodeId>& inputs);
+
+    /**
+   * Adds a NOT gate
+   *
+   * @param in the operand
+   * @return the id of the new node
+   */
+    NodeId AddNOT(NodeId in);
+
+    /**
+   * Marks a node as an output of the circuit. Outputs are returned in the order they are added
+   *
+   * @param node the node
+   */
+    void AddOutput(NodeId node);
+
+    uint32_t GetNumInputs() const {
+        return m_inputs.size();
+    }
+
+    uint32_t GetNumOutputs() const {
+        return m_outputs.size();
+    }
+
+    /**
+   * Returns the number of bootstraps a single execution performs after the circuit is simplified
+   *
+   * @return the number of bootstraps
+   */
+    uint32_t GetNumBootstraps() const;
+
+    /**
+   * Evaluates the circuit
+   *
+   * @param cc the context with the bootstrapping keys
+   * @param inputs ciphertexts for the inputs of the circuit
+   * @return ciphertexts for the outputs of the circuit
+   */
+    std::vector<LWECiphertext> Execute(const BinFHEContext& cc, const std::vector<LWECiphertext>& inputs) const;
+
+private:
+    enum NodeKind { INPUT_NODE, GATE_NODE, NOT_NODE };
+
+    struct Node {
+        NodeKind kind;
+        BINGATE gate;
+        std::vector<NodeId> inputs;
+    };
+
+    // the value of a node once NOTs are folded: an input or gate node, possibly negated
+    struct Literal {
+        NodeId node;
+        bool negated;
+    };
+
+    // the simplified circuit; all vectors are indexed by node id
+    struct Plan {
+        std::vector<BINGATE> gates;
+        std::vector<std::vector<Literal>> operands;
+        std::vector<std::vector<NodeId>> consumers;
+        std::vector<uint32_t> uses;
+        std::vector<bool> live;
+        std::vector<bool> isOutput;
+        std::vector<Literal> outputs;
+        uint32_t numBootstraps{0};
+    };
+
+    // the state shared by the tasks of one execution
+    struct ExecState {
+        const BinFHEContext* cc;
+        const Plan* plan;
+        std::vector<LWECiphertext> values;
+        std::vector<std::atomic<uint32_t>> pending;
+        std::vector<std::atomic<uint32_t>> remaining;
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+    };
+
+    NodeId AddNode(NodeKind kind, BINGATE gate, std::vector<NodeId> inputs);
+
+    Plan Compile() const;
+
+    // folds negated operands into the gate type where this does not change the result
+    static BINGATE FoldNegations(BINGATE gate, std::vector<Literal>& operands);
+
+    void ExecuteNode(ExecState* state, NodeId id) const;
+
+    std::vector<Node> m_nodes;
+    std::vector<NodeId> m_inputs;
+    std::vector<NodeId> m_outputs;
+};
+
+}  // namespace lbcrypto
+
+#endif
@@ -44,6 +44,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace lbcrypto {
@@ -313,6 +314,18 @@ public:
    */
     LWECiphertext EvalBinGate(BINGATE gate, const std::vector<LWECiphertext>& ctvector, bool extended = false) const;
 
+    /**
+   * Evaluates a binary gate on many pairs of ciphertexts (calls bootstrapping as a subroutine). The pairs are
+   * bootstrapped concurrently on all available threads, which suits a layer of independent gates of a circuit
+   *
+   * @param gate the gate; can be AND, OR, NAND, NOR, XOR, or XNOR
+   * @param ctpairs the pairs of input ciphertexts
+   * @return the resulting ciphertexts in the order of the input pairs
+   */
+    std::vector<LWECiphertext> EvalBinGateBatch(BINGATE gate,
+                                                const std::vector<std::pair<LWECiphertext, LWECiphertext>>& ctpairs,
+                                                bool extended = false) const;
+
     /**
    * Bootstraps a ciphertext (without peforming any operation)
    *
@@ -321,6 +334,14 @@ public:
    */
     LWECiphertext Bootstrap(ConstLWECiphertext& ct, bool extended = false) const;
 
+    /**
+   * Bootstraps many ciphertexts (without peforming any operation) concurrently on all available threads
+   *
+   * @param ctvector ciphertexts to be bootstrapped
+   * @return the resulting ciphertexts in the order of the inputs
+   */
+    std::vector<LWECiphertext> BootstrapBatch(const std::vector<LWECiphertext>& ctvector, bool extended = false) const;
+
     /**
    * Evaluate an arbitrary function
    *
@@ -330,6 +351,20 @@ public:
    */
     LWECiphertext EvalFunc(ConstLWECiphertext& ct, const std::vector<NativeInteger>& LUT) const;
 
+    /**
+   * Evaluate several arbitrary functions of the same input with a single multi-value bootstrap
+   * (plus the preprocessing bootstrap that periodic and arbitrary functions need), e.g. a digit and its carry.
+   * A mix of negacyclic and periodic functions costs one multi-value bootstrap per kind. If any function is
+   * neither negacyclic nor periodic, all of them are evaluated as arbitrary functions, which requires the
+   * ciphertext modulus q <= N; an exception is thrown otherwise
+   *
+   * @param ct ciphertext to be bootstrapped
+   * @param LUTs the look-up tables of the to-be-evaluated functions
+   * @return the resulting ciphertexts, one per look-up table
+   */
+    std::vector<LWECiphertext> EvalFunc(ConstLWECiphertext& ct,
+                                        const std::vector<std::vector<NativeInteger>>& LUTs) const;
+
     /**
    * Generate the LUT for the to-be-evaluated function
    *
@@ -356,7 +391,7 @@ public:
    * @param schemeSwitch flag that indicates if it should be compatible to scheme switching
    * @return a shared pointer to the resulting ciphertext
    */
-    LWECiphertext EvalSign(ConstLWECiphertext& ct, bool schemeSwitch = false);
+    LWECiphertext EvalSign(ConstLWECiphertext& ct, bool schemeSwitch = false) const;
 
     /**
    * Evaluate ciphertext decomposition
@@ -364,7 +399,7 @@ public:
    * @param ct ciphertext to be bootstrapped
    * @return a vector of shared pointers to the resulting ciphertexts
    */
-    std::vector<LWECiphertext> EvalDecomp(ConstLWECiphertext& ct);
+    std::vector<LWECiphertext> EvalDecomp(ConstLWECiphertext& ct) const;
 
     /**
    * Evaluates NOT gate
@@ -88,9 +88,10 @@ private:
    * @param ek1, ek2 evaluation keys for Ring GSW
    * @param a a value to add to the accumulator
    * @param acc previous value of the accumulator
+   * @param scratch temporaries of the accumulation
    */
     void AddToAccCGGI(const std::shared_ptr<RingGSWCryptoParams>& params, ConstRingGSWEvalKey& ek1,
-                      ConstRingGSWEvalKey& ek2, const NativeInteger& a, RLWECiphertext& acc) const;
+                      ConstRingGSWEvalKey& ek2, const NativeInteger& a, RLWECiphertext& acc, Scratch& scratch) const;
 };
 
 }  // namespace lbcrypto
@@ -97,10 +97,11 @@ private:
    * @param params a shared pointer to RingGSW scheme parameters
    * @param ek evaluation key for Ring GSW
    * @param acc previous value of the accumulator
+   * @param scratch temporaries of the accumulation
    * @return
    */
     void AddToAccLMKCDEY(const std::shared_ptr<RingGSWCryptoParams>& params, ConstRingGSWEvalKey& ek,
-                         RLWECiphertext& acc) const;
+                         RLWECiphertext& acc, Scratch& scratch) const;
 
     /**
    * LMKCDEY Accumulation automorphism evaluation as described in https://eprint.iacr.org/2022/198
@@ -109,10 +110,11 @@ private:
    * @param a index
    * @param ak evaluation key for Ring GSW
    * @param acc previous value of the accumulator
+   * @param scratch temporaries of the accumulation
    * @return
    */
     void Automorphism(const std::shared_ptr<RingGSWCryptoParams>& params, const NativeInteger& a,
-                      ConstRingGSWEvalKey& ak, RLWECiphertext& acc) const;
+                      ConstRingGSWEvalKey& ak, RLWECiphertext& acc, Scratch& scratch) const;
 };
 
 }  // namespace lbcrypto
@@ -97,6 +97,41 @@ public:
    */
     void SignedDigitDecompose(const std::shared_ptr<RingGSWCryptoParams>& params, const NativePoly& input,
                               std::vector<NativePoly>& output) const;
+
+protected:
+    /**
+   * Temporaries of one accumulation, reused by all of its steps. They are owned by the EvalAcc() call, so every
+   * bootstrapping (and every thread of a batch) has its own and nothing outlives the call.
+   */
+    struct Scratch {
+        // copy of the accumulator
+        std::vector<NativePoly> ct;
+        // digits of the gadget decomposition of the accumulator
+        std::vector<NativePoly> digits;
+        // digits of the decomposition in an automorphism step
+        std::vector<NativePoly> automorphismDigits;
+    };
+
+    /**
+   * Prepares count zero polynomials in the COEFFICIENT representation for the digits of a gadget decomposition.
+   * Polynomials left by a previous step are cleared in place instead of being allocated again.
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param digits the polynomials to prepare
+   * @param count the number of polynomials
+   * @return digits
+   */
+    static std::vector<NativePoly>& PrepareDigits(const std::shared_ptr<RingGSWCryptoParams>& params,
+                                                  std::vector<NativePoly>& digits, uint32_t count);
+
+    /**
+   * Copies the elements of acc to ct, reusing the storage of the previous copy
+   *
+   * @param acc the accumulator
+   * @param ct the copy
+   * @return ct
+   */
+    static std::vector<NativePoly>& CopyCiphertext(ConstRLWECiphertext& acc, std::vector<NativePoly>& ct);
 };
 }  // namespace lbcrypto
 
@@ -158,7 +158,7 @@ public:
     }
 
     const NativePoly& GetMonomial(uint32_t i) const {
-        return m_monomials[i];
+        return (*m_monomials)[i];
     }
 
     BINFHE_METHOD GetMethod() const {
@@ -220,10 +220,36 @@ public:
         return 1;
     }
 
+    /**
+   * Returns a copy of these parameters that uses a different gadget base. The
+   * powers of the new base are taken from the table built for sign evaluation,
+   * and the precomputed monomials are shared with the original object, so the
+   * copy is cheap and the original parameters are left untouched. Evaluation
+   * paths that switch the gadget base (EvalSign, EvalDecomp) use this instead of
+   * Change_BaseG so that a context can be used from several threads at once.
+   *
+   * @param baseG the new gadget base
+   * @return parameters that use baseG as the gadget base
+   */
+    std::shared_ptr<RingGSWCryptoParams> WithBaseG(uint32_t baseG) const {
+        auto result = std::make_shared<RingGSWCryptoParams>(*this);
+        result->Change_BaseG(baseG);
+        return result;
+    }
+
+    /**
+   * Switches the gadget base in place. Not safe to call while the parameters
+   * are used by another thread; prefer WithBaseG.
+   *
+   * @param BaseG the new gadget base; must be one of the bases in GetGPowerMap()
+   */
     void Change_BaseG(uint32_t BaseG) {
         if (m_baseG != BaseG) {
+            auto it = m_Gpower_map.find(BaseG);
+            if (it == m_Gpower_map.end())
+                OPENFHE_THROW("No precomputed powers for gadget base " + std::to_string(BaseG));
             m_baseG  = BaseG;
-            m_Gpower = m_Gpower_map[m_baseG];
+            m_Gpower = it->second;
             m_digitsG =
                 static_cast<uint32_t>(std::ceil(log(m_Q.ConvertToDouble()) / log(static_cast<double>(m_baseG))));
         }
@@ -275,8 +301,8 @@ private:
     std::vector<NativeInteger> m_gateConst;
 
     // Precomputed polynomials in Format::EVALUATION representation for X^m - 1
-    // (used only for CGGI bootstrapping)
-    std::vector<NativePoly> m_monomials;
+    // (used only for CGGI bootstrapping); shared between copies made by WithBaseG
+    std::shared_ptr<const std::vector<NativePoly>> m_monomials;
 
     // Bootstrapping method (DM or CGGI or LMKCDEY)
     BINFHE_METHOD m_method{BINFHE_METHOD::INVALID_METHOD};
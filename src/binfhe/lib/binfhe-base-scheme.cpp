@@ -30,11 +30,46 @@
 //==================================================================================
 
 #include "binfhe-base-scheme.h"
+#include "utils/parallel.h"
 
+#include <exception>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace lbcrypto {
 
+// Evaluates f(i) for all i in [0, size) on all threads. Every bootstrapping is independent, so the ciphertexts
+// are distributed over the threads, and every thread caps the parallel loops inside its bootstrappings at one
+// thread, whatever the OpenMP nesting settings are. Each bootstrapping owns the temporaries of its accumulator.
+template <typename Func>
+static std::vector<LWECiphertext> EvalBatch(size_t size, const Func& f) {
+    std::vector<LWECiphertext> result(size);
+    // exceptions cannot leave a parallel region; the first one is rethrown after the batch
+    std::exception_ptr error;
+#pragma omp parallel num_threads(OpenFHEParallelControls.GetThreadLimit(size)) if (size > 1)
+    {
+        const int cap = (size > 1) ? OpenFHEParallelControls.SetThreadCap(1) : OpenFHEParallelControls.GetThreadCap();
+#pragma omp for schedule(dynamic)
+        for (size_t i = 0; i < size; ++i) {
+            try {
+                result[i] = f(i);
+            }
+            catch (...) {
+#pragma omp critical
+                {
+                    if (!error)
+                        error = std::current_exception();
+                }
+            }
+        }
+        OpenFHEParallelControls.SetThreadCap(cap);
+    }
+    if (error)
+        std::rethrow_exception(error);
+    return result;
+}
+
 // wrapper for KeyGen methods
 RingGSWBTKey BinFHEScheme::KeyGen(const std::shared_ptr<BinFHECryptoParams>& params, ConstLWEPrivateKey& LWEsk,
                                   KEYGEN_MODE keygenMode = SYM_ENCRYPT) const {
@@ -163,15 +198,33 @@ LWECiphertext BinFHEScheme::EvalBinGate(const std::shared_ptr<BinFHECryptoParams
         if (length != 3)
             OPENFHE_THROW("CMUX gate implemented for ciphertext vectors of size 3");
 
-        auto&& ctNAND1 = EvalBinGate(params, NAND, EK, ctvector[0], EvalNOT(params, ctvector[2]));
-        auto&& ctNAND2 = EvalBinGate(params, NAND, EK, ctvector[1], ctvector[2]);
-        return EvalBinGate(params, NAND, EK, ctNAND1, ctNAND2);
+        // CMUX(ct0, ct1, s) = AND(ct0, NOT s) + AND(ct1, s) as the two ANDs are never both 1;
+        // the sum is taken before key switching, so it needs one key-switch/mod-switch instead of two. The
+        // blind-rotation noise variance of the sum is twice that of a single gate
+        auto ctAND0 = EvalBinGate(params, AND, EK, ctvector[0], EvalNOT(params, ctvector[2]), true);
+        auto ctAND1 = EvalBinGate(params, AND, EK, ctvector[1], ctvector[2], true);
+        LWEscheme->EvalAddEq(ctAND0, ctAND1);
+
+        if (extended)
+            return ctAND0;
+        return LWEscheme->SwitchCTtoqn(params->GetLWEParams(), EK.KSkey, ctAND0);
     }
     else {
         OPENFHE_THROW("This gate is not implemented for vector of ciphertexts at this time");
     }
 }
 
+std::vector<LWECiphertext> BinFHEScheme::EvalBinGateBatch(
+    const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate, const RingGSWBTKey& EK,
+    const std::vector<std::pair<LWECiphertext, LWECiphertext>>& ctpairs, bool extended) const {
+    if (EK.BSkey == nullptr)
+        OPENFHE_THROW(
+            "Bootstrapping keys have not been generated. Please call BTKeyGen before calling bootstrapping.");
+    return EvalBatch(ctpairs.size(), [&](size_t i) {
+        return EvalBinGate(params, gate, EK, ctpairs[i].first, ctpairs[i].second, extended);
+    });
+}
+
 // Full evaluation as described in https://eprint.iacr.org/2020/086
 LWECiphertext BinFHEScheme::Bootstrap(const std::shared_ptr<BinFHECryptoParams>& params, const RingGSWBTKey& EK,
                                       ConstLWECiphertext& ct, bool extended) const {
@@ -201,6 +254,18 @@ LWECiphertext BinFHEScheme::Bootstrap(const std::shared_ptr<BinFHECryptoParams>&
     return ctExt;
 }
 
+std::vector<LWECiphertext> BinFHEScheme::BootstrapBatch(const std::shared_ptr<BinFHECryptoParams>& params,
+                                                        const RingGSWBTKey& EK,
+                                                        const std::vector<LWECiphertext>& ctvector,
+                                                        bool extended) const {
+    if (EK.BSkey == nullptr)
+        OPENFHE_THROW(
+            "Bootstrapping keys have not been generated. Please call BTKeyGen before calling bootstrapping.");
+    return EvalBatch(ctvector.size(), [&](size_t i) {
+        return Bootstrap(params, EK, ctvector[i], extended);
+    });
+}
+
 // Evaluation of the NOT operation; no key material is needed
 LWECiphertext BinFHEScheme::EvalNOT(const std::shared_ptr<BinFHECryptoParams>& params, ConstLWECiphertext& ct) const {
     NativeInteger q{ct->GetModulus()};
@@ -218,16 +283,74 @@ LWECiphertext BinFHEScheme::EvalNOT(const std::shared_ptr<BinFHECryptoParams>& p
 LWECiphertext BinFHEScheme::EvalFunc(const std::shared_ptr<BinFHECryptoParams>& params, const RingGSWBTKey& EK,
                                      ConstLWECiphertext& ct, const std::vector<NativeInteger>& LUT,
                                      const NativeInteger& beta) const {
+    return EvalFunc(params, EK, ct, std::vector<std::vector<NativeInteger>>{LUT}, beta)[0];
+}
+
+// Evaluate several arbitrary functions of the same input homomorphically
+// All functions share every bootstrap: the final test polynomial stores the LUTs in consecutive coefficients,
+// and one LWE ciphertext is extracted per LUT
+std::vector<LWECiphertext> BinFHEScheme::EvalFunc(const std::shared_ptr<BinFHECryptoParams>& params,
+                                                  const RingGSWBTKey& EK, ConstLWECiphertext& ct,
+                                                  const std::vector<std::vector<NativeInteger>>& LUTs,
+                                                  const NativeInteger& beta) const {
+    if (LUTs.empty())
+        OPENFHE_THROW("At least one look-up table is required");
+
     auto ct1 = std::make_shared<LWECiphertextImpl>(*ct);
     NativeInteger q{ct->GetModulus()};
-    uint32_t functionProperty{this->checkInputFunction(LUT, q)};
+    for (const auto& LUT : LUTs) {
+        if (LUT.size() != q.ConvertToInt())
+            OPENFHE_THROW("The size of a look-up table should be equal to the ciphertext modulus");
+    }
+
+    // an arbitrary function among the LUTs decides that all of them are evaluated as arbitrary functions
+    std::vector<uint32_t> properties(LUTs.size());
+    bool arbitrary{false}, mixed{false};
+    for (size_t i = 0; i < LUTs.size(); ++i) {
+        properties[i] = this->checkInputFunction(LUTs[i], q);
+        arbitrary |= properties[i] == 2;
+        mixed |= properties[i] != properties[0];
+    }
+
+    // negacyclic and periodic functions are evaluated as two groups and reassembled in the input order;
+    // promoting them to arbitrary functions would need q <= N
+    if (mixed && !arbitrary) {
+        std::vector<std::vector<NativeInteger>> groups[2];
+        for (size_t i = 0; i < LUTs.size(); ++i)
+            groups[properties[i]].push_back(LUTs[i]);
+
+        std::vector<LWECiphertext> results[2];
+        for (uint32_t g = 0; g < 2; ++g)
+            results[g] = EvalFunc(params, EK, ct, groups[g], beta);
+
+        std::vector<LWECiphertext> ctOut(LUTs.size());
+        size_t next[2] = {0, 0};
+        for (size_t i = 0; i < LUTs.size(); ++i)
+            ctOut[i] = results[properties[i]][next[properties[i]]++];
+        return ctOut;
+    }
+
+    const uint32_t functionProperty{arbitrary ? 2 : properties[0]};
+    const uint32_t numFuncs = LUTs.size();
+
+    // looks up LUT i for inputs in [0, qIn/2) and uses the negacyclic extension above;
+    // qIn is smaller than qLUT if the input had to be switched down to make room for all LUTs
+    auto fLUTHalf = [&LUTs](const NativeInteger& qLUT) {
+        return [&LUTs, qLUT](uint32_t i, NativeInteger x, NativeInteger qIn, NativeInteger Q) -> NativeInteger {
+            NativeInteger stride{qLUT / qIn};
+            if (x < (qIn >> 1))
+                return LUTs[i][(x * stride).ConvertToInt()];
+            else
+                return Q - LUTs[i][((x - (qIn >> 1)) * stride).ConvertToInt()];
+        };
+    };
 
     if (functionProperty == 0) {  // negacyclic function only needs one bootstrap
-        auto fLUT = [LUT](NativeInteger x, NativeInteger q, NativeInteger Q) -> NativeInteger {
-            return LUT[x.ConvertToInt()];
+        auto fLUT = [&LUTs, q](uint32_t i, NativeInteger x, NativeInteger qIn, NativeInteger Q) -> NativeInteger {
+            return LUTs[i][(x * (q / qIn)).ConvertToInt()];
         };
         LWEscheme->EvalAddConstEq(ct1, beta);
-        return BootstrapFunc(params, EK, ct1, fLUT, q);
+        return BootstrapFuncMulti(params, EK, ct1, fLUT, q, numFuncs);
     }
 
     if (functionProperty == 2) {  // arbitary funciton
@@ -239,14 +362,6 @@ LWECiphertext BinFHEScheme::EvalFunc(const std::shared_ptr<BinFHECryptoParams>&
             OPENFHE_THROW(errMsg);
         }
 
-        // TODO: figure out a way to not do this :(
-
-        // repeat the LUT to make it periodic
-        std::vector<NativeInteger> LUT2;
-        LUT2.reserve(LUT.size() + LUT.size());
-        LUT2.insert(LUT2.end(), LUT.begin(), LUT.end());
-        LUT2.insert(LUT2.end(), LUT.begin(), LUT.end());
-
         NativeInteger dq{q << 1};
         // raise the modulus of ct1 : q -> 2q
         ct1->GetA().SetModulus(dq);
@@ -266,15 +381,11 @@ LWECiphertext BinFHEScheme::EvalFunc(const std::shared_ptr<BinFHECryptoParams>&
         LWEscheme->EvalSubConstEq(ct3, q >> 1);
 
         // Now the input is within the range [0, q/2).
-        // Note that for non-periodic function, the input q is boosted up to 2q
-        auto fLUT2 = [LUT2](NativeInteger x, NativeInteger q, NativeInteger Q) -> NativeInteger {
-            if (x < (q >> 1))
-                return LUT2[x.ConvertToInt()];
-            else
-                return Q - LUT2[x.ConvertToInt() - q.ConvertToInt() / 2];
-        };
-        auto ct4 = BootstrapFunc(params, EK, ct3, fLUT2, dq);
-        ct4->SetModulus(q);
+        // Note that for non-periodic function, the input q is boosted up to 2q,
+        // so the LUT (repeated twice to make it periodic) only needs to be looked up in [0, q)
+        auto ct4 = BootstrapFuncMulti(params, EK, ct3, fLUTHalf(dq), dq, numFuncs);
+        for (auto& ctOut : ct4)
+            ctOut->SetModulus(q);
         return ct4;
     }
 
@@ -294,13 +405,7 @@ LWECiphertext BinFHEScheme::EvalFunc(const std::shared_ptr<BinFHECryptoParams>&
 
     // Now the input is within the range [0, q/2).
     // Note that for non-periodic function, the input q is boosted up to 2q
-    auto fLUT1 = [LUT](NativeInteger x, NativeInteger q, NativeInteger Q) -> NativeInteger {
-        if (x < (q >> 1))
-            return LUT[x.ConvertToInt()];
-        else
-            return Q - LUT[x.ConvertToInt() - q.ConvertToInt() / 2];
-    };
-    return BootstrapFunc(params, EK, ct2, fLUT1, q);
+    return BootstrapFuncMulti(params, EK, ct2, fLUTHalf(q), q, numFuncs);
 }
 
 // Evaluate Homomorphic Flooring
@@ -364,10 +469,12 @@ LWECiphertext BinFHEScheme::EvalSign(const std::shared_ptr<BinFHECryptoParams>&
         OPENFHE_THROW(errMsg);
     }
     RingGSWBTKey curEK(search->second);
+    // the gadget base may change below; keep it per call so the shared params are never modified
+    auto curParams = params;
 
     auto cttmp = std::make_shared<LWECiphertextImpl>(*ct);
     while (mod > q) {
-        cttmp = EvalFloor(params, curEK, cttmp, beta);
+        cttmp = EvalFloor(curParams, curEK, cttmp, beta);
         // round Q to 2betaQ/q
         //  mod   = mod / q * 2 * beta;
         mod   = (mod << 1) * beta / q;
@@ -384,7 +491,7 @@ LWECiphertext BinFHEScheme::EvalSign(const std::shared_ptr<BinFHECryptoParams>&
                 base = static_cast<uint32_t>(1) << 18;
 
             if (0 != base) {  // if base is to change ...
-                RGSWParams->Change_BaseG(base);
+                curParams = params->WithBaseG(base);
 
                 auto search = EKs.find(base);
                 if (search == EKs.end()) {
@@ -402,7 +509,7 @@ LWECiphertext BinFHEScheme::EvalSign(const std::shared_ptr<BinFHECryptoParams>&
         auto f3 = [](NativeInteger x, NativeInteger q, NativeInteger Q) -> NativeInteger {
             return (x < q / 2) ? (Q / 4) : (Q - Q / 4);
         };
-        cttmp = BootstrapFunc(params, curEK, cttmp, f3, q);  // this is 1/4q_small or -1/4q_small mod q
+        cttmp = BootstrapFunc(curParams, curEK, cttmp, f3, q);  // this is 1/4q_small or -1/4q_small mod q
         LWEscheme->EvalSubConstEq(cttmp, q >> 2);
     }
     else {  // return the negated f3 and do not subtract q/4 for a more natural encoding in scheme switching
@@ -410,9 +517,8 @@ LWECiphertext BinFHEScheme::EvalSign(const std::shared_ptr<BinFHECryptoParams>&
         auto f3 = [](NativeInteger x, NativeInteger q, NativeInteger Q) -> NativeInteger {
             return (x < q / 2) ? (Q - Q / 4) : (Q / 4);
         };
-        cttmp = BootstrapFunc(params, curEK, cttmp, f3, q);  // this is 1/4q_small or -1/4q_small mod q
+        cttmp = BootstrapFunc(curParams, curEK, cttmp, f3, q);  // this is 1/4q_small or -1/4q_small mod q
     }
-    RGSWParams->Change_BaseG(curBase);
     return cttmp;
 }
 
@@ -438,6 +544,8 @@ std::vector<LWECiphertext> BinFHEScheme::EvalDecomp(const std::shared_ptr<BinFHE
         OPENFHE_THROW(errMsg);
     }
     RingGSWBTKey curEK(search->second);
+    // the gadget base may change below; keep it per call so the shared params are never modified
+    auto curParams = params;
 
     auto cttmp = std::make_shared<LWECiphertextImpl>(*ct);
     std::vector<LWECiphertext> ret;
@@ -447,7 +555,7 @@ std::vector<LWECiphertext> BinFHEScheme::EvalDecomp(const std::shared_ptr<BinFHE
         ret.push_back(std::move(ctq));
 
         // Floor the input sequentially to obtain the most significant bit
-        cttmp = EvalFloor(params, curEK, cttmp, beta);
+        cttmp = EvalFloor(curParams, curEK, cttmp, beta);
         mod   = mod / q * 2 * beta;
         // round Q to 2betaQ/q
         cttmp = LWEscheme->ModSwitch(mod, cttmp);
@@ -461,7 +569,7 @@ std::vector<LWECiphertext> BinFHEScheme::EvalDecomp(const std::shared_ptr<BinFHE
                 base = static_cast<uint32_t>(1) << 18;
 
             if (0 != base) {  // if base is to change ...
-                RGSWParams->Change_BaseG(base);
+                curParams = params->WithBaseG(base);
 
                 auto search = EKs.find(base);
                 if (search == EKs.end()) {
@@ -472,7 +580,6 @@ std::vector<LWECiphertext> BinFHEScheme::EvalDecomp(const std::shared_ptr<BinFHE
             }
         }
     }
-    RGSWParams->Change_BaseG(curBase);
     ret.push_back(std::move(cttmp));
     return ret;
 }
@@ -546,6 +653,16 @@ template <typename Func>
 RLWECiphertext BinFHEScheme::BootstrapFuncCore(const std::shared_ptr<BinFHECryptoParams>& params,
                                                ConstRingGSWACCKey& ek, ConstLWECiphertext& ct, const Func f,
                                                const NativeInteger& fmod) const {
+    auto fi = [&f](uint32_t, NativeInteger x, NativeInteger q, NativeInteger Q) -> NativeInteger {
+        return f(x, q, Q);
+    };
+    return BootstrapFuncMultiCore(params, ek, ct, fi, fmod, 1);
+}
+
+template <typename Func>
+RLWECiphertext BinFHEScheme::BootstrapFuncMultiCore(const std::shared_ptr<BinFHECryptoParams>& params,
+                                                    ConstRingGSWACCKey& ek, ConstLWECiphertext& ct, const Func f,
+                                                    const NativeInteger& fmod, uint32_t numFuncs) const {
     if (ek == nullptr) {
         std::string errMsg =
             "Bootstrapping keys have not been generated. Please call BTKeyGen before calling bootstrapping.";
@@ -563,9 +680,14 @@ RLWECiphertext BinFHEScheme::BootstrapFuncCore(const std::shared_ptr<BinFHECrypt
     NativeInteger ctMod    = ct->GetModulus();
     uint32_t factor        = (2 * N / ctMod.ConvertToInt());
     const NativeInteger& b = ct->GetB();
+    // the rotation is always a multiple of factor, so the coefficients between two entries of
+    // the first LUT are free to hold further LUTs; coefficient i of the accumulator then yields LUT i
+    if (numFuncs > factor)
+        OPENFHE_THROW("At most " + std::to_string(factor) + " functions can share one bootstrap");
     for (size_t j = 0; j < (ctMod >> 1); ++j) {
         NativeInteger temp = b.ModSub(j, ctMod);
-        m[j * factor]      = Q.ConvertToInt() / fmod.ConvertToInt() * f(temp, ctMod, fmod);
+        for (uint32_t i = 0; i < numFuncs; ++i)
+            m[j * factor + i] = Q.ConvertToInt() / fmod.ConvertToInt() * f(i, temp, ctMod, fmod);
     }
     std::vector<NativePoly> res(2);
     // no need to do NTT as all coefficients of this poly are zero
@@ -604,4 +726,56 @@ LWECiphertext BinFHEScheme::BootstrapFunc(const std::shared_ptr<BinFHECryptoPara
     return LWEscheme->ModSwitch(fmod, ctKS);
 }
 
+// Multi-value bootstrapping: one blind rotation evaluates numFuncs functions of the same input
+template <typename Func>
+std::vector<LWECiphertext> BinFHEScheme::BootstrapFuncMulti(const std::shared_ptr<BinFHECryptoParams>& params,
+                                                            const RingGSWBTKey& EK, ConstLWECiphertext& ct,
+                                                            const Func f, const NativeInteger& fmod,
+                                                            uint32_t numFuncs) const {
+    auto& LWEParams = params->GetLWEParams();
+    NativeInteger Q = LWEParams->GetQ();
+    uint32_t N      = LWEParams->GetN();
+
+    // each function takes one of the 2N/q coefficients per LUT entry; if there are not enough of them,
+    // the input is switched to a smaller modulus, which coarsens the LUTs and adds rounding noise
+    std::shared_ptr<const LWECiphertextImpl> ctIn = ct;
+    uint32_t slots = 2 * N / ct->GetModulus().ConvertToInt();
+    if (numFuncs > slots) {
+        uint32_t stride = 1;
+        while (slots * stride < numFuncs)
+            stride <<= 1;
+        NativeInteger mod{ct->GetModulus() / NativeInteger(stride)};
+        if (mod < NativeInteger(4))
+            OPENFHE_THROW("Too many functions to evaluate in one bootstrap");
+        ctIn = LWEscheme->ModSwitch(mod, ct);
+    }
+
+    auto accVec{BootstrapFuncMultiCore(params, EK.BSkey, ctIn, f, fmod, numFuncs)->GetElements()};
+    accVec[0].SetFormat(Format::COEFFICIENT);
+    accVec[1].SetFormat(Format::COEFFICIENT);
+
+    std::vector<LWECiphertext> result;
+    result.reserve(numFuncs);
+    for (uint32_t i = 0; i < numFuncs; ++i) {
+        // sample extraction of coefficient i: (a * s)_i = sum_{j <= i} a_{i-j} s_j - sum_{j > i} a_{N+i-j} s_j
+        // for i = 0 this is the transpose of "a"
+        NativeVector a(N, Q);
+        for (uint32_t j = 0; j <= i; ++j)
+            a[j] = accVec[0][i - j];
+        for (uint32_t j = i + 1; j < N; ++j) {
+            const auto& v = accVec[0][N + i - j];
+            a[j]          = v == 0 ? 0 : Q - v;
+        }
+        auto ctExt = std::make_shared<LWECiphertextImpl>(std::move(a), accVec[1][i]);
+
+        // Modulus switching to a middle step Q'
+        auto ctMS = LWEscheme->ModSwitch(LWEParams->GetqKS(), ctExt);
+        // Key switching
+        auto ctKS = LWEscheme->KeySwitch(LWEParams, EK.KSkey, ctMS);
+        // Modulus switching
+        result.push_back(LWEscheme->ModSwitch(fmod, ctKS));
+    }
+    return result;
+}
+
 };  // namespace lbcrypto
@@ -0,0 +1,382 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  Implementation file for BinFHECircuit class
+ */
+
+#include "binfhecircuit.h"
+
+#include <string>
+#include <utility>
+
+namespace lbcrypto {
+
+static bool IsTwoInputGate(BINGATE gate) {
+    switch (gate) {
+        case AND:
+        case OR:
+        case NAND:
+        case NOR:
+        case XOR:
+        case XNOR:
+        case XOR_FAST:
+        case XNOR_FAST:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// the gate computing NOT(gate(a, b)), or gate itself if there is no such gate
+static BINGATE Complement(BINGATE gate) {
+    switch (gate) {
+        case AND:
+            return NAND;
+        case NAND:
+            return AND;
+        case OR:
+            return NOR;
+        case NOR:
+            return OR;
+        case XOR:
+            return XNOR;
+        case XNOR:
+            return XOR;
+        case XOR_FAST:
+            return XNOR_FAST;
+        case XNOR_FAST:
+            return XOR_FAST;
+        default:
+            return gate;
+    }
+}
+
+static uint32_t BootstrapsPerGate(BINGATE gate) {
+    // CMUX needs two blind rotations
+    return (gate == CMUX) ? 2 : 1;
+}
+
+BinFHECircuit::NodeId BinFHECircuit::AddNode(NodeKind kind, BINGATE gate, std::vector<NodeId> inputs) {
+    const NodeId id = m_nodes.size();
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (inputs[i] >= id)
+            OPENFHE_THROW("Node " + std::to_string(inputs[i]) + " does not exist");
+        for (size_t j = i + 1; j < inputs.size(); ++j) {
+            if (inputs[i] == inputs[j])
+                OPENFHE_THROW("Operands of a gate should be independent nodes");
+        }
+    }
+    m_nodes.push_back({kind, gate, std::move(inputs)});
+    return id;
+}
+
+BinFHECircuit::NodeId BinFHECircuit::AddInput() {
+    const NodeId id = AddNode(INPUT_NODE, OR, {});
+    m_inputs.push_back(id);
+    return id;
+}
+
+BinFHECircuit::NodeId BinFHECircuit::AddGate(BINGATE gate, NodeId in1, NodeId in2) {
+    if (!IsTwoInputGate(gate))
+        OPENFHE_THROW("This gate is not implemented for two ciphertexts");
+    return AddNode(GATE_NODE, gate, {in1, in2});
+}
+
+BinFHECircuit::NodeId BinFHECircuit::AddGate(BINGATE gate, const std::vector<NodeId>& inputs) {
+    if (inputs.size() == 2)
+        return AddGate(gate, inputs[0], inputs[1]);
+
+    size_t arity{0};
+    if ((gate == AND3) || (gate == OR3) || (gate == MAJORITY) || (gate == CMUX))
+        arity = 3;
+    else if ((gate == AND4) || (gate == OR4))
+        arity = 4;
+    else
+        OPENFHE_THROW("This gate is not implemented for vector of ciphertexts at this time");
+
+    if (inputs.size() != arity)
+        OPENFHE_THROW("Gate expects " + std::to_string(arity) + " operands, got " + std::to_string(inputs.size()));
+    return AddNode(GATE_NODE, gate, inputs);
+}
+
+BinFHECircuit::NodeId BinFHECircuit::AddNOT(NodeId in) {
+    return AddNode(NOT_NODE, OR, {in});
+}
+
+void BinFHECircuit::AddOutput(NodeId node) {
+    if (node >= m_nodes.size())
+        OPENFHE_THROW("Node " + std::to_string(node) + " does not exist");
+    m_outputs.push_back(node);
+}
+
+uint32_t BinFHECircuit::GetNumBootstraps() const {
+    return Compile().numBootstraps;
+}
+
+BINGATE BinFHECircuit::FoldNegations(BINGATE gate, std::vector<Literal>& operands) {
+    // gate(a, NOT a) needs the negation to keep the operands independent
+    if ((operands.size() == 2) && (operands[0].node == operands[1].node))
+        return gate;
+
+    switch (gate) {
+        case XOR:
+        case XNOR:
+        case XOR_FAST:
+        case XNOR_FAST:
+            // XOR(NOT a, b) = XNOR(a, b)
+            for (auto& op : operands) {
+                if (op.negated) {
+                    gate       = Complement(gate);
+                    op.negated = false;
+                }
+            }
+            return gate;
+        case AND:
+        case OR:
+        case NAND:
+        case NOR:
+            // De Morgan: AND(NOT a, NOT b) = NOR(a, b), OR(NOT a, NOT b) = NAND(a, b)
+            if (operands[0].negated && operands[1].negated) {
+                operands[0].negated = false;
+                operands[1].negated = false;
+                switch (gate) {
+                    case AND:
+                        return NOR;
+                    case OR:
+                        return NAND;
+                    case NAND:
+                        return OR;
+                    default:
+                        return AND;
+                }
+            }
+            return gate;
+        default:
+            return gate;
+    }
+}
+
+BinFHECircuit::Plan BinFHECircuit::Compile() const {
+    const uint32_t n = m_nodes.size();
+
+    Plan plan;
+    plan.gates.resize(n, OR);
+    plan.operands.resize(n);
+    plan.consumers.resize(n);
+    plan.uses.resize(n, 0);
+    plan.live.resize(n, false);
+    plan.isOutput.resize(n, false);
+
+    // NOT nodes disappear: each node is replaced by an input or gate node, possibly negated
+    std::vector<Literal> literals(n);
+    for (NodeId id = 0; id < n; ++id) {
+        const auto& node = m_nodes[id];
+        if (node.kind == NOT_NODE) {
+            const auto& in = literals[node.inputs[0]];
+            literals[id]   = {in.node, !in.negated};
+            continue;
+        }
+        literals[id] = {id, false};
+        if (node.kind == INPUT_NODE)
+            continue;
+
+        auto& operands = plan.operands[id];
+        for (auto in : node.inputs) {
+            for (const auto& op : operands) {
+                if ((op.node == literals[in].node) && (op.negated == literals[in].negated))
+                    OPENFHE_THROW("Operands of gate " + std::to_string(id) + " reduce to the same ciphertext");
+            }
+            operands.push_back(literals[in]);
+        }
+        plan.gates[id] = FoldNegations(node.gate, operands);
+    }
+
+    for (auto out : m_outputs) {
+        const auto& lit = literals[out];
+        plan.outputs.push_back(lit);
+        plan.isOutput[lit.node] = true;
+        plan.live[lit.node]     = true;
+    }
+
+    // only the gates some output depends on are evaluated; operands always precede their gate
+    for (NodeId id = n; id-- > 0;) {
+        if (plan.live[id]) {
+            for (const auto& op : plan.operands[id])
+                plan.live[op.node] = true;
+        }
+    }
+
+    // a gate whose result is only ever used negated is replaced by its complement
+    std::vector<uint32_t> numUses(n, 0), numNegatedUses(n, 0);
+    for (NodeId id = 0; id < n; ++id) {
+        if (!plan.live[id])
+            continue;
+        for (const auto& op : plan.operands[id]) {
+            ++numUses[op.node];
+            numNegatedUses[op.node] += op.negated;
+        }
+    }
+    for (const auto& out : plan.outputs) {
+        ++numUses[out.node];
+        numNegatedUses[out.node] += out.negated;
+    }
+    std::vector<bool> complemented(n, false);
+    for (NodeId id = 0; id < n; ++id) {
+        if (plan.live[id] && (m_nodes[id].kind == GATE_NODE) && (numUses[id] == numNegatedUses[id]) &&
+            IsTwoInputGate(plan.gates[id])) {
+            plan.gates[id]   = Complement(plan.gates[id]);
+            complemented[id] = true;
+        }
+    }
+
+    for (NodeId id = 0; id < n; ++id) {
+        if (!plan.live[id] || (m_nodes[id].kind != GATE_NODE))
+            continue;
+        for (auto& op : plan.operands[id]) {
+            if (complemented[op.node])
+                op.negated = false;
+            if (m_nodes[op.node].kind == GATE_NODE)
+                plan.consumers[op.node].push_back(id);
+            ++plan.uses[op.node];
+        }
+        plan.numBootstraps += BootstrapsPerGate(plan.gates[id]);
+    }
+    for (auto& out : plan.outputs) {
+        if (complemented[out.node])
+            out.negated = false;
+    }
+
+    return plan;
+}
+
+void BinFHECircuit::ExecuteNode(ExecState* state, NodeId id) const {
+    if (state->failed)
+        return;
+
+    const auto& plan = *state->plan;
+    try {
+        std::vector<LWECiphertext> operands;
+        operands.reserve(plan.operands[id].size());
+        for (const auto& op : plan.operands[id]) {
+            const auto& ct = state->values[op.node];
+            operands.push_back(op.negated ? state->cc->EvalNOT(ct) : ct);
+        }
+
+        state->values[id] = (operands.size() == 2) ?
+                                state->cc->EvalBinGate(plan.gates[id], operands[0], operands[1]) :
+                                state->cc->EvalBinGate(plan.gates[id], operands);
+
+        // intermediate results are dropped as soon as their last consumer has read them
+        for (const auto& op : plan.operands[id]) {
+            if ((state->remaining[op.node].fetch_sub(1) == 1) && !plan.isOutput[op.node])
+                state->values[op.node].reset();
+        }
+    }
+    catch (...) {
+#pragma omp critical
+        {
+            if (!state->error)
+                state->error = std::current_exception();
+        }
+        state->failed = true;
+        return;
+    }
+
+    for (auto c : plan.consumers[id]) {
+        if (state->pending[c].fetch_sub(1) == 1) {
+#pragma omp task firstprivate(state, c)
+            ExecuteNode(state, c);
+        }
+    }
+}
+
+std::vector<LWECiphertext> BinFHECircuit::Execute(const BinFHEContext& cc,
+                                                  const std::vector<LWECiphertext>& inputs) const {
+    if (inputs.size() != m_inputs.size())
+        OPENFHE_THROW("Expected " + std::to_string(m_inputs.size()) + " input ciphertexts, got " +
+                      std::to_string(inputs.size()));
+
+    const Plan plan  = Compile();
+    const uint32_t n = m_nodes.size();
+
+    ExecState state;
+    state.cc        = &cc;
+    state.plan      = &plan;
+    state.values    = std::vector<LWECiphertext>(n);
+    state.pending   = std::vector<std::atomic<uint32_t>>(n);
+    state.remaining = std::vector<std::atomic<uint32_t>>(n);
+
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (inputs[i] == nullptr)
+            OPENFHE_THROW("Input ciphertext " + std::to_string(i) + " is null");
+        state.values[m_inputs[i]] = inputs[i];
+    }
+
+    // gates whose operands are all inputs can start right away
+    std::vector<NodeId> ready;
+    for (NodeId id = 0; id < n; ++id) {
+        state.remaining[id] = plan.uses[id];
+        if (!plan.live[id] || (m_nodes[id].kind != GATE_NODE))
+            continue;
+        uint32_t count{0};
+        for (const auto& op : plan.operands[id])
+            count += (m_nodes[op.node].kind == GATE_NODE);
+        state.pending[id] = count;
+        if (count == 0)
+            ready.push_back(id);
+    }
+
+    // each gate is a task, so idle threads pick up whichever gates became ready
+    ExecState* pState = &state;
+#pragma omp parallel if (plan.numBootstraps > 1)
+#pragma omp single
+    {
+        for (auto id : ready) {
+#pragma omp task firstprivate(pState, id)
+            ExecuteNode(pState, id);
+        }
+    }
+
+    if (state.error)
+        std::rethrow_exception(state.error);
+
+    std::vector<LWECiphertext> result;
+    result.reserve(plan.outputs.size());
+    for (const auto& out : plan.outputs) {
+        const auto& ct = state.values[out.node];
+        result.push_back(out.negated ? cc.EvalNOT(ct) : ct);
+    }
+    return result;
+}
+
+}  // namespace lbcrypto
@@ -261,11 +261,8 @@ void BinFHEContext::BTKeyGen(ConstLWEPrivateKey& sk, KEYGEN_MODE keygenMode) {
     auto temp = RGSWParams->GetBaseG();
 
     if (m_timeOptimization) {
-        for (auto&& [k, v] : RGSWParams->GetGPowerMap()) {
-            RGSWParams->Change_BaseG(k);
-            m_BTKey_map[k] = m_binfhescheme->KeyGen(m_params, sk, keygenMode);
-        }
-        RGSWParams->Change_BaseG(temp);
+        for (auto&& [k, v] : RGSWParams->GetGPowerMap())
+            m_BTKey_map[k] = m_binfhescheme->KeyGen(m_params->WithBaseG(k), sk, keygenMode);
     }
 
     if (m_BTKey_map.size() != 0) {
@@ -285,10 +282,20 @@ LWECiphertext BinFHEContext::EvalBinGate(const BINGATE gate, const std::vector<L
     return m_binfhescheme->EvalBinGate(m_params, gate, m_BTKey, ctvector, extended);
 }
 
+std::vector<LWECiphertext> BinFHEContext::EvalBinGateBatch(
+    const BINGATE gate, const std::vector<std::pair<LWECiphertext, LWECiphertext>>& ctpairs, bool extended) const {
+    return m_binfhescheme->EvalBinGateBatch(m_params, gate, m_BTKey, ctpairs, extended);
+}
+
 LWECiphertext BinFHEContext::Bootstrap(ConstLWECiphertext& ct, bool extended) const {
     return m_binfhescheme->Bootstrap(m_params, m_BTKey, ct, extended);
 }
 
+std::vector<LWECiphertext> BinFHEContext::BootstrapBatch(const std::vector<LWECiphertext>& ctvector,
+                                                         bool extended) const {
+    return m_binfhescheme->BootstrapBatch(m_params, m_BTKey, ctvector, extended);
+}
+
 LWECiphertext BinFHEContext::EvalNOT(ConstLWECiphertext& ct) const {
     return m_binfhescheme->EvalNOT(m_params, ct);
 }
@@ -301,6 +308,11 @@ LWECiphertext BinFHEContext::EvalFunc(ConstLWECiphertext& ct, const std::vector<
     return m_binfhescheme->EvalFunc(m_params, m_BTKey, ct, LUT, GetBeta());
 }
 
+std::vector<LWECiphertext> BinFHEContext::EvalFunc(ConstLWECiphertext& ct,
+                                                   const std::vector<std::vector<NativeInteger>>& LUTs) const {
+    return m_binfhescheme->EvalFunc(m_params, m_BTKey, ct, LUTs, GetBeta());
+}
+
 LWECiphertext BinFHEContext::EvalFloor(ConstLWECiphertext& ct, uint32_t roundbits) const {
     //    auto q = m_params->GetLWEParams()->Getq().ConvertToInt();
     //    if (roundbits != 0) {
@@ -312,12 +324,11 @@ LWECiphertext BinFHEContext::EvalFloor(ConstLWECiphertext& ct, uint32_t roundbit
     return m_binfhescheme->EvalFloor(m_params, m_BTKey, ct, GetBeta(), roundbits);
 }
 
-LWECiphertext BinFHEContext::EvalSign(ConstLWECiphertext& ct, bool schemeSwitch) {
-    return m_binfhescheme->EvalSign(std::make_shared<BinFHECryptoParams>(*m_params), m_BTKey_map, ct, GetBeta(),
-                                    schemeSwitch);
+LWECiphertext BinFHEContext::EvalSign(ConstLWECiphertext& ct, bool schemeSwitch) const {
+    return m_binfhescheme->EvalSign(m_params, m_BTKey_map, ct, GetBeta(), schemeSwitch);
 }
 
-std::vector<LWECiphertext> BinFHEContext::EvalDecomp(ConstLWECiphertext& ct) {
+std::vector<LWECiphertext> BinFHEContext::EvalDecomp(ConstLWECiphertext& ct) const {
     return m_binfhescheme->EvalDecomp(m_params, m_BTKey_map, ct, GetBeta());
 }
 
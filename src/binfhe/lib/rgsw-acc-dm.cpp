@@ -66,12 +66,13 @@ void RingGSWAccumulatorDM::EvalAcc(const std::shared_ptr<RingGSWCryptoParams>& p
     auto digitsR = params->GetDigitsR().size();
     uint32_t n   = a.GetLength();
 
+    Scratch scratch;
     for (uint32_t i = 0; i < n; ++i) {
         auto aI = NativeInteger(0).ModSubFast(a[i], q);
         for (size_t k = 0; k < digitsR; ++k, aI /= baseR) {
             auto a0 = (aI.Mod(baseR)).ConvertToInt<uint32_t>();
             if (a0)
-                AddToAccDM(params, (*ek)[i][a0][k], acc);
+                AddToAccDM(params, (*ek)[i][a0][k], acc, scratch);
         }
     }
 }
@@ -116,14 +117,14 @@ RingGSWEvalKey RingGSWAccumulatorDM::KeyGenDM(const std::shared_ptr<RingGSWCrypt
 
 // AP Accumulation as described in https://eprint.iacr.org/2020/086
 void RingGSWAccumulatorDM::AddToAccDM(const std::shared_ptr<RingGSWCryptoParams>& params, ConstRingGSWEvalKey& ek,
-                                      RLWECiphertext& acc) const {
-    std::vector<NativePoly> ct(acc->GetElements());
+                                      RLWECiphertext& acc, Scratch& scratch) const {
+    auto& ct = CopyCiphertext(acc, scratch.ct);
     ct[0].SetFormat(Format::COEFFICIENT);
     ct[1].SetFormat(Format::COEFFICIENT);
 
     // approximate gadget decomposition is used; the first digit is ignored
     uint32_t digitsG2{(params->GetDigitsG() - 1) << 1};
-    std::vector<NativePoly> dct(digitsG2, NativePoly(params->GetPolyParams(), Format::COEFFICIENT, true));
+    auto& dct = PrepareDigits(params, scratch.digits, digitsG2);
 
     SignedDigitDecompose(params, ct, dct);
 
@@ -93,6 +93,7 @@ void RingGSWAccumulatorLMKCDEY::EvalAcc(const std::shared_ptr<RingGSWCryptoParam
         indexVec.push_back(i);
     }
 
+    Scratch scratch;
     NativeInteger gen(5);
     uint32_t genInt       = 5;
     uint32_t nSkips       = 0;
@@ -102,18 +103,18 @@ void RingGSWAccumulatorLMKCDEY::EvalAcc(const std::shared_ptr<RingGSWCryptoParam
     for (uint32_t i = Nh - 1; i > 0; i--) {
         if (permuteMap.find(-i) != permuteMap.end()) {
             if (nSkips != 0) {  // Rotation by 5^nSkips
-                Automorphism(params, gen.ModExp(nSkips, M), (*ek)[0][1][nSkips], acc);
+                Automorphism(params, gen.ModExp(nSkips, M), (*ek)[0][1][nSkips], acc, scratch);
                 nSkips = 0;
             }
             auto& indexVec = permuteMap[-i];
             for (size_t j = 0; j < indexVec.size(); j++) {
-                AddToAccLMKCDEY(params, (*ek)[0][0][indexVec[j]], acc);
+                AddToAccLMKCDEY(params, (*ek)[0][0][indexVec[j]], acc, scratch);
             }
         }
         nSkips++;
 
         if (nSkips == numAutoKeys || i == 1) {
-            Automorphism(params, gen.ModExp(nSkips, M), (*ek)[0][1][nSkips], acc);
+            Automorphism(params, gen.ModExp(nSkips, M), (*ek)[0][1][nSkips], acc, scratch);
             nSkips = 0;
         }
     }
@@ -122,28 +123,28 @@ void RingGSWAccumulatorLMKCDEY::EvalAcc(const std::shared_ptr<RingGSWCryptoParam
     if (permuteMap.find(M) != permuteMap.end()) {
         auto& indexVec = permuteMap[M];
         for (size_t j = 0; j < indexVec.size(); j++) {
-            AddToAccLMKCDEY(params, (*ek)[0][0][indexVec[j]], acc);
+            AddToAccLMKCDEY(params, (*ek)[0][0][indexVec[j]], acc, scratch);
         }
     }
 
-    Automorphism(params, NativeInteger(M - genInt), (*ek)[0][1][0], acc);
+    Automorphism(params, NativeInteger(M - genInt), (*ek)[0][1][0], acc, scratch);
     // for a_j = 5^i
     for (size_t i = Nh - 1; i > 0; i--) {
         if (permuteMap.find(i) != permuteMap.end()) {
             if (nSkips != 0) {  // Rotation by 5^nSkips
-                Automorphism(params, gen.ModExp(nSkips, M), (*ek)[0][1][nSkips], acc);
+                Automorphism(params, gen.ModExp(nSkips, M), (*ek)[0][1][nSkips], acc, scratch);
                 nSkips = 0;
             }
 
             auto& indexVec = permuteMap[i];
             for (size_t j = 0; j < indexVec.size(); j++) {
-                AddToAccLMKCDEY(params, (*ek)[0][0][indexVec[j]], acc);
+                AddToAccLMKCDEY(params, (*ek)[0][0][indexVec[j]], acc, scratch);
             }
         }
         nSkips++;
 
         if (nSkips == numAutoKeys || i == 1) {
-            Automorphism(params, gen.ModExp(nSkips, M), (*ek)[0][1][nSkips], acc);
+            Automorphism(params, gen.ModExp(nSkips, M), (*ek)[0][1][nSkips], acc, scratch);
             nSkips = 0;
         }
     }
@@ -152,7 +153,7 @@ void RingGSWAccumulatorLMKCDEY::EvalAcc(const std::shared_ptr<RingGSWCryptoParam
     if (permuteMap.find(0) != permuteMap.end()) {
         auto& indexVec = permuteMap[0];
         for (size_t j = 0; j < indexVec.size(); j++) {
-            AddToAccLMKCDEY(params, (*ek)[0][0][indexVec[j]], acc);
+            AddToAccLMKCDEY(params, (*ek)[0][0][indexVec[j]], acc, scratch);
         }
     }
 }
@@ -226,15 +227,16 @@ RingGSWEvalKey RingGSWAccumulatorLMKCDEY::KeyGenAuto(const std::shared_ptr<RingG
 // LMKCDEY Accumulation as described in https://eprint.iacr.org/2022/198
 // Same as AP, but multiplied once
 void RingGSWAccumulatorLMKCDEY::AddToAccLMKCDEY(const std::shared_ptr<RingGSWCryptoParams>& params,
-                                                ConstRingGSWEvalKey& ek, RLWECiphertext& acc) const {
-    std::vector<NativePoly> ct(acc->GetElements());
+                                                ConstRingGSWEvalKey& ek, RLWECiphertext& acc,
+                                                Scratch& scratch) const {
+    auto& ct = CopyCiphertext(acc, scratch.ct);
     ct[0].SetFormat(Format::COEFFICIENT);
     ct[1].SetFormat(Format::COEFFICIENT);
 
     // approximate gadget decomposition is used; the first digit is ignored
     uint32_t digitsG2{(params->GetDigitsG() - 1) << 1};
 
-    std::vector<NativePoly> dct(digitsG2, NativePoly(params->GetPolyParams(), Format::COEFFICIENT, true));
+    auto& dct = PrepareDigits(params, scratch.digits, digitsG2);
 
     SignedDigitDecompose(params, ct, dct);
 
@@ -255,7 +257,7 @@ void RingGSWAccumulatorLMKCDEY::AddToAccLMKCDEY(const std::shared_ptr<RingGSWCry
 
 // Automorphism
 void RingGSWAccumulatorLMKCDEY::Automorphism(const std::shared_ptr<RingGSWCryptoParams>& params, const NativeInteger& a,
-                                             ConstRingGSWEvalKey& ak, RLWECiphertext& acc) const {
+                                             ConstRingGSWEvalKey& ak, RLWECiphertext& acc, Scratch& scratch) const {
     // precompute bit reversal for the automorphism into vec
     uint32_t N{params->GetN()};
     std::vector<usint> vec(N);
@@ -270,7 +272,7 @@ void RingGSWAccumulatorLMKCDEY::Automorphism(const std::shared_ptr<RingGSWCrypto
 
     // approximate gadget decomposition is used; the first digit is ignored
     uint32_t digitsG{params->GetDigitsG() - 1};
-    std::vector<NativePoly> dcta(digitsG, NativePoly(params->GetPolyParams(), Format::COEFFICIENT, true));
+    auto& dcta = PrepareDigits(params, scratch.automorphismDigits, digitsG);
 
     SignedDigitDecompose(params, cta, dcta);
 
@@ -51,6 +51,30 @@
 
 namespace lbcrypto {
 
+std::vector<NativePoly>& RingGSWAccumulator::PrepareDigits(const std::shared_ptr<RingGSWCryptoParams>& params,
+                                                           std::vector<NativePoly>& digits, uint32_t count) {
+    const auto& polyParams = params->GetPolyParams();
+    if (digits.size() != count || digits.empty() || digits[0].GetParams() != polyParams) {
+        digits.assign(count, NativePoly(polyParams, Format::COEFFICIENT, true));
+        return digits;
+    }
+    // the previous step left the digits in the EVALUATION representation; they are cleared in place
+    for (auto& d : digits) {
+        d = uint64_t{0};
+        d.OverrideFormat(Format::COEFFICIENT);
+    }
+    return digits;
+}
+
+std::vector<NativePoly>& RingGSWAccumulator::CopyCiphertext(ConstRLWECiphertext& acc, std::vector<NativePoly>& ct) {
+    const auto& elements = acc->GetElements();
+    ct.resize(elements.size());
+    // assignment reuses the storage of the previous copy
+    for (size_t i = 0; i < elements.size(); ++i)
+        ct[i] = elements[i];
+    return ct;
+}
+
 void RingGSWAccumulator::SignedDigitDecompose(const std::shared_ptr<RingGSWCryptoParams>& params,
                                               const std::vector<NativePoly>& input,
                                               std::vector<NativePoly>& output) const {
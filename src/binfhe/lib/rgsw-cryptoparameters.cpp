@@ -95,21 +95,23 @@ void RingGSWCryptoParams::PreCompute(bool signEval) {
     // CGGI bootstrapping
     if (m_method == BINFHE_METHOD::GINX) {
         constexpr NativeInteger one{1};
-        m_monomials.reserve(2 * m_N);
+        std::vector<NativePoly> monomials;
+        monomials.reserve(2 * m_N);
         for (uint32_t i = 0; i < m_N; ++i) {
             NativePoly aPoly(m_polyParams, Format::COEFFICIENT, true);
             aPoly[0].ModSubFastEq(one, m_Q);  // -1
             aPoly[i].ModAddFastEq(one, m_Q);  // X^m
             aPoly.SetFormat(Format::EVALUATION);
-            m_monomials.push_back(std::move(aPoly));
+            monomials.push_back(std::move(aPoly));
         }
         for (uint32_t i = 0; i < m_N; ++i) {
             NativePoly aPoly(m_polyParams, Format::COEFFICIENT, true);
             aPoly[0].ModSubFastEq(one, m_Q);  // -1
             aPoly[i].ModSubFastEq(one, m_Q);  // -X^m
             aPoly.SetFormat(Format::EVALUATION);
-            m_monomials.push_back(std::move(aPoly));
+            monomials.push_back(std::move(aPoly));
         }
+        m_monomials = std::make_shared<const std::vector<NativePoly>>(std::move(monomials));
     }
 
     if (m_method == LMKCDEY) {
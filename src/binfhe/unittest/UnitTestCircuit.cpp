@@ -0,0 +1,116 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  This code runs unit tests for the Boolean circuit executor of the OpenFHE lattice encryption library
+ */
+
+#include "binfhecircuit.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace lbcrypto;
+
+// 2-bit adder with a few NOTs and a dead gate that the executor should optimize away
+static BinFHECircuit MakeAdderCircuit() {
+    BinFHECircuit circuit;
+    auto a0 = circuit.AddInput();
+    auto a1 = circuit.AddInput();
+    auto b0 = circuit.AddInput();
+    auto b1 = circuit.AddInput();
+
+    auto s0 = circuit.AddGate(XOR, a0, b0);
+    auto c0 = circuit.AddGate(AND, a0, b0);
+    auto t  = circuit.AddGate(XOR, a1, b1);
+    // XOR(NOT t, c0) folds into XNOR(t, c0); the outer NOT cancels it back
+    auto s1 = circuit.AddNOT(circuit.AddGate(XOR, circuit.AddNOT(t), c0));
+    auto c1 = circuit.AddGate(MAJORITY, {a1, b1, c0});
+    // NOT(NAND) is evaluated as a single AND
+    auto both = circuit.AddNOT(circuit.AddGate(NAND, s0, s1));
+    circuit.AddGate(OR, a0, a1);
+
+    circuit.AddOutput(s0);
+    circuit.AddOutput(s1);
+    circuit.AddOutput(c1);
+    circuit.AddOutput(both);
+    return circuit;
+}
+
+TEST(UnitTestFHEWCircuit, Adder) {
+    auto cc = BinFHEContext();
+    cc.GenerateBinFHEContext(TOY, GINX);
+    auto sk = cc.KeyGen();
+    cc.BTKeyGen(sk);
+
+    auto circuit = MakeAdderCircuit();
+    EXPECT_EQ(4u, circuit.GetNumInputs());
+    EXPECT_EQ(4u, circuit.GetNumOutputs());
+    EXPECT_EQ(6u, circuit.GetNumBootstraps());
+
+    std::string failed = "Circuit evaluation failed";
+    for (uint32_t a = 0; a < 4; ++a) {
+        for (uint32_t b = 0; b < 4; ++b) {
+            std::vector<LWECiphertext> inputs = {cc.Encrypt(sk, a & 1), cc.Encrypt(sk, a >> 1), cc.Encrypt(sk, b & 1),
+                                                 cc.Encrypt(sk, b >> 1)};
+            auto outputs = circuit.Execute(cc, inputs);
+            ASSERT_EQ(4u, outputs.size()) << failed;
+
+            uint32_t sum = a + b;
+            std::vector<LWEPlaintext> expected = {sum & 1, (sum >> 1) & 1, sum >> 2, (sum & 1) & ((sum >> 1) & 1)};
+            for (size_t i = 0; i < outputs.size(); ++i) {
+                LWEPlaintext result;
+                cc.Decrypt(sk, outputs[i], &result);
+                EXPECT_EQ(expected[i], result) << failed << " for " << a << " + " << b << ", output " << i;
+            }
+        }
+    }
+}
+
+TEST(UnitTestFHEWCircuit, InvalidCircuit) {
+    BinFHECircuit circuit;
+    auto a = circuit.AddInput();
+    auto b = circuit.AddInput();
+
+    EXPECT_THROW(circuit.AddGate(AND, a, a), OpenFHEException);
+    EXPECT_THROW(circuit.AddGate(AND3, {a, b}), OpenFHEException);
+    EXPECT_THROW(circuit.AddGate(MAJORITY, a, b), OpenFHEException);
+    EXPECT_THROW(circuit.AddNOT(5), OpenFHEException);
+
+    // a and NOT(NOT(a)) are the same ciphertext
+    circuit.AddOutput(circuit.AddGate(AND, a, circuit.AddNOT(circuit.AddNOT(a))));
+    EXPECT_THROW(circuit.GetNumBootstraps(), OpenFHEException);
+
+    auto cc = BinFHEContext();
+    cc.GenerateBinFHEContext(TOY, GINX);
+    EXPECT_THROW(circuit.Execute(cc, {}), OpenFHEException);
+}
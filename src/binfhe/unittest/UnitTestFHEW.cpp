@@ -38,6 +38,8 @@
 
 #include "gtest/gtest.h"
 #include <sstream>
+#include <utility>
+#include <vector>
 
 using namespace lbcrypto;
 
@@ -59,6 +61,7 @@ enum TEST_CASE_TYPE {
     FHEW_OR4,
     FHEW_MAJORITY,
     FHEW_CMUX,
+    FHEW_BATCH,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -112,6 +115,9 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case FHEW_CMUX:
             typeName = "FHEW_CMUX";
             break;
+        case FHEW_BATCH:
+            typeName = "FHEW_BATCH";
+            break;
         default:
             typeName = "UNKNOWN_TESTTYPE";
             break;
@@ -211,6 +217,10 @@ static std::vector<TEST_CASE_UTGENERAL_FHEW> testCasesUTGENERAL_FHEW = {
     { FHEW_CMUX, "02", TOY,      AP,           3,           4,        CMUX,      {1, 0} },
     { FHEW_CMUX, "03", TOY,      LMKCDEY,      3,           4,        CMUX,      {1, 0} },
     // ==========================================
+    { FHEW_BATCH, "01", TOY,     GINX,         2,           4,        NAND,      {0, 1, 1, 1} },
+    { FHEW_BATCH, "02", TOY,     AP,           2,           4,        NAND,      {0, 1, 1, 1} },
+    { FHEW_BATCH, "03", TOY,     LMKCDEY,      2,           4,        NAND,      {0, 1, 1, 1} },
+    // ==========================================
     { FHEW_SIGNED_MODE, "01", SIGNED_MOD_TEST, GINX, 2,     4,        AND, {1, 0, 0, 0} },
     // ==========================================
     { FHEW_KEY_SWITCH, "01", TOY,      GINX,    2,          4,        OR, {1, 0} },  // OR is not needed; added as a random value
@@ -373,6 +383,62 @@ protected:
         }
     }
 
+    void UnitTest_FHEW_BATCH(const TEST_CASE_UTGENERAL_FHEW& testData, const std::string& failmsg = std::string()) {
+        try {
+            auto cc = BinFHEContext();
+            cc.GenerateBinFHEContext(testData.securityLevel, testData.method);
+
+            auto sk = cc.KeyGen();
+
+            cc.BTKeyGen(sk);
+
+            // several copies of the inputs 11, 01, 10, 00
+            constexpr size_t copies = 4;
+            const std::vector<std::pair<LWEPlaintext, LWEPlaintext>> inputs = {{1, 1}, {0, 1}, {1, 0}, {0, 0}};
+            std::vector<std::pair<LWECiphertext, LWECiphertext>> ctpairs;
+            std::vector<LWECiphertext> ctvector;
+            for (size_t c = 0; c < copies; ++c) {
+                for (const auto& [m1, m2] : inputs) {
+                    ctpairs.emplace_back(cc.Encrypt(sk, m1), cc.Encrypt(sk, m2));
+                    ctvector.push_back(cc.Encrypt(sk, m1));
+                }
+            }
+
+            std::vector<LWECiphertext> ctGates = cc.EvalBinGateBatch(testData.gate, ctpairs);
+            std::vector<LWECiphertext> ctBoots = cc.BootstrapBatch(ctvector);
+            ASSERT_EQ(ctGates.size(), ctpairs.size()) << failmsg;
+            ASSERT_EQ(ctBoots.size(), ctvector.size()) << failmsg;
+
+            std::string failed = testData.toString() + " failed";
+            for (size_t i = 0; i < ctpairs.size(); ++i) {
+                LWEPlaintext result;
+                cc.Decrypt(sk, ctGates[i], &result);
+                EXPECT_EQ(testData.results[i % inputs.size()], result) << failed << " for the gate " << i;
+                cc.Decrypt(sk, ctBoots[i], &result);
+                EXPECT_EQ(inputs[i % inputs.size()].first, result) << failed << " for the bootstrapping " << i;
+            }
+
+            // an error in one of the gates is reported to the caller
+            ctpairs[1].second = ctpairs[1].first;
+            EXPECT_THROW(cc.EvalBinGateBatch(testData.gate, ctpairs), OpenFHEException) << failed;
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+
     void UnitTest_FHEW(const TEST_CASE_UTGENERAL_FHEW& testData, const std::string& failmsg = std::string()) {
         try {
             auto cc = BinFHEContext();
@@ -521,6 +587,17 @@ protected:
 
             EXPECT_EQ(testData.results[0], result1) << failed;
             EXPECT_EQ(testData.results[1], result0) << failed;
+
+            // all combinations of the two inputs and the selector
+            for (LWEPlaintext i = 0; i < 8; ++i) {
+                LWEPlaintext a = i & 1, b = (i >> 1) & 1, sel = i >> 2;
+                std::vector<LWECiphertext> ctvector = {cc.Encrypt(sk, a, SMALL_DIM, testData.ptmodulus),
+                                                       cc.Encrypt(sk, b, SMALL_DIM, testData.ptmodulus),
+                                                       cc.Encrypt(sk, sel, SMALL_DIM, testData.ptmodulus)};
+                LWEPlaintext result;
+                cc.Decrypt(sk, cc.EvalBinGate(testData.gate, ctvector), &result, testData.ptmodulus);
+                EXPECT_EQ(sel ? b : a, result) << failed << " for " << a << ", " << b << ", " << sel;
+            }
         }
         catch (std::exception& e) {
             std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
@@ -564,6 +641,9 @@ TEST_P(UTGENERAL_FHEW, BINFHE) {
         case FHEW_CMUX:
             UnitTest_FHEW_CMUX(test, test.buildTestName());
             break;
+        case FHEW_BATCH:
+            UnitTest_FHEW_BATCH(test, test.buildTestName());
+            break;
         case FHEW_KEY_SWITCH:
             UnitTest_FHEW_KeySwitch(test, test.buildTestName());
             break;
@@ -36,6 +36,10 @@
 #include "binfhecontext.h"
 #include "gtest/gtest.h"
 
+#include <exception>
+#include <thread>
+#include <vector>
+
 using namespace lbcrypto;
 
 // ---------------  TESTING METHODS OF FHEW ---------------
@@ -70,6 +74,83 @@ TEST(UnitTestFHEWGINX, EvalArbFunc) {
     }
 }
 
+// Checks the evaluation of several functions with one multi-value bootstrap
+TEST(UnitTestFHEWGINX, EvalMultiFunc) {
+    auto cc = BinFHEContext();
+    cc.GenerateBinFHEContext(TOY, true, 12);
+    auto sk = cc.KeyGen();
+    cc.BTKeyGen(sk);
+    int p = cc.GetMaxPlaintextSpace().ConvertToInt();
+
+    std::string failed = "Multi-value Function Evaluation failed";
+
+    // arbitrary functions; three of them do not fit the ring without switching to a smaller modulus
+    auto fCube = [](NativeInteger m, NativeInteger p1) -> NativeInteger {
+        return (m * m * m) % p1;
+    };
+    auto fInc = [](NativeInteger m, NativeInteger p1) -> NativeInteger {
+        return (m + 1) % p1;
+    };
+    auto fHalf = [](NativeInteger m, NativeInteger p1) -> NativeInteger {
+        return m >> 1;
+    };
+    std::vector<std::vector<NativeInteger>> luts = {cc.GenerateLUTviaFunction(fCube, p),
+                                                    cc.GenerateLUTviaFunction(fInc, p),
+                                                    cc.GenerateLUTviaFunction(fHalf, p)};
+    for (int i = 0; i < p; i++) {
+        auto ct1     = cc.Encrypt(sk, i, LARGE_DIM, p);
+        auto results = cc.EvalFunc(ct1, luts);
+        ASSERT_EQ(luts.size(), results.size()) << failed;
+
+        std::vector<NativeInteger> expected = {fCube(i, p), fInc(i, p), fHalf(i, p)};
+        for (size_t j = 0; j < results.size(); ++j) {
+            LWEPlaintext result;
+            cc.Decrypt(sk, results[j], &result, p);
+            EXPECT_EQ(usint(expected[j].ConvertToInt()), result) << failed << " for input " << i << ", function " << j;
+        }
+    }
+
+    // negacyclic functions, f(m + p/2) = -f(m), only need the multi-value bootstrap itself
+    auto fNeg = [](NativeInteger m, NativeInteger p1) -> NativeInteger {
+        return (m < (p1 >> 1)) ? m + 1 : p1 - (m - (p1 >> 1) + 1);
+    };
+    auto fNegMinus = [](NativeInteger m, NativeInteger p1) -> NativeInteger {
+        return p1 - ((m < (p1 >> 1)) ? m + 1 : p1 - (m - (p1 >> 1) + 1));
+    };
+    luts = {cc.GenerateLUTviaFunction(fNeg, p), cc.GenerateLUTviaFunction(fNegMinus, p)};
+    for (int i = 0; i < p; i++) {
+        auto ct1     = cc.Encrypt(sk, i, LARGE_DIM, p);
+        auto results = cc.EvalFunc(ct1, luts);
+        ASSERT_EQ(luts.size(), results.size()) << failed;
+
+        std::vector<NativeInteger> expected = {fNeg(i, p), fNegMinus(i, p)};
+        for (size_t j = 0; j < results.size(); ++j) {
+            LWEPlaintext result;
+            cc.Decrypt(sk, results[j], &result, p);
+            EXPECT_EQ(usint(expected[j].ConvertToInt()), result) << failed << " for input " << i << ", function " << j;
+        }
+    }
+
+    // a mix of negacyclic and periodic functions, f(m + p/2) = f(m), is evaluated as two groups
+    auto fDouble = [](NativeInteger m, NativeInteger p1) -> NativeInteger {
+        return (m << 1) % p1;
+    };
+    luts = {cc.GenerateLUTviaFunction(fDouble, p), cc.GenerateLUTviaFunction(fNeg, p),
+            cc.GenerateLUTviaFunction(fDouble, p)};
+    for (int i = 0; i < p; i++) {
+        auto ct1     = cc.Encrypt(sk, i, LARGE_DIM, p);
+        auto results = cc.EvalFunc(ct1, luts);
+        ASSERT_EQ(luts.size(), results.size()) << failed;
+
+        std::vector<NativeInteger> expected = {fDouble(i, p), fNeg(i, p), fDouble(i, p)};
+        for (size_t j = 0; j < results.size(); ++j) {
+            LWEPlaintext result;
+            cc.Decrypt(sk, results[j], &result, p);
+            EXPECT_EQ(usint(expected[j].ConvertToInt()), result) << failed << " for input " << i << ", function " << j;
+        }
+    }
+}
+
 // Checks the rounding down evaluation
 TEST(UnitTestFHEWGINX, EvalFloorFunc) {
     auto cc = BinFHEContext();
@@ -263,4 +344,64 @@ TEST(UnitTestFHEWGINX, EvalDigitDecompSpace) {
         }
     }
 }
+// Checks that one context can be used from several threads at once while EvalSign and EvalDecomp
+// switch the gadget base and other threads run gate bootstrapping with the default base
+TEST(UnitTestFHEWGINX, EvalConcurrent) {
+    auto cc = BinFHEContext();
+    cc.GenerateBinFHEContext(TOY, false, 29, 0, GINX, true);
+
+    uint32_t Q = 1 << 29;
+    int q      = 4096;
+    int factor = 1 << int(29 - log2(q));
+    int p      = cc.GetMaxPlaintextSpace().ConvertToInt();
+    auto sk    = cc.KeyGen();
+    cc.BTKeyGen(sk);
+
+    constexpr size_t numThreads = 8;
+    constexpr size_t numIters   = 4;
+
+    // ciphertexts are prepared up front; the worker threads only evaluate
+    std::vector<LWECiphertext> ctSign(numIters), ctBit(numIters);
+    for (size_t i = 0; i < numIters; ++i) {
+        ctSign[i] = cc.Encrypt(sk, p * factor / 2 + i - 2, LARGE_DIM, p * factor, Q);
+        ctBit[i]  = cc.Encrypt(sk, i % 2);
+    }
+
+    std::vector<std::vector<LWECiphertext>> results(numThreads, std::vector<LWECiphertext>(numIters));
+    std::vector<std::exception_ptr> errors(numThreads);
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < numThreads; ++t) {
+        workers.emplace_back([&, t]() {
+            try {
+                for (size_t i = 0; i < numIters; ++i) {
+                    if (t % 3 == 0)
+                        results[t][i] = cc.EvalSign(ctSign[i]);
+                    else if (t % 3 == 1)
+                        results[t][i] = cc.EvalDecomp(ctSign[i]).back();
+                    else
+                        results[t][i] = cc.EvalBinGate(NAND, ctBit[i], ctBit[(i + 1) % numIters]);
+                }
+            }
+            catch (...) {
+                errors[t] = std::current_exception();
+            }
+        });
+    }
+    for (auto& w : workers)
+        w.join();
+
+    std::string failed = "Concurrent evaluation failed";
+    for (size_t t = 0; t < numThreads; ++t) {
+        ASSERT_EQ(nullptr, errors[t]) << failed;
+        for (size_t i = 0; i < numIters; ++i) {
+            LWEPlaintext result;
+            // EvalSign returns the sign bit; the last digit of EvalDecomp is the most significant bit
+            cc.Decrypt(sk, results[t][i], &result, 2);
+            if (t % 3 == 2)
+                EXPECT_EQ(usint(1), result) << failed;
+            else
+                EXPECT_EQ(usint(i >= 2), result) << failed;
+        }
+    }
+}
 #endif
@@ -929,6 +929,25 @@ public:
                                              const std::vector<std::vector<NativeInteger>>& QHatModp,
                                              const std::vector<DoubleNativeInt>& modpBarrettMu) const = 0;
 
+    /**
+   * @brief Same as ApproxSwitchCRTBasis() above, but writes the result into a caller-provided polynomial.
+   * If ans is already allocated over paramsP, its towers are reused and no memory is allocated;
+   * otherwise it is (re)initialized over paramsP.
+   *
+   * @param &paramsQ parameters for the CRT basis {q_1,...,q_l}
+   * @param &paramsP parameters for the CRT basis {p_1,...,p_k}
+   * @param &QHatinvModq precomputed values for [(Q/q_i)^{-1}]_{q_i}
+   * @param &QHatinvModqPrecon NTL-specific precomputations
+   * @param &QHatModp precomputed values for [Q/q_i]_{p_j}
+   * @param &modpBarrettMu 128-bit Barrett reduction precomputed values
+   * @param *ans output: the representation of {X + alpha*Q} in basis {P}; must not be this polynomial.
+   */
+    virtual void ApproxSwitchCRTBasis(const std::shared_ptr<Params>& paramsQ, const std::shared_ptr<Params>& paramsP,
+                                      const std::vector<NativeInteger>& QHatInvModq,
+                                      const std::vector<NativeInteger>& QHatInvModqPrecon,
+                                      const std::vector<std::vector<NativeInteger>>& QHatModp,
+                                      const std::vector<DoubleNativeInt>& modpBarrettMu, DerivedType* ans) const = 0;
+
     /**
    * @brief Performs approximate modulus raising:
    * {X}_{Q} -> {X'}_{Q,P}.
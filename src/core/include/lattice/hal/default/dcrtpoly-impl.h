@@ -41,6 +41,8 @@
 #include "lattice/hal/default/poly-impl.h"
 #include "lattice/hal/default/dcrtpoly.h"
 
+#include "math/distributiongenerator.h"
+
 #include "utils/exception.h"
 #include "utils/inttypes.h"
 #include "utils/parallel.h"
@@ -161,12 +163,24 @@ DCRTPolyImpl<VecType>::DCRTPolyImpl(const DggType& dgg, const std::shared_ptr<DC
 template <typename VecType>
 DCRTPolyImpl<VecType>::DCRTPolyImpl(DugType& dug, const std::shared_ptr<Params>& dcrtParams, Format format)
     : m_params{dcrtParams}, m_format{format} {
-    m_vectors.reserve(m_params->GetParams().size());
-    for (auto& p : m_params->GetParams()) {
-        NativeVector vals(dug.GenerateVector(p->GetRingDimension(), p->GetModulus()));
-        DCRTPolyImpl::PolyType ilvector(p);
-        ilvector.SetValues(std::move(vals), m_format);
-        m_vectors.push_back(std::move(ilvector));
+    const auto& params = m_params->GetParams();
+    size_t size{params.size()};
+    m_vectors.reserve(size);
+    for (auto& p : params)
+        m_vectors.emplace_back(p);
+
+    // an engine set by DugType::SetPRNG() or by PseudoRandomNumberGenerator::ScopedPRNG only yields a seed on the
+    // calling thread; tower i is then sampled from stream i of that seed, so the result is reproducible no matter
+    // which thread samples which tower. Otherwise every thread samples its towers from its own PRNG engine
+    const bool seeded = dug.HasPRNG() || PseudoRandomNumberGenerator::HasScopedPRNG();
+    const PRNGSeed seed{seeded ? dug.GenerateSeed() : PRNGSeed{}};
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
+    for (size_t i = 0; i < size; ++i) {
+        DugType dugTower(dug);
+        if (seeded)
+            dugTower.SetPRNG(PseudoRandomNumberGenerator::CreateSeededPRNG(seed, static_cast<uint32_t>(i)));
+        m_vectors[i].SetValues(dugTower.GenerateVector(params[i]->GetRingDimension(), params[i]->GetModulus()),
+                               m_format);
     }
 }
 
@@ -230,11 +244,85 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::CloneTowers(uint32_t startTower, ui
     auto cycorder = m_params->GetCyclotomicOrder();
     auto params   = std::make_shared<Params>(cycorder, m_params->GetParamPartition(startTower, endTower));
     auto res      = DCRTPolyImpl(params, Format::EVALUATION, false);
+    if (m_contiguousStorage.load(std::memory_order_relaxed) &&
+        res.InitContiguous(&m_vectors[startTower], endTower - startTower + 1))
+        return res;
     for (uint32_t i = startTower; i <= endTower; i++)
         res.SetElementAtIndex(i - startTower, this->GetElementAtIndex(i));
     return res;
 }
 
+template <typename VecType>
+std::atomic<bool> DCRTPolyImpl<VecType>::m_contiguousStorage{false};
+
+template <typename VecType>
+void DCRTPolyImpl<VecType>::SetContiguousStorage(bool contiguous) {
+    m_contiguousStorage.store(contiguous, std::memory_order_relaxed);
+}
+
+template <typename VecType>
+bool DCRTPolyImpl<VecType>::GetContiguousStorage() {
+    return m_contiguousStorage.load(std::memory_order_relaxed);
+}
+
+template <typename VecType>
+bool DCRTPolyImpl<VecType>::IsContiguous() const {
+    if (m_vectors.empty() || m_vectors[0].IsEmpty())
+        return false;
+    const auto arena{m_vectors[0].GetValues().GetAllocator().GetArena()};
+    if (!arena || arena->GetSlotCount() != m_vectors.size())
+        return false;
+    for (size_t i = 0; i < m_vectors.size(); ++i) {
+        if (m_vectors[i].IsEmpty() || arena->GetSlot(i) != &m_vectors[i].GetValues()[0])
+            return false;
+    }
+    return true;
+}
+
+template <typename VecType>
+void DCRTPolyImpl<VecType>::MakeContiguous() {
+    if (!IsContiguous())
+        InitContiguous(m_vectors.data(), m_vectors.size());
+}
+
+template <typename VecType>
+bool DCRTPolyImpl<VecType>::InitContiguous() {
+    const auto& params{m_params->GetParams()};
+    size_t size{params.size()};
+    uint32_t ringDim{m_params->GetRingDimension()};
+    if (size == 0 || ringDim == 0)
+        return false;
+
+    auto arena{std::make_shared<intnat::NativeVectorArena>(size, ringDim * sizeof(NativeInteger))};
+    std::vector<PolyType> towers;
+    towers.reserve(size);
+    for (size_t i = 0; i < size; ++i)
+        towers.emplace_back(params[i], m_format,
+                            NativeVector(ringDim, params[i]->GetModulus(), NativeVector::allocator_type(arena, i)));
+    m_vectors = std::move(towers);
+    return true;
+}
+
+template <typename VecType>
+bool DCRTPolyImpl<VecType>::InitContiguous(const PolyType* src, size_t size) {
+    if (size == 0 || src[0].IsEmpty())
+        return false;
+    uint32_t ringDim = src[0].GetLength();
+    for (size_t i = 1; i < size; ++i) {
+        if (src[i].IsEmpty() || src[i].GetLength() != ringDim)
+            return false;
+    }
+
+    auto arena{std::make_shared<intnat::NativeVectorArena>(size, ringDim * sizeof(NativeInteger))};
+    std::vector<PolyType> towers;
+    towers.reserve(size);
+    for (size_t i = 0; i < size; ++i)
+        towers.emplace_back(src[i].GetParams(), src[i].GetFormat(),
+                            NativeVector(src[i].GetValues(), NativeVector::allocator_type(arena, i)));
+    m_vectors = std::move(towers);
+    return true;
+}
+
 template <typename VecType>
 std::vector<DCRTPolyImpl<VecType>> DCRTPolyImpl<VecType>::BaseDecompose(usint baseBits, bool evalModeAnswer) const {
     auto bdV(CRTInterpolate().BaseDecompose(baseBits, false));
@@ -912,39 +1000,116 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxSwitchCRTBasis(
     const std::vector<NativeInteger>& QHatInvModq, const std::vector<NativeInteger>& QHatInvModqPrecon,
     const std::vector<std::vector<NativeInteger>>& QHatModp, const std::vector<DoubleNativeInt>& modpBarrettMu) const {
     DCRTPolyImpl<VecType> ans(paramsP, m_format, true);
+    ApproxSwitchCRTBasis(paramsQ, paramsP, QHatInvModq, QHatInvModqPrecon, QHatModp, modpBarrettMu, &ans);
+    return ans;
+}
+
+template <typename VecType>
+void DCRTPolyImpl<VecType>::ApproxSwitchCRTBasis(const std::shared_ptr<Params>& paramsQ,
+                                                 const std::shared_ptr<Params>& paramsP,
+                                                 const std::vector<NativeInteger>& QHatInvModq,
+                                                 const std::vector<NativeInteger>& QHatInvModqPrecon,
+                                                 const std::vector<std::vector<NativeInteger>>& QHatModp,
+                                                 const std::vector<DoubleNativeInt>& modpBarrettMu,
+                                                 DCRTPolyImpl<VecType>* ans) const {
+    if (ans == this)
+        OPENFHE_THROW("The output of ApproxSwitchCRTBasis can not be the input polynomial");
+
+    // reuse the towers of ans if they are already allocated for paramsP
+    uint32_t sizeP = paramsP->GetParams().size();
+    bool allocated = (ans->m_params == paramsP) && (ans->m_vectors.size() == sizeP);
+    for (uint32_t j = 0; allocated && j < sizeP; ++j)
+        allocated = !ans->m_vectors[j].IsEmpty();
+    if (!allocated) {
+        *ans = DCRTPolyImpl<VecType>(paramsP, m_format, true);
+    }
+    else {
+        ans->m_format = m_format;
+        for (auto& v : ans->m_vectors)
+            v.OverrideFormat(m_format);
+    }
+
     uint32_t sizeQ = (m_vectors.size() > paramsQ->GetParams().size()) ? paramsQ->GetParams().size() : m_vectors.size();
-    uint32_t sizeP = ans.m_vectors.size();
 #if defined(HAVE_INT128) && NATIVEINT == 64
-    uint32_t ringDim = m_params->GetRingDimension();
-    std::vector<DoubleNativeInt> sum(sizeP);
-    #pragma omp parallel for firstprivate(sum) num_threads(OpenFHEParallelControls.GetThreadLimit(8))
-    for (uint32_t ri = 0; ri < ringDim; ++ri) {
-        std::fill(sum.begin(), sum.end(), 0);
+    //
+    // The coefficients are processed in blocks of APPROXSWITCH_BLOCK_SIZE. For every block, [x_i*(Q/q_i)^{-1}]_{q_i}
+    // is first computed for all towers i (unit stride reads of every tower), then the 128-bit sums for
+    // APPROXSWITCH_BLOCK_TOWERS output towers at a time are accumulated in a coefficient-major scratch block that
+    // stays in L1 and finally reduced into ans with unit stride writes. The accumulation loop has no loop-carried
+    // dependency across coefficients, so the compiler can interleave/vectorize the 64x64->128 multiply-adds.
+    // The scratch buffers are thread_local and only grow, so the hot path does not allocate.
+    //
+    constexpr uint32_t APPROXSWITCH_BLOCK_SIZE{256};
+    constexpr uint32_t APPROXSWITCH_BLOCK_TOWERS{4};
+
+    uint32_t ringDim   = m_params->GetRingDimension();
+    uint32_t blockSize = std::min(ringDim, APPROXSWITCH_BLOCK_SIZE);
+    uint32_t numBlocks = (ringDim + blockSize - 1) / blockSize;
+
+    std::vector<const NativeInteger*> x(sizeQ);
+    for (uint32_t i = 0; i < sizeQ; ++i)
+        x[i] = &m_vectors[i][0];
+    std::vector<NativeInteger*> y(sizeP);
+    for (uint32_t j = 0; j < sizeP; ++j)
+        y[j] = &ans->m_vectors[j][0];
+
+    #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(numBlocks))
+    for (uint32_t b = 0; b < numBlocks; ++b) {
+        static thread_local std::vector<uint64_t> xQHatInvModq;
+        static thread_local std::vector<DoubleNativeInt> sum;
+        if (xQHatInvModq.size() < sizeQ * blockSize)
+            xQHatInvModq.resize(sizeQ * blockSize);
+        if (sum.size() < APPROXSWITCH_BLOCK_TOWERS * blockSize)
+            sum.resize(APPROXSWITCH_BLOCK_TOWERS * blockSize);
+
+        uint32_t ri0 = b * blockSize;
+        uint32_t len = std::min(blockSize, ringDim - ri0);
+
         for (uint32_t i = 0; i < sizeQ; ++i) {
-            const auto& qi        = m_vectors[i].GetModulus();
-            const auto& xi        = m_vectors[i][ri];
-            const auto& QHatModpi = QHatModp[i];
-            const auto xQHatInvModqi =
-                xi.ModMulFastConst(QHatInvModq[i], qi, QHatInvModqPrecon[i]).template ConvertToInt<uint64_t>();
-            for (uint32_t j = 0; j < sizeP; ++j)
-                sum[j] += Mul128(xQHatInvModqi, QHatModpi[j].ConvertToInt<uint64_t>());
+            const auto& qi{m_vectors[i].GetModulus()};
+            const auto* xi{x[i] + ri0};
+            auto* xQHatInvModqi{&xQHatInvModq[i * blockSize]};
+            for (uint32_t k = 0; k < len; ++k) {
+                xQHatInvModqi[k] =
+                    xi[k].ModMulFastConst(QHatInvModq[i], qi, QHatInvModqPrecon[i]).template ConvertToInt<uint64_t>();
+            }
         }
-        for (uint32_t j = 0; j < sizeP; ++j) {
-            const auto& pj       = ans.m_vectors[j].GetModulus();
-            ans.m_vectors[j][ri] = BarrettUint128ModUint64(sum[j], pj.ConvertToInt(), modpBarrettMu[j]);
+
+        for (uint32_t j0 = 0; j0 < sizeP; j0 += APPROXSWITCH_BLOCK_TOWERS) {
+            uint32_t jlen = std::min(APPROXSWITCH_BLOCK_TOWERS, sizeP - j0);
+            std::fill(sum.begin(), sum.begin() + jlen * blockSize, 0);
+            for (uint32_t i = 0; i < sizeQ; ++i) {
+                const auto* xQHatInvModqi{&xQHatInvModq[i * blockSize]};
+                const auto& QHatModpi{QHatModp[i]};
+                for (uint32_t jj = 0; jj < jlen; ++jj) {
+                    const uint64_t QHatModpij{QHatModpi[j0 + jj].template ConvertToInt<uint64_t>()};
+                    auto* sumj{&sum[jj * blockSize]};
+                    for (uint32_t k = 0; k < len; ++k)
+                        sumj[k] += Mul128(xQHatInvModqi[k], QHatModpij);
+                }
+            }
+            for (uint32_t jj = 0; jj < jlen; ++jj) {
+                const uint32_t j{j0 + jj};
+                const uint64_t pj{ans->m_vectors[j].GetModulus().ConvertToInt()};
+                const auto& mu{modpBarrettMu[j]};
+                const auto* sumj{&sum[jj * blockSize]};
+                auto* yj{y[j] + ri0};
+                for (uint32_t k = 0; k < len; ++k)
+                    yj[k] = NativeInteger(BarrettUint128ModUint64(sumj[k], pj, mu));
+            }
         }
     }
 #else
+    *ans = DCRTPolyImpl<VecType>(paramsP, m_format, true);
     for (uint32_t i = 0; i < sizeQ; ++i) {
         auto xQHatInvModqi = m_vectors[i] * QHatInvModq[i];
         for (uint32_t j = 0; j < sizeP; ++j) {
             auto temp = xQHatInvModqi;
-            temp.SwitchModulus(ans.m_vectors[j].GetModulus(), ans.m_vectors[j].GetRootOfUnity(), 0, 0);
-            ans.m_vectors[j] += (temp *= QHatModp[i][j]);
+            temp.SwitchModulus(ans->m_vectors[j].GetModulus(), ans->m_vectors[j].GetRootOfUnity(), 0, 0);
+            ans->m_vectors[j] += (temp *= QHatModp[i][j]);
         }
     }
 #endif
-    return ans;
 }
 
 template <typename VecType>
@@ -971,9 +1136,7 @@ void DCRTPolyImpl<VecType>::ApproxModUp(const std::shared_ptr<Params>& paramsQ,
     m_vectors.insert(m_vectors.end(), std::make_move_iterator(partP.m_vectors.begin()),
                      std::make_move_iterator(partP.m_vectors.end()));
 
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeQP))
-    for (size_t i = 0; i < sizeQP; ++i)
-        m_vectors[i].SetFormat(Format::EVALUATION);
+    PolyType::SetFormatBatch(m_vectors, Format::EVALUATION);
     m_format = Format::EVALUATION;
     m_params = paramsQP;
 }
@@ -991,14 +1154,17 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxModDown(
     size_t sizeQ = m_vectors.size() - sizeP;
 
 #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeP))
-    for (size_t j = 0; j < sizeP; ++j) {
+    for (size_t j = 0; j < sizeP; ++j)
         partP.m_vectors[j] = m_vectors[sizeQ + j];
-        partP.m_vectors[j].SetFormat(Format::COEFFICIENT);
-        // Multiply everything by -t^(-1) mod P (BGVrns only)
-        if (t > 0)
+    PolyType::SetFormatBatch(partP.m_vectors, Format::COEFFICIENT);
+    partP.OverrideFormat(Format::COEFFICIENT);
+
+    // Multiply everything by -t^(-1) mod P (BGVrns only)
+    if (t > 0) {
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeP))
+        for (size_t j = 0; j < sizeP; ++j)
             partP.m_vectors[j] *= tInvModp[j];
     }
-    partP.OverrideFormat(Format::COEFFICIENT);
 
     auto partPSwitchedToQ =
         partP.ApproxSwitchCRTBasis(paramsP, paramsQ, PHatInvModp, PHatInvModpPrecon, PHatModq, modqBarrettMu);
@@ -1006,17 +1172,22 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxModDown(
     // Combine the switched DCRTPoly with the Q part of this to get the result
     DCRTPolyImpl<VecType> ans(paramsQ, Format::EVALUATION, true);
     uint32_t diffQ = paramsQ->GetParams().size() - sizeQ;
-    if (diffQ > 0)
+    if (diffQ > 0) {
         ans.DropLastElements(diffQ);
+        partPSwitchedToQ.DropLastElements(diffQ);
+    }
 
+    // Multiply everything by t mod Q (BGVrns only)
+    if (t > 0) {
 #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeQ))
-    for (size_t i = 0; i < sizeQ; ++i) {
-        // Multiply everything by t mod Q (BGVrns only)
-        if (t > 0)
+        for (size_t i = 0; i < sizeQ; ++i)
             partPSwitchedToQ.m_vectors[i] *= t;
-        partPSwitchedToQ.m_vectors[i].SetFormat(Format::EVALUATION);
-        ans.m_vectors[i] = (m_vectors[i] - partPSwitchedToQ.m_vectors[i]) * PInvModq[i];
     }
+    PolyType::SetFormatBatch(partPSwitchedToQ.m_vectors, Format::EVALUATION);
+
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeQ))
+    for (size_t i = 0; i < sizeQ; ++i)
+        ans.m_vectors[i] = (m_vectors[i] - partPSwitchedToQ.m_vectors[i]) * PInvModq[i];
     return ans;
 }
 
@@ -1981,10 +2152,7 @@ void DCRTPolyImpl<VecType>::FastBaseConvSK(
 template <typename VecType>
 void DCRTPolyImpl<VecType>::SwitchFormat() {
     m_format = (m_format == Format::COEFFICIENT) ? Format::EVALUATION : Format::COEFFICIENT;
-    size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
-        m_vectors[i].SwitchFormat();
+    PolyType::SetFormatBatch(m_vectors, m_format);
 }
 
 template <typename VecType>
@@ -47,6 +47,7 @@
 #include "utils/inttypes.h"
 #include "utils/parallel.h"
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <string>
@@ -73,11 +74,18 @@ public:
 
     DCRTPolyImpl() = default;
 
-    DCRTPolyImpl(const DCRTPolyType& e) noexcept : m_params{e.m_params}, m_format{e.m_format}, m_vectors{e.m_vectors} {}
+    DCRTPolyImpl(const DCRTPolyType& e) noexcept : m_params{e.m_params}, m_format{e.m_format} {
+        if (!m_contiguousStorage.load(std::memory_order_relaxed) ||
+            !DCRTPolyImpl::InitContiguous(e.m_vectors.data(), e.m_vectors.size()))
+            m_vectors = e.m_vectors;
+    }
     DCRTPolyType& operator=(const DCRTPolyType& rhs) noexcept override {
-        m_params  = rhs.m_params;
-        m_format  = rhs.m_format;
-        m_vectors = rhs.m_vectors;
+        m_params = rhs.m_params;
+        m_format = rhs.m_format;
+        // with the same number of towers, the values are copied into the existing storage (keeps the layout)
+        if (!m_contiguousStorage.load(std::memory_order_relaxed) || m_vectors.size() == rhs.m_vectors.size() ||
+            !DCRTPolyImpl::InitContiguous(rhs.m_vectors.data(), rhs.m_vectors.size()))
+            m_vectors = rhs.m_vectors;
         return *this;
     }
 
@@ -101,6 +109,9 @@ public:
     DCRTPolyImpl(const std::shared_ptr<Params>& params, Format format = Format::EVALUATION,
                  bool initializeElementToZero = false) noexcept
         : m_params{params}, m_format{format} {
+        if (initializeElementToZero && m_contiguousStorage.load(std::memory_order_relaxed) &&
+            DCRTPolyImpl::InitContiguous())
+            return;
         m_vectors.reserve(m_params->GetParams().size());
         for (const auto& p : m_params->GetParams())
             m_vectors.emplace_back(p, m_format, initializeElementToZero);
@@ -120,6 +131,31 @@ public:
     DCRTPolyType CloneWithNoise(const DiscreteGaussianGeneratorImpl<VecType>& dgg, Format format) const override;
     DCRTPolyType CloneTowers(uint32_t startTower, uint32_t endTower) const;
 
+    /**
+   * @brief Selects the storage layout of new polynomials. With contiguous storage, the towers of a polynomial
+   * that is allocated or copied live in one 64-byte aligned buffer (limb-major, see NativeVectorArena), so
+   * constructing, copying, cloning or deserializing it takes one allocation for the coefficients instead of
+   * one per tower. Towers that are later replaced by new vectors move to the heap.
+   *
+   * @param contiguous true for contiguous storage, false (default) for one allocation per tower.
+   */
+    static void SetContiguousStorage(bool contiguous);
+
+    /**
+   * @return true if new polynomials use contiguous storage
+   */
+    static bool GetContiguousStorage();
+
+    /**
+   * @return true if all towers are stored back to back in one buffer
+   */
+    bool IsContiguous() const;
+
+    /**
+   * @brief Moves all towers into one contiguous buffer (no-op if they already are or if a tower is empty).
+   */
+    void MakeContiguous();
+
     bool operator==(const DCRTPolyType& rhs) const override;
 
     DCRTPolyType& operator+=(const DCRTPolyType& rhs) override;
@@ -234,6 +270,12 @@ public:
                                       const std::vector<std::vector<NativeInteger>>& QHatModp,
                                       const std::vector<DoubleNativeInt>& modpBarrettMu) const override;
 
+    void ApproxSwitchCRTBasis(const std::shared_ptr<Params>& paramsQ, const std::shared_ptr<Params>& paramsP,
+                              const std::vector<NativeInteger>& QHatInvModq,
+                              const std::vector<NativeInteger>& QHatInvModqPrecon,
+                              const std::vector<std::vector<NativeInteger>>& QHatModp,
+                              const std::vector<DoubleNativeInt>& modpBarrettMu, DCRTPolyType* ans) const override;
+
     void ApproxModUp(const std::shared_ptr<Params>& paramsQ, const std::shared_ptr<Params>& paramsP,
                      const std::shared_ptr<Params>& paramsQP, const std::vector<NativeInteger>& QHatInvModq,
                      const std::vector<NativeInteger>& QHatInvModqPrecon,
@@ -349,6 +391,8 @@ public:
         ar(::cereal::make_nvp("v", m_vectors));
         ar(::cereal::make_nvp("f", m_format));
         ar(::cereal::make_nvp("p", m_params));
+        if (m_contiguousStorage.load(std::memory_order_relaxed))
+            MakeContiguous();
     }
 
     static const std::string GetElementName() {
@@ -395,6 +439,25 @@ protected:
     std::shared_ptr<Params> m_params{std::make_shared<DCRTPolyImpl::Params>()};
     Format m_format{Format::EVALUATION};
     std::vector<PolyType> m_vectors;
+
+    /// selects contiguous storage for new polynomials (see SetContiguousStorage())
+    static std::atomic<bool> m_contiguousStorage;
+
+private:
+    /**
+   * @brief Allocates the towers over m_params in one NativeVectorArena, initialized to zero.
+   *
+   * @return false if m_params has no towers.
+   */
+    bool InitContiguous();
+
+    /**
+   * @brief Replaces the towers by copies of src[0], ..., src[size - 1] allocated in one NativeVectorArena.
+   *
+   * @return false (and leaves the towers unchanged) if size is 0 or src has an empty tower or towers of
+   * different lengths.
+   */
+    bool InitContiguous(const PolyType* src, size_t size);
 };
 
 }  // namespace lbcrypto
@@ -41,6 +41,7 @@
 #include "utils/debug.h"
 #include "utils/exception.h"
 #include "utils/inttypes.h"
+#include "utils/parallel.h"
 
 #include <cmath>
 #include <iostream>
@@ -429,6 +430,48 @@ void PolyImpl<VecType>::SwitchFormat() {
     ChineseRemainderTransformFTT<VecType>().ForwardTransformToBitReverseInPlace(ru, co, &(*m_values));
 }
 
+template <typename VecType>
+void PolyImpl<VecType>::SetFormatBatch(std::vector<PolyImpl>& polys, Format format) {
+    std::vector<size_t> other;
+    if constexpr (std::is_same_v<VecType, NativeVector>) {
+        std::vector<VecType*> elements;
+        std::vector<Integer> roots;
+        usint co{0};
+        for (size_t i = 0; i < polys.size(); ++i) {
+            auto& p{polys[i]};
+            if (p.m_format == format)
+                continue;
+            const auto& params{p.m_params};
+            if (!p.m_values || params->GetRingDimension() != (params->GetCyclotomicOrder() >> 1) ||
+                (co != 0 && co != params->GetCyclotomicOrder())) {
+                other.push_back(i);
+                continue;
+            }
+            co = params->GetCyclotomicOrder();
+            elements.push_back(p.m_values.get());
+            roots.push_back(params->GetRootOfUnity());
+            p.m_format = format;
+        }
+        if (!elements.empty()) {
+            if (format == Format::EVALUATION)
+                ChineseRemainderTransformFTT<VecType>().ForwardTransformToBitReverseInPlaceBatch(roots, co, elements);
+            else
+                ChineseRemainderTransformFTT<VecType>().InverseTransformFromBitReverseInPlaceBatch(roots, co, elements);
+        }
+    }
+    else {
+        for (size_t i = 0; i < polys.size(); ++i) {
+            if (polys[i].m_format != format)
+                other.push_back(i);
+        }
+    }
+
+    size_t size{other.size()};
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
+    for (size_t i = 0; i < size; ++i)
+        polys[other[i]].SwitchFormat();
+}
+
 template <typename VecType>
 void PolyImpl<VecType>::ArbitrarySwitchFormat() {
     if (m_values == nullptr)
@@ -91,6 +91,9 @@ public:
             this->SetValuesToZero();
     }
 
+    PolyImpl(const std::shared_ptr<Params>& params, Format format, VecType&& values) noexcept
+        : m_format{format}, m_params{params}, m_values{std::make_unique<VecType>(std::move(values))} {}
+
     PolyImpl(bool initializeElementToMax, const std::shared_ptr<Params>& params, Format format = Format::EVALUATION)
         : m_format{format}, m_params{params} {
         if (initializeElementToMax)
@@ -318,6 +321,17 @@ public:
     void SwitchModulus(const Integer& modulus, const Integer& rootOfUnity, const Integer& modulusArb,
                        const Integer& rootOfUnityArb) override;
     void SwitchFormat() override;
+
+    /**
+   * @brief Sets the format of all polynomials in polys. The power-of-two NTTs of the native polynomials are
+   * run as one batch (see ChineseRemainderTransformFTTNat::ForwardTransformToBitReverseInPlaceBatch()), which
+   * parallelizes over the polynomials and over the butterflies of each NTT stage.
+   *
+   * @param &polys the polynomials to convert, e.g., the towers of a DCRTPoly.
+   * @param format the new format.
+   */
+    static void SetFormatBatch(std::vector<PolyImpl>& polys, Format format);
+
     void MakeSparse(uint32_t wFactor) override;
     bool InverseExists() const override;
     double Norm() const override;
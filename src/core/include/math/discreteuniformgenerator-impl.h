@@ -41,6 +41,10 @@
 #include "math/distributiongenerator.h"
 #include "utils/exception.h"
 
+#include <algorithm>
+#include <array>
+#include <type_traits>
+
 namespace lbcrypto {
 
 template <typename VecType>
@@ -58,8 +62,26 @@ void DiscreteUniformGeneratorImpl<VecType>::SetModulus(const typename VecType::I
 
     m_shiftChunk = m_chunksPerValue * DUG_CHUNK_WIDTH;
 
-    m_bound =
-        std::uniform_int_distribution<uint32_t>::param_type(DUG_CHUNK_MIN, (m_modulus >> m_shiftChunk).ConvertToInt());
+    uint32_t bound{static_cast<uint32_t>((m_modulus >> m_shiftChunk).ConvertToInt())};
+    m_bound = std::uniform_int_distribution<uint32_t>::param_type(DUG_CHUNK_MIN, bound);
+
+    m_maskChunk = bound;
+    for (uint32_t shift = 1; shift < DUG_CHUNK_WIDTH; shift <<= 1)
+        m_maskChunk |= m_maskChunk >> shift;
+}
+
+template <typename VecType>
+void DiscreteUniformGeneratorImpl<VecType>::SetPRNG(std::shared_ptr<PRNG> prng) {
+    m_prng = std::move(prng);
+}
+
+template <typename VecType>
+PRNGSeed DiscreteUniformGeneratorImpl<VecType>::GenerateSeed() const {
+    PRNG& prng = m_prng ? *m_prng : PseudoRandomNumberGenerator::GetPRNG();
+    PRNGSeed seed;
+    for (auto& s : seed)
+        s = prng();
+    return seed;
 }
 
 template <typename VecType>
@@ -67,6 +89,19 @@ typename VecType::Integer DiscreteUniformGeneratorImpl<VecType>::GenerateInteger
     if (m_modulus == typename VecType::Integer(0))
         OPENFHE_THROW("0 modulus?");
 
+    if (m_prng) {
+        PRNG& prng = *m_prng;
+        while (true) {
+            typename VecType::Integer result{};
+            for (uint32_t i{0}, shift{0}; i < m_chunksPerValue; ++i, shift += DUG_CHUNK_WIDTH)
+                result += typename VecType::Integer{prng()} << shift;
+            result += typename VecType::Integer{prng() & m_maskChunk} << m_shiftChunk;
+
+            if (result < m_modulus)
+                return result;
+        }
+    }
+
     std::uniform_int_distribution<uint32_t> dist(DUG_CHUNK_MIN, DUG_CHUNK_MAX);
     while (true) {
         typename VecType::Integer result{};
@@ -79,11 +114,59 @@ typename VecType::Integer DiscreteUniformGeneratorImpl<VecType>::GenerateInteger
     }
 }
 
+template <typename VecType>
+void DiscreteUniformGeneratorImpl<VecType>::FillVector(VecType& v) const {
+    const uint32_t size = v.GetLength();
+    if constexpr (std::is_same_v<typename VecType::Integer, NativeInteger> &&
+                  sizeof(BasicInteger) <= sizeof(uint64_t)) {
+        if (m_modulus == typename VecType::Integer(0))
+            OPENFHE_THROW("0 modulus?");
+
+        // every candidate takes m_chunksPerValue full chunks and the masked top chunk from the engine, in the
+        // same order as GenerateInteger() with m_prng. The output is drawn batch by batch, straight from the
+        // engine buffers for the built-in engines
+        constexpr uint32_t batchWords{1024};
+        std::array<PRNG::result_type, batchWords> words;
+
+        PRNG& prng                   = m_prng ? *m_prng : PseudoRandomNumberGenerator::GetPRNG();
+        const uint32_t wordsPerValue = m_chunksPerValue + 1;
+        const uint64_t q             = m_modulus.template ConvertToInt<uint64_t>();
+        const uint64_t mask          = m_maskChunk;
+
+        uint32_t filled = 0;
+        while (filled < size) {
+            const uint32_t count  = std::min(size - filled, batchWords / wordsPerValue);
+            const uint32_t nWords = count * wordsPerValue;
+            prng.Fill(words.data(), nWords);
+
+            // each candidate is stored and the position only advances if it is accepted, so the loops have no
+            // data-dependent branches. At most count candidates are accepted, which keeps the stores within v
+            if (wordsPerValue == 1) {
+                for (uint32_t i = 0; i < count; ++i) {
+                    const uint64_t c = words[i] & mask;
+                    v[filled]        = c;
+                    filled += static_cast<uint32_t>(c < q);
+                }
+            }
+            else {
+                for (uint32_t i = 0; i < count; ++i) {
+                    const uint64_t c = ((words[2 * i + 1] & mask) << DUG_CHUNK_WIDTH) | words[2 * i];
+                    v[filled]        = c;
+                    filled += static_cast<uint32_t>(c < q);
+                }
+            }
+        }
+    }
+    else {
+        for (uint32_t i = 0; i < size; ++i)
+            v[i] = this->GenerateInteger();
+    }
+}
+
 template <typename VecType>
 VecType DiscreteUniformGeneratorImpl<VecType>::GenerateVector(const uint32_t size) const {
     VecType v(size, m_modulus);
-    for (uint32_t i = 0; i < size; ++i)
-        v[i] = this->GenerateInteger();
+    this->FillVector(v);
     return v;
 }
 
@@ -92,8 +175,7 @@ VecType DiscreteUniformGeneratorImpl<VecType>::GenerateVector(const uint32_t siz
                                                               const typename VecType::Integer& modulus) {
     this->SetModulus(modulus);
     VecType v(size, m_modulus);
-    for (uint32_t i = 0; i < size; ++i)
-        v[i] = this->GenerateInteger();
+    this->FillVector(v);
     return v;
 }
 
@@ -40,6 +40,7 @@
 #include "math/distributiongenerator.h"
 
 #include <limits>
+#include <memory>
 #include <random>
 
 namespace lbcrypto {
@@ -64,6 +65,27 @@ public:
    */
     void SetModulus(const typename VecType::Integer& modulus);
 
+    /**
+   * @brief      Draws the random integers from the given engine instead of the PRNG engine of the calling thread.
+   *             The rejection sampling then only depends on the engine output, so an engine created by
+   *             PseudoRandomNumberGenerator::CreateSeededPRNG() yields the same integers on every platform.
+   * @param prng the engine; nullptr restores the PRNG engine of the calling thread.
+   */
+    void SetPRNG(std::shared_ptr<PRNG> prng);
+
+    /**
+   * @return true if the integers are drawn from an engine set by SetPRNG()
+   */
+    bool HasPRNG() const {
+        return m_prng != nullptr;
+    }
+
+    /**
+   * @brief Draws a seed from the engine set by SetPRNG() or, if none is set, from the PRNG engine of the calling
+   * thread. Used to split one engine into independent streams that can be sampled in parallel.
+   */
+    PRNGSeed GenerateSeed() const;
+
     /**
    * @brief Generates a random integer based on the modulus set for the Discrete
    * Uniform Generator object. Required by DistributionGenerator.
@@ -71,16 +93,23 @@ public:
     typename VecType::Integer GenerateInteger() const;
 
     /**
-   * @brief Generates a vector of random integers using GenerateInteger()
+   * @brief Generates a vector of random integers. Native vectors are sampled in bulk: the engine output is
+   * drawn block by block and the rejection sampling is done without data-dependent branches. For an engine
+   * set by SetPRNG(), the result is the same as with size calls to GenerateInteger().
    */
     VecType GenerateVector(const uint32_t size) const;
     VecType GenerateVector(const uint32_t size, const typename VecType::Integer& modulus);
 
 private:
+    void FillVector(VecType& v) const;
+
     typename VecType::Integer m_modulus{};
     uint32_t m_chunksPerValue{};
     uint32_t m_shiftChunk{};
     std::uniform_int_distribution<uint32_t>::param_type m_bound{DUG_CHUNK_MIN, DUG_CHUNK_MAX};
+    // the bits of the most significant chunk that can be below the modulus (used with m_prng and bulk sampling)
+    uint32_t m_maskChunk{DUG_CHUNK_MAX};
+    std::shared_ptr<PRNG> m_prng{nullptr};
 };
 
 }  // namespace lbcrypto
@@ -39,11 +39,26 @@
 
 #include "utils/prng/prng.h"
 
+#include <array>
 #include <memory>
 #include <string>
 
 namespace lbcrypto {
 
+/**
+ * @brief Seed of the built-in BLAKE2 engine; used to derive uniformly random ring elements that are stored as a seed.
+ */
+using PRNGSeed = std::array<PRNG::result_type, 16>;
+
+/**
+ * @brief Built-in PRNG engines; see PseudoRandomNumberGenerator::InitPRNGEngine(PRNGEngineType)
+ */
+enum class PRNGEngineType {
+    BLAKE2,    // default_prng::Blake2Engine (default)
+    CHACHA20,  // default_prng::ChaCha20Engine
+    AESCTR,    // default_prng::AesCtrEngine
+};
+
 /**
  * @brief PseudoRandomNumberGenerator provides the PRNG capability to all random distribution generators in OpenFHE.
  * The security of Ring Learning With Errors (used for all crypto capabilities in OpenFHE) depends on
@@ -60,11 +75,56 @@ public:
     */
     static void InitPRNGEngine(const std::string& libPath = std::string());
 
+    /**
+    * @brief InitPRNGEngine() initializes the PRNG generator with one of the built-in engines
+    * @param engine the built-in engine to be used by all threads
+    * @note like the function above, this function should be called at the beginning of main(), before any
+    *       random sampling takes place. Later calls have no effect
+    */
+    static void InitPRNGEngine(PRNGEngineType engine);
+
     /**
      * @brief Returns a reference to the PRNG engine
      */
     static PRNG& GetPRNG();
 
+    /**
+     * @brief Returns a fresh seed drawn from the PRNG engine of the calling thread
+     */
+    static PRNGSeed GenerateSeed();
+
+    /**
+     * @brief Creates an instance of the built-in BLAKE2 engine for the given seed. The output depends only on
+     * the seed and the stream, also when an external PRNG library is used for all other sampling.
+     * @param seed the seed
+     * @param stream selects one of 2^32 independent output streams of at most 2^32 buffers each for the seed
+     */
+    static std::shared_ptr<PRNG> CreateSeededPRNG(const PRNGSeed& seed, uint32_t stream = 0);
+
+    /**
+     * @brief Makes GetPRNG() return the given engine on the calling thread for the lifetime of the object.
+     * Used to make a unit of work (e.g., the generation of one key) depend only on the seed of the engine,
+     * no matter which thread performs it. Scopes may be nested
+     */
+    class ScopedPRNG {
+    public:
+        explicit ScopedPRNG(std::shared_ptr<PRNG> prng);
+        ~ScopedPRNG();
+
+        ScopedPRNG(const ScopedPRNG&)            = delete;
+        ScopedPRNG& operator=(const ScopedPRNG&) = delete;
+
+    private:
+        std::shared_ptr<PRNG> m_prev;
+    };
+
+    /**
+     * @brief Returns true if the calling thread samples from an engine set by ScopedPRNG. Code that would
+     * otherwise spread sampling over several threads has to draw a seed from this engine on the calling thread
+     * and give every unit of work its own stream of that seed (see CreateSeededPRNG()) in this case
+     */
+    static bool HasScopedPRNG();
+
 private:
     using GenPRNGEngineFuncPtr = PRNG* (*)();
 
@@ -72,6 +132,8 @@ private:
     static std::shared_ptr<PRNG> m_prng;
     // pointer to the function generating PRNG
     static GenPRNGEngineFuncPtr genPRNGEngine;
+    // engine set by ScopedPRNG for the current thread; takes precedence over m_prng
+    static thread_local std::shared_ptr<PRNG> t_scopedPRNG;
 
 #if !defined(FIXED_SEED)
     // avoid contention on m_prng: local copies of m_prng are created for each thread
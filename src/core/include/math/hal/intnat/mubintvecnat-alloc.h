@@ -0,0 +1,247 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+ * This file contains the allocator used for the storage of native vectors
+ */
+
+#ifndef LBCRYPTO_INC_MATH_HAL_INTNAT_MUBINTVECNAT_ALLOC_H
+#define LBCRYPTO_INC_MATH_HAL_INTNAT_MUBINTVECNAT_ALLOC_H
+
+#include "config_core.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace intnat {
+
+/**
+ * @brief Counters of the native vector pool (all threads, since the last ResetNativeVectorPoolStats()).
+ */
+struct NativeVectorPoolStats {
+    /// number of heap allocations requested by native vectors (arena slots are not counted)
+    uint64_t allocations{0};
+    /// number of allocations served from a buffer cached by the pool
+    uint64_t poolHits{0};
+    /// number of heap deallocations requested by native vectors
+    uint64_t deallocations{0};
+    /// number of deallocations whose buffer was cached by the pool for reuse
+    uint64_t poolReturns{0};
+};
+
+/**
+ * Allocates storage for a native vector. With WITH_VECTOR_POOL, buffers of 1 KB and more are rounded up to
+ * a power of two (64-byte aligned) and served from a per-thread cache of freed buffers of that size class,
+ * which needs no locking; otherwise this is ::operator new.
+ *
+ * @param bytes is the size of the storage in bytes.
+ * @return the storage.
+ */
+void* NativeVectorPoolAllocate(size_t bytes);
+
+/**
+ * Frees storage allocated by NativeVectorPoolAllocate(); with WITH_VECTOR_POOL, the buffer is cached by the
+ * calling thread for reuse unless its cache for the size class is full.
+ *
+ * @param p is the storage.
+ * @param bytes is the size passed to NativeVectorPoolAllocate().
+ */
+void NativeVectorPoolDeallocate(void* p, size_t bytes) noexcept;
+
+/**
+ * Frees all buffers cached by the pool of the calling thread.
+ */
+void ReleaseNativeVectorPool();
+
+/**
+ * @return the counters of the native vector pool (all zero without WITH_VECTOR_POOL)
+ */
+NativeVectorPoolStats GetNativeVectorPoolStats();
+
+/**
+ * Resets the counters of the native vector pool. The counters are kept per thread, so increments made by
+ * other threads while the reset runs may survive it; call it while no other thread allocates native vectors.
+ */
+void ResetNativeVectorPoolStats();
+
+/**
+ * @brief One 64-byte aligned buffer split into equally sized slots, each of which backs the storage of one
+ * native vector (e.g., all towers of a DCRTPoly, limb-major). The buffer is released when the last vector
+ * using it is destroyed.
+ */
+class NativeVectorArena {
+public:
+    static constexpr size_t ALIGNMENT = 64;
+
+    /**
+   * @param slots is the number of vectors the arena can hold.
+   * @param slotBytes is the maximum size of one vector in bytes; rounded up to a multiple of ALIGNMENT.
+   */
+    NativeVectorArena(size_t slots, size_t slotBytes)
+        : m_slots{slots},
+          m_slotBytes{(slotBytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1)},
+          m_data{static_cast<uint8_t*>(::operator new(m_slots * m_slotBytes, std::align_val_t{ALIGNMENT}))},
+          m_used{std::make_unique<std::atomic<bool>[]>(m_slots)} {
+        for (size_t i = 0; i < m_slots; ++i)
+            m_used[i].store(false, std::memory_order_relaxed);
+    }
+
+    NativeVectorArena(const NativeVectorArena&)            = delete;
+    NativeVectorArena& operator=(const NativeVectorArena&) = delete;
+
+    ~NativeVectorArena() {
+        ::operator delete(m_data, std::align_val_t{ALIGNMENT});
+    }
+
+    /**
+   * Hands out the storage of a slot.
+   *
+   * @return a pointer to the slot, or nullptr if bytes does not fit or the slot is in use.
+   */
+    void* Acquire(size_t slot, size_t bytes) {
+        if (slot >= m_slots || bytes > m_slotBytes || m_used[slot].exchange(true, std::memory_order_acquire))
+            return nullptr;
+        return m_data + slot * m_slotBytes;
+    }
+
+    /**
+   * Returns the storage of a slot to the arena.
+   *
+   * @return true if p belongs to the arena.
+   */
+    bool Release(void* p) {
+        auto* b{static_cast<uint8_t*>(p)};
+        if (b < m_data || b >= m_data + m_slots * m_slotBytes)
+            return false;
+        m_used[(b - m_data) / m_slotBytes].store(false, std::memory_order_release);
+        return true;
+    }
+
+    const void* GetSlot(size_t slot) const {
+        return m_data + slot * m_slotBytes;
+    }
+
+    size_t GetSlotCount() const {
+        return m_slots;
+    }
+
+    size_t GetSlotBytes() const {
+        return m_slotBytes;
+    }
+
+private:
+    size_t m_slots;
+    size_t m_slotBytes;
+    uint8_t* m_data;
+    std::unique_ptr<std::atomic<bool>[]> m_used;
+};
+
+/**
+ * @brief Allocator for the storage of native vectors. A default constructed allocator uses the heap (through
+ * the native vector pool); an allocator bound to a slot of a NativeVectorArena places the first allocation
+ * that fits into that slot.
+ * Copies of a vector always go to the heap (see select_on_container_copy_construction()), while moves keep
+ * the arena storage.
+ */
+template <typename T>
+class NativeVectorAllocator {
+public:
+    using value_type                             = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::false_type;
+
+    NativeVectorAllocator() noexcept = default;
+
+    NativeVectorAllocator(std::shared_ptr<NativeVectorArena> arena, size_t slot) noexcept
+        : m_arena{std::move(arena)}, m_slot{slot} {}
+
+    template <typename U>
+    NativeVectorAllocator(const NativeVectorAllocator<U>& a) noexcept  // NOLINT
+        : m_arena{a.GetArena()}, m_slot{a.GetSlot()} {}
+
+    T* allocate(size_t n) {
+        if (m_arena) {
+            if (auto* p = m_arena->Acquire(m_slot, n * sizeof(T)))
+                return static_cast<T*>(p);
+        }
+#ifdef WITH_VECTOR_POOL
+        return static_cast<T*>(NativeVectorPoolAllocate(n * sizeof(T)));
+#else
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+#endif
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        if (m_arena && m_arena->Release(p))
+            return;
+#ifdef WITH_VECTOR_POOL
+        NativeVectorPoolDeallocate(p, n * sizeof(T));
+#else
+        ::operator delete(p);
+#endif
+    }
+
+    NativeVectorAllocator select_on_container_copy_construction() const noexcept {
+        return NativeVectorAllocator();
+    }
+
+    const std::shared_ptr<NativeVectorArena>& GetArena() const noexcept {
+        return m_arena;
+    }
+
+    size_t GetSlot() const noexcept {
+        return m_slot;
+    }
+
+private:
+    std::shared_ptr<NativeVectorArena> m_arena{nullptr};
+    size_t m_slot{0};
+};
+
+template <typename T, typename U>
+bool operator==(const NativeVectorAllocator<T>& a, const NativeVectorAllocator<U>& b) noexcept {
+    return a.GetArena() == b.GetArena();
+}
+
+template <typename T, typename U>
+bool operator!=(const NativeVectorAllocator<T>& a, const NativeVectorAllocator<U>& b) noexcept {
+    return !(a == b);
+}
+
+}  // namespace intnat
+
+#endif
@@ -0,0 +1,74 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+ This file contains the bit-packing of native vector entries used by the compact serialization
+*/
+
+#ifndef LBCRYPTO_MATH_HAL_INTNAT_MUBINTVECNAT_PACK_H
+#define LBCRYPTO_MATH_HAL_INTNAT_MUBINTVECNAT_PACK_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace intnat {
+
+/**
+ * Returns the number of 64-bit words holding n entries of the given bit length
+ */
+inline size_t PackedWordCount(size_t n, uint32_t bits) {
+    return (n * bits + 63) / 64;
+}
+
+/**
+ * Packs n entries, each below 2^bits, into PackedWordCount(n, bits) words: entry i occupies the bits
+ * [i * bits, (i + 1) * bits) of the stream of words, least significant bits first.
+ *
+ * @param in is the entries.
+ * @param n is the number of entries.
+ * @param bits is the bit length of the entries, between 1 and 64.
+ * @param out is the packed words.
+ */
+void PackBits(const uint64_t* in, size_t n, uint32_t bits, uint64_t* out);
+
+/**
+ * Unpacks n entries written by PackBits().
+ *
+ * @param in is the packed words.
+ * @param n is the number of entries.
+ * @param bits is the bit length of the entries, between 1 and 64.
+ * @param out is the entries.
+ */
+void UnpackBits(const uint64_t* in, size_t n, uint32_t bits, uint64_t* out);
+
+}  // namespace intnat
+
+#endif
@@ -37,13 +37,15 @@
 #define LBCRYPTO_INC_MATH_HAL_INTNAT_MUBINTVECNAT_H
 
 #include "math/hal/basicint.h"
+#include "math/hal/intnat/mubintvecnat-alloc.h"
+#include "math/hal/intnat/mubintvecnat-pack.h"
 #include "math/hal/intnat/ubintnat.h"
 #include "math/hal/vector.h"
 
-#include "utils/blockAllocator/xvector.h"
 #include "utils/exception.h"
 #include "utils/inttypes.h"
 #include "utils/serializable.h"
+#include "utils/sertype.h"
 
 #include <algorithm>
 #include <initializer_list>
@@ -52,12 +54,6 @@
 #include <utility>
 #include <vector>
 
-// the following should be set to 1 in order to have native vector use block
-// allocations then determine if you want dynamic or static allocations by
-// settingdefining STAIC_POOLS on line 24 of
-// xallocator.cpp
-#define BLOCK_VECTOR_ALLOCATION 0  // set to 1 to use block allocations
-
 /**
  * @namespace intnat
  * The namespace of intnat
@@ -123,19 +119,21 @@ private:
     // m_modulus stores the internal modulus of the vector.
     IntegerType m_modulus{0};
 
-#if BLOCK_VECTOR_ALLOCATION != 1
-    std::vector<IntegerType> m_data{};
-#else
-    xvector<IntegerType> m_data{};
-#endif
+    // the storage comes from the heap, the native vector pool (WITH_VECTOR_POOL) or a NativeVectorArena
+    std::vector<IntegerType, NativeVectorAllocator<IntegerType>> m_data{};
 
     // function to check if the index is a valid index.
     bool IndexCheck(size_t length) const {
         return length < m_data.size();
     }
 
+    // layout of the entries in binary archives (recorded since version 2): raw words, or bit-packed when
+    // written under SerType::COMPACT
+    enum class Layout : uint8_t { RAW = 0, PACKED = 1 };
+
 public:
-    using BasicInt = typename IntegerType::Integer;
+    using BasicInt       = typename IntegerType::Integer;
+    using allocator_type = typename decltype(m_data)::allocator_type;
 
     constexpr NativeVectorT() = default;
 
@@ -173,6 +171,18 @@ public:
         //                              " bits larger than max modulus bits " + std::to_string(MAX_MODULUS_SIZE));
     }
 
+    /**
+   * Constructor for a zero vector whose storage comes from the given allocator,
+   * e.g., a slot of a NativeVectorArena.
+   *
+   * @param length is the length of the native vector, in terms of the number of
+   * entries.
+   * @param modulus is the modulus of the ring.
+   * @param alloc is the allocator for the entries.
+   */
+    NativeVectorT(usint length, const IntegerType& modulus, const allocator_type& alloc) noexcept
+        : m_modulus{modulus}, m_data(length, alloc) {}
+
     /**
    * Basic constructor for copying a vector
    *
@@ -180,6 +190,15 @@ public:
    */
     constexpr NativeVectorT(const NativeVectorT& v) noexcept : m_modulus{v.m_modulus}, m_data{v.m_data} {}
 
+    /**
+   * Constructor for copying a vector into storage from the given allocator.
+   *
+   * @param bigVector is the native vector to be copied.
+   * @param alloc is the allocator for the entries.
+   */
+    NativeVectorT(const NativeVectorT& v, const allocator_type& alloc) noexcept
+        : m_modulus{v.m_modulus}, m_data(v.m_data, alloc) {}
+
     /**
    * Basic move constructor for moving a vector
    *
@@ -342,6 +361,15 @@ public:
         return m_data.size();
     }
 
+    /**
+   * Returns the allocator of the entries.
+   *
+   * @return the allocator.
+   */
+    allocator_type GetAllocator() const {
+        return m_data.get_allocator();
+    }
+
     // MODULAR ARITHMETIC OPERATIONS
 
     /**
@@ -656,6 +684,23 @@ public:
         ::cereal::size_type size = m_data.size();
         ar(size);
         if (size > 0) {
+            if constexpr (sizeof(BasicInt) == sizeof(uint64_t)) {
+                if (lbcrypto::SerType::CompactScope::IsActive()) {
+                    // the bit length of the largest entry, which is at most the bit length of the modulus
+                    BasicInt all{0};
+                    for (const auto& v : m_data)
+                        all |= v.ConvertToInt();
+                    uint8_t bits = std::max<usint>(IntegerType(all).GetMSB(), 1);
+                    std::vector<uint64_t> packed(PackedWordCount(size, bits));
+                    PackBits(reinterpret_cast<const uint64_t*>(m_data.data()), size, bits, packed.data());
+                    ar(static_cast<uint8_t>(Layout::PACKED));
+                    ar(bits);
+                    ar(::cereal::binary_data(packed.data(), packed.size() * sizeof(uint64_t)));
+                    ar(m_modulus);
+                    return;
+                }
+            }
+            ar(static_cast<uint8_t>(Layout::RAW));
             ar(::cereal::binary_data(m_data.data(), size * sizeof(IntegerType)));
         }
         ar(m_modulus);
@@ -677,14 +722,33 @@ public:
         }
         ::cereal::size_type size;
         ar(size);
-        m_data.resize(size);
+        // the entries are read straight into the storage of the vector (same layout as written by save)
+        if (m_data.size() != size)
+            m_data.resize(size);
         if (size > 0) {
-            auto* data = reinterpret_cast<IntegerType*>(malloc(size * sizeof(IntegerType)));
-            ar(::cereal::binary_data(data, size * sizeof(IntegerType)));
-            for (::cereal::size_type i = 0; i < size; i++) {
-                m_data[i] = data[i];
+            // the layout is recorded in the stream since version 2; version 1 streams hold the raw entries
+            uint8_t layout = static_cast<uint8_t>(Layout::RAW);
+            if (version >= 2)
+                ar(layout);
+            if (layout != static_cast<uint8_t>(Layout::RAW) && layout != static_cast<uint8_t>(Layout::PACKED))
+                OPENFHE_THROW("invalid layout " + std::to_string(layout) + " of serialized vector entries");
+            if (layout == static_cast<uint8_t>(Layout::PACKED)) {
+                if constexpr (sizeof(BasicInt) != sizeof(uint64_t)) {
+                    OPENFHE_THROW("bit-packed vector entries are only supported for 64-bit native integers");
+                }
+                else {
+                    uint8_t bits;
+                    ar(bits);
+                    if (bits == 0 || bits > 64)
+                        OPENFHE_THROW("invalid bit length " + std::to_string(bits) + " of packed vector entries");
+                    std::vector<uint64_t> packed(PackedWordCount(size, bits));
+                    ar(::cereal::binary_data(packed.data(), packed.size() * sizeof(uint64_t)));
+                    UnpackBits(packed.data(), size, bits, reinterpret_cast<uint64_t*>(m_data.data()));
+                    ar(m_modulus);
+                    return;
+                }
             }
-            free(data);
+            ar(::cereal::binary_data(m_data.data(), size * sizeof(IntegerType)));
         }
         ar(m_modulus);
     }
@@ -705,7 +769,7 @@ public:
     }
 
     static uint32_t SerializedVersion() {
-        return 1;
+        return 2;
     }
 };
 
@@ -40,19 +40,38 @@
 #include "math/hal/intnat/ubintnat.h"
 #include "math/hal/intnat/mubintvecnat.h"
 #include "math/hal/intnat/transformnat.h"
+#include "math/hal/intnat/transformnat-simd.h"
 #include "math/nbtheory.h"
 
 #include "utils/exception.h"
 #include "utils/inttypes.h"
+#include "utils/parallel.h"
 #include "utils/utilities.h"
 
 #include <map>
+#include <type_traits>
 #include <vector>
 
 namespace intnat {
 
 using namespace lbcrypto;
 
+// the SIMD kernels in transformnat-simd.h work on raw 64-bit words
+template <typename VecType>
+constexpr bool IsSIMDTransformable = std::is_same_v<typename VecType::Integer, NativeIntegerT<uint64_t>>;
+
+template <typename VecType>
+inline const uint64_t* SIMDData(const VecType& v) {
+    static_assert(sizeof(typename VecType::Integer) == sizeof(uint64_t), "SIMD kernels require 64-bit integers");
+    return reinterpret_cast<const uint64_t*>(&v[0]);
+}
+
+template <typename VecType>
+inline uint64_t* SIMDData(VecType* v) {
+    static_assert(sizeof(typename VecType::Integer) == sizeof(uint64_t), "SIMD kernels require 64-bit integers");
+    return reinterpret_cast<uint64_t*>(&(*v)[0]);
+}
+
 template <typename VecType>
 std::map<typename VecType::Integer, VecType>
     ChineseRemainderTransformFTTNat<VecType>::m_cycloOrderInverseTableByModulus;
@@ -77,6 +96,9 @@ template <typename VecType>
 std::map<typename VecType::Integer, VecType>
     ChineseRemainderTransformFTTNat<VecType>::m_rootOfUnityInversePreconReverseTableByModulus;
 
+template <typename VecType>
+std::atomic<bool> ChineseRemainderTransformFTTNat<VecType>::m_lazyReduction{false};
+
 template <typename VecType>
 std::map<typename VecType::Integer, VecType> ChineseRemainderTransformArbNat<VecType>::m_cyclotomicPolyMap;
 
@@ -372,6 +394,67 @@ void NumberTheoreticTransformNat<VecType>::ForwardTransformToBitReverseInPlace(c
     }
 }
 
+template <typename VecType>
+void NumberTheoreticTransformNat<VecType>::ForwardTransformToBitReverseInPlaceLazy(const VecType& rootOfUnityTable,
+                                                                                   const VecType& preconRootOfUnityTable,
+                                                                                   VecType* element) {
+    //
+    // Same CT butterflies as ForwardTransformToBitReverseInPlace(), but with Harvey's lazy reduction:
+    // every stage takes and produces values in [0, 4q)
+    //
+    //     loVal = loVal mod 2q                      in [0, 2q)
+    //     hiVal = hiVal*omega, without correction   in [0, 2q)
+    //     element[j1 + 0] = loVal + hiVal           in [0, 4q)
+    //     element[j1 + t] = loVal - hiVal + 2q      in [0, 4q)
+    //
+    // and the peeled off last stage reduces the output to [0, q).
+    //
+
+    const auto modulus{element->GetModulus()};
+    if (modulus.GetMSB() > IntType::MaxBits() - 2) {
+        ForwardTransformToBitReverseInPlace(rootOfUnityTable, preconRootOfUnityTable, element);
+        return;
+    }
+    const auto twiceModulus{modulus + modulus};
+
+    const uint32_t n(element->GetLength() >> 1);
+    for (uint32_t m{1}, t{n}, logt{GetMSB(t)}; m < n; m <<= 1, t >>= 1, --logt) {
+        for (uint32_t i{0}; i < m; ++i) {
+            const auto& omega{rootOfUnityTable[i + m]};
+            const auto& preconOmega{preconRootOfUnityTable[i + m]};
+            for (uint32_t j1{i << logt}, j2{j1 + t}; j1 < j2; ++j1) {
+                auto loVal{(*element)[j1 + 0]};
+                if (loVal >= twiceModulus)
+                    loVal -= twiceModulus;
+                auto omegaFactor{(*element)[j1 + t].ModMulFastConstLazy(omega, modulus, preconOmega)};
+                (*element)[j1 + 0] = loVal + omegaFactor;
+                (*element)[j1 + t] = loVal + twiceModulus - omegaFactor;
+            }
+        }
+    }
+    // peeled off last ntt stage, which also does the final reduction to [0, q)
+    for (uint32_t i{0}; i < (n << 1); i += 2) {
+        auto loVal{(*element)[i + 0]};
+        if (loVal >= twiceModulus)
+            loVal -= twiceModulus;
+        auto omegaFactor{
+            (*element)[i + 1].ModMulFastConstLazy(rootOfUnityTable[(i >> 1) + n], modulus,
+                                                  preconRootOfUnityTable[(i >> 1) + n])};
+        auto hiVal{loVal + omegaFactor};
+        loVal += twiceModulus - omegaFactor;
+        if (hiVal >= twiceModulus)
+            hiVal -= twiceModulus;
+        if (hiVal >= modulus)
+            hiVal -= modulus;
+        if (loVal >= twiceModulus)
+            loVal -= twiceModulus;
+        if (loVal >= modulus)
+            loVal -= modulus;
+        (*element)[i + 0] = hiVal;
+        (*element)[i + 1] = loVal;
+    }
+}
+
 template <typename VecType>
 void NumberTheoreticTransformNat<VecType>::ForwardTransformToBitReverse(const VecType& element,
                                                                         const VecType& rootOfUnityTable,
@@ -621,6 +704,66 @@ void NumberTheoreticTransformNat<VecType>::InverseTransformFromBitReverseInPlace
         (*element)[i].ModMulFastConstEq(cycloOrderInv, modulus, preconCycloOrderInv);
 }
 
+template <typename VecType>
+void NumberTheoreticTransformNat<VecType>::InverseTransformFromBitReverseInPlaceLazy(
+    const VecType& rootOfUnityInverseTable, const VecType& preconRootOfUnityInverseTable, const IntType& cycloOrderInv,
+    const IntType& preconCycloOrderInv, VecType* element) {
+    //
+    // Same GS butterflies as InverseTransformFromBitReverseInPlace(), but with Harvey's lazy reduction:
+    // every stage takes and produces values in [0, 2q)
+    //
+    //     element[j1 + 0] = (loVal + hiVal) mod 2q                            in [0, 2q)
+    //     element[j1 + t] = (loVal - hiVal + 2q)*omega, without correction    in [0, 2q)
+    //
+    // and the final stage, which also multiplies by (n inverse), reduces the output to [0, q).
+    //
+
+    auto modulus{element->GetModulus()};
+    if (modulus.GetMSB() > IntType::MaxBits() - 2) {
+        InverseTransformFromBitReverseInPlace(rootOfUnityInverseTable, preconRootOfUnityInverseTable, cycloOrderInv,
+                                              preconCycloOrderInv, element);
+        return;
+    }
+    const auto twiceModulus{modulus + modulus};
+
+    uint32_t n(element->GetLength());
+
+    // precomputed omega[bitreversed(1)] * (n inverse). used in final stage of intt.
+    auto omega1Inv{rootOfUnityInverseTable[1].ModMulFastConst(cycloOrderInv, modulus, preconCycloOrderInv)};
+    auto preconOmega1Inv{omega1Inv.PrepModMulConst(modulus)};
+
+    for (uint32_t m{n >> 1}, t{1}, logt{1}; m > 1; m >>= 1, t <<= 1, ++logt) {
+        for (uint32_t i{0}; i < m; ++i) {
+            const auto& omega{rootOfUnityInverseTable[i + m]};
+            const auto& preconOmega{preconRootOfUnityInverseTable[i + m]};
+            for (uint32_t j1{i << logt}, j2{j1 + t}; j1 < j2; ++j1) {
+                auto loVal{(*element)[j1 + 0]};
+                auto hiVal{(*element)[j1 + t]};
+                auto omegaFactor{loVal + twiceModulus - hiVal};
+                loVal += hiVal;
+                if (loVal >= twiceModulus)
+                    loVal -= twiceModulus;
+                (*element)[j1 + 0] = loVal;
+                (*element)[j1 + t] = omegaFactor.ModMulFastConstLazy(omega, modulus, preconOmega);
+            }
+        }
+    }
+
+    uint32_t j2{n >> 1};
+    for (uint32_t j1{0}; j1 < j2; ++j1) {
+        auto loVal{(*element)[j1]};
+        auto hiVal{(*element)[j1 + j2]};
+        auto omegaFactor{(loVal + twiceModulus - hiVal).ModMulFastConstLazy(omega1Inv, modulus, preconOmega1Inv)};
+        loVal = (loVal + hiVal).ModMulFastConstLazy(cycloOrderInv, modulus, preconCycloOrderInv);
+        if (loVal >= modulus)
+            loVal -= modulus;
+        if (omegaFactor >= modulus)
+            omegaFactor -= modulus;
+        (*element)[j1 + 0]  = loVal;
+        (*element)[j1 + j2] = omegaFactor;
+    }
+}
+
 template <typename VecType>
 void NumberTheoreticTransformNat<VecType>::InverseTransformFromBitReverse(
     const VecType& element, const VecType& rootOfUnityInverseTable, const VecType& preconRootOfUnityInverseTable,
@@ -641,6 +784,111 @@ void NumberTheoreticTransformNat<VecType>::InverseTransformFromBitReverse(
     return;
 }
 
+template <typename VecType>
+void NumberTheoreticTransformNat<VecType>::ForwardTransformToBitReverseInPlaceBlock(
+    const VecType& rootOfUnityTable, const VecType& preconRootOfUnityTable, uint32_t blocks, uint32_t block,
+    VecType* element) {
+    const uint32_t n(element->GetLength());
+    for (uint32_t m{blocks}, t{n / (blocks << 1)}; t >= 1; m <<= 1, t >>= 1) {
+        for (uint32_t i{block * (m / blocks)}, i1{i + m / blocks}; i < i1; ++i)
+            ForwardButterflyRun(rootOfUnityTable[i + m], preconRootOfUnityTable[i + m], (i << 1) * t, t, t, element);
+    }
+}
+
+template <typename VecType>
+void NumberTheoreticTransformNat<VecType>::InverseTransformFromBitReverseInPlaceBlock(
+    const VecType& rootOfUnityInverseTable, const VecType& preconRootOfUnityInverseTable, uint32_t blocks,
+    uint32_t block, VecType* element) {
+    const uint32_t n(element->GetLength());
+    for (uint32_t m{n >> 1}, t{1}; m >= blocks; m >>= 1, t <<= 1) {
+        for (uint32_t i{block * (m / blocks)}, i1{i + m / blocks}; i < i1; ++i)
+            InverseButterflyRun(rootOfUnityInverseTable[i + m], preconRootOfUnityInverseTable[i + m], (i << 1) * t, t,
+                                t, element);
+    }
+}
+
+template <typename VecType>
+void NumberTheoreticTransformNat<VecType>::ForwardButterflyRun(const IntType& omega, const IntType& preconOmega,
+                                                               uint32_t lo, uint32_t t, uint32_t len,
+                                                               VecType* element) {
+    const auto modulus{element->GetModulus()};
+    for (uint32_t j1{lo}, j2{lo + len}; j1 < j2; ++j1) {
+        auto omegaFactor{(*element)[j1 + t]};
+        omegaFactor.ModMulFastConstEq(omega, modulus, preconOmega);
+        auto loVal{(*element)[j1 + 0]};
+        auto hiVal{loVal + omegaFactor};
+        if (hiVal >= modulus)
+            hiVal -= modulus;
+        if (loVal < omegaFactor)
+            loVal += modulus;
+        loVal -= omegaFactor;
+        (*element)[j1 + 0] = hiVal;
+        (*element)[j1 + t] = loVal;
+    }
+}
+
+template <typename VecType>
+void NumberTheoreticTransformNat<VecType>::InverseButterflyRun(const IntType& omega, const IntType& preconOmega,
+                                                               uint32_t lo, uint32_t t, uint32_t len,
+                                                               VecType* element) {
+    const auto modulus{element->GetModulus()};
+    for (uint32_t j1{lo}, j2{lo + len}; j1 < j2; ++j1) {
+        auto loVal{(*element)[j1 + 0]};
+        auto hiVal{(*element)[j1 + t]};
+        auto omegaFactor{loVal};
+        if (omegaFactor < hiVal)
+            omegaFactor += modulus;
+        omegaFactor -= hiVal;
+        loVal += hiVal;
+        if (loVal >= modulus)
+            loVal -= modulus;
+        omegaFactor.ModMulFastConstEq(omega, modulus, preconOmega);
+        (*element)[j1 + 0] = loVal;
+        (*element)[j1 + t] = omegaFactor;
+    }
+}
+
+template <typename VecType>
+void NumberTheoreticTransformNat<VecType>::InverseFinalButterflyRun(const IntType& omega1Inv,
+                                                                    const IntType& preconOmega1Inv,
+                                                                    const IntType& cycloOrderInv,
+                                                                    const IntType& preconCycloOrderInv, uint32_t lo,
+                                                                    uint32_t len, VecType* element) {
+    const auto modulus{element->GetModulus()};
+    const uint32_t t(element->GetLength() >> 1);
+    for (uint32_t j1{lo}, j2{lo + len}; j1 < j2; ++j1) {
+        auto loVal{(*element)[j1 + 0]};
+        auto hiVal{(*element)[j1 + t]};
+        auto omegaFactor{loVal};
+        if (omegaFactor < hiVal)
+            omegaFactor += modulus;
+        omegaFactor -= hiVal;
+        loVal += hiVal;
+        if (loVal >= modulus)
+            loVal -= modulus;
+        loVal.ModMulFastConstEq(cycloOrderInv, modulus, preconCycloOrderInv);
+        omegaFactor.ModMulFastConstEq(omega1Inv, modulus, preconOmega1Inv);
+        (*element)[j1 + 0] = loVal;
+        (*element)[j1 + t] = omegaFactor;
+    }
+}
+
+// Number of blocks the transforms of a batch are split into. Unless requested explicitly, the towers are split
+// only as far as needed to give every thread work, keeping blocks large compared to the per-stage synchronization.
+inline uint32_t GetNTTBatchBlockCount(size_t towers, uint32_t n, uint32_t blocks) {
+    if (blocks != 0) {
+        if (!IsPowerOfTwo(blocks) || blocks > (n >> 1))
+            OPENFHE_THROW("number of blocks must be a power of two not larger than n / 2");
+        return blocks;
+    }
+    constexpr uint32_t minBlockSize{2048};
+    const size_t threads = OpenFHEParallelControls.GetThreadLimit(OpenFHEParallelControls.GetMachineThreads());
+    blocks = 1;
+    while (towers * blocks < threads && n / (blocks << 1) >= minBlockSize)
+        blocks <<= 1;
+    return blocks;
+}
+
 template <typename VecType>
 void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverseInPlace(const IntType& rootOfUnity,
                                                                                    const usint CycloOrder,
@@ -665,8 +913,19 @@ void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverseInPla
         PreCompute(rootOfUnity, CycloOrder, modulus);
     }
 
-    NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverseInPlace(
-        m_rootOfUnityReverseTableByModulus[modulus], m_rootOfUnityPreconReverseTableByModulus[modulus], element);
+    const auto& rootOfUnityTable{m_rootOfUnityReverseTableByModulus[modulus]};
+    const auto& preconRootOfUnityTable{m_rootOfUnityPreconReverseTableByModulus[modulus]};
+    if constexpr (IsSIMDTransformable<VecType>) {
+        if (ForwardTransformToBitReverseInPlaceSIMD(SIMDData(rootOfUnityTable), SIMDData(preconRootOfUnityTable),
+                                                    modulus.ConvertToInt(), CycloOrderHf, SIMDData(element)))
+            return;
+    }
+    if (m_lazyReduction.load(std::memory_order_relaxed))
+        NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverseInPlaceLazy(rootOfUnityTable,
+                                                                                       preconRootOfUnityTable, element);
+    else
+        NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverseInPlace(rootOfUnityTable,
+                                                                                   preconRootOfUnityTable, element);
 }
 
 template <typename VecType>
@@ -694,9 +953,32 @@ void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverse(cons
         PreCompute(rootOfUnity, CycloOrder, modulus);
     }
 
-    NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverse(
-        element, m_rootOfUnityReverseTableByModulus[modulus], m_rootOfUnityPreconReverseTableByModulus[modulus],
-        result);
+    const auto& rootOfUnityTable{m_rootOfUnityReverseTableByModulus[modulus]};
+    const auto& preconRootOfUnityTable{m_rootOfUnityPreconReverseTableByModulus[modulus]};
+    const bool lazy{m_lazyReduction.load(std::memory_order_relaxed)};
+    bool simd{false};
+    if constexpr (IsSIMDTransformable<VecType>)
+        simd = GetNTTKernelType() != NTT_KERNEL_SCALAR;
+    if (simd || lazy) {
+        result->SetModulus(modulus);
+        for (usint i = 0; i < CycloOrderHf; ++i)
+            (*result)[i] = element[i];
+        if constexpr (IsSIMDTransformable<VecType>) {
+            if (simd && ForwardTransformToBitReverseInPlaceSIMD(SIMDData(rootOfUnityTable),
+                                                                SIMDData(preconRootOfUnityTable),
+                                                                modulus.ConvertToInt(), CycloOrderHf, SIMDData(result)))
+                return;
+        }
+        if (lazy)
+            NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverseInPlaceLazy(
+                rootOfUnityTable, preconRootOfUnityTable, result);
+        else
+            NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverseInPlace(
+                rootOfUnityTable, preconRootOfUnityTable, result);
+        return;
+    }
+    NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverse(element, rootOfUnityTable,
+                                                                        preconRootOfUnityTable, result);
 
     return;
 }
@@ -726,10 +1008,22 @@ void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverseInP
     }
 
     usint msb = GetMSB(CycloOrderHf - 1);
-    NumberTheoreticTransformNat<VecType>().InverseTransformFromBitReverseInPlace(
-        m_rootOfUnityInverseReverseTableByModulus[modulus], m_rootOfUnityInversePreconReverseTableByModulus[modulus],
-        m_cycloOrderInverseTableByModulus[modulus][msb], m_cycloOrderInversePreconTableByModulus[modulus][msb],
-        element);
+    const auto& rootOfUnityInverseTable{m_rootOfUnityInverseReverseTableByModulus[modulus]};
+    const auto& preconRootOfUnityInverseTable{m_rootOfUnityInversePreconReverseTableByModulus[modulus]};
+    const auto& cycloOrderInv{m_cycloOrderInverseTableByModulus[modulus][msb]};
+    const auto& preconCycloOrderInv{m_cycloOrderInversePreconTableByModulus[modulus][msb]};
+    if constexpr (IsSIMDTransformable<VecType>) {
+        if (InverseTransformFromBitReverseInPlaceSIMD(
+                SIMDData(rootOfUnityInverseTable), SIMDData(preconRootOfUnityInverseTable), cycloOrderInv.ConvertToInt(),
+                preconCycloOrderInv.ConvertToInt(), modulus.ConvertToInt(), CycloOrderHf, SIMDData(element)))
+            return;
+    }
+    if (m_lazyReduction.load(std::memory_order_relaxed))
+        NumberTheoreticTransformNat<VecType>().InverseTransformFromBitReverseInPlaceLazy(
+            rootOfUnityInverseTable, preconRootOfUnityInverseTable, cycloOrderInv, preconCycloOrderInv, element);
+    else
+        NumberTheoreticTransformNat<VecType>().InverseTransformFromBitReverseInPlace(
+            rootOfUnityInverseTable, preconRootOfUnityInverseTable, cycloOrderInv, preconCycloOrderInv, element);
 }
 
 template <typename VecType>
@@ -764,13 +1058,264 @@ void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverse(co
     }
 
     usint msb = GetMSB(CycloOrderHf - 1);
-    NumberTheoreticTransformNat<VecType>().InverseTransformFromBitReverseInPlace(
-        m_rootOfUnityInverseReverseTableByModulus[modulus], m_rootOfUnityInversePreconReverseTableByModulus[modulus],
-        m_cycloOrderInverseTableByModulus[modulus][msb], m_cycloOrderInversePreconTableByModulus[modulus][msb], result);
+    const auto& rootOfUnityInverseTable{m_rootOfUnityInverseReverseTableByModulus[modulus]};
+    const auto& preconRootOfUnityInverseTable{m_rootOfUnityInversePreconReverseTableByModulus[modulus]};
+    const auto& cycloOrderInv{m_cycloOrderInverseTableByModulus[modulus][msb]};
+    const auto& preconCycloOrderInv{m_cycloOrderInversePreconTableByModulus[modulus][msb]};
+    if constexpr (IsSIMDTransformable<VecType>) {
+        if (InverseTransformFromBitReverseInPlaceSIMD(
+                SIMDData(rootOfUnityInverseTable), SIMDData(preconRootOfUnityInverseTable), cycloOrderInv.ConvertToInt(),
+                preconCycloOrderInv.ConvertToInt(), modulus.ConvertToInt(), CycloOrderHf, SIMDData(result)))
+            return;
+    }
+    if (m_lazyReduction.load(std::memory_order_relaxed))
+        NumberTheoreticTransformNat<VecType>().InverseTransformFromBitReverseInPlaceLazy(
+            rootOfUnityInverseTable, preconRootOfUnityInverseTable, cycloOrderInv, preconCycloOrderInv, result);
+    else
+        NumberTheoreticTransformNat<VecType>().InverseTransformFromBitReverseInPlace(
+            rootOfUnityInverseTable, preconRootOfUnityInverseTable, cycloOrderInv, preconCycloOrderInv, result);
 
     return;
 }
 
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverseInPlaceBatch(
+    const std::vector<IntType>& rootOfUnity, const usint CycloOrder, const std::vector<VecType*>& elements,
+    uint32_t blocks) {
+    if (rootOfUnity.size() != elements.size()) {
+        OPENFHE_THROW("size of root of unity and number of elements not of same size");
+    }
+
+    if (!IsPowerOfTwo(CycloOrder)) {
+        OPENFHE_THROW("CyclotomicOrder is not a power of two");
+    }
+
+    usint CycloOrderHf = (CycloOrder >> 1);
+
+    // the tables are looked up (and precomputed) here so that the parallel region below does not touch the maps
+    std::vector<VecType*> towers;
+    std::vector<const VecType*> rootOfUnityTables;
+    std::vector<const VecType*> preconRootOfUnityTables;
+    for (size_t i = 0; i < elements.size(); ++i) {
+        if (rootOfUnity[i] == IntType(1) || rootOfUnity[i] == IntType(0))
+            continue;
+
+        if (elements[i]->GetLength() != CycloOrderHf) {
+            OPENFHE_THROW("element size must be equal to CyclotomicOrder / 2");
+        }
+
+        IntType modulus = elements[i]->GetModulus();
+
+        auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
+        if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
+            PreCompute(rootOfUnity[i], CycloOrder, modulus);
+        }
+
+        towers.push_back(elements[i]);
+        rootOfUnityTables.push_back(&m_rootOfUnityReverseTableByModulus[modulus]);
+        preconRootOfUnityTables.push_back(&m_rootOfUnityPreconReverseTableByModulus[modulus]);
+    }
+
+    size_t size{towers.size()};
+    blocks = GetNTTBatchBlockCount(size, CycloOrderHf, blocks);
+
+    if (blocks == 1) {
+        const bool lazy{m_lazyReduction.load(std::memory_order_relaxed)};
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
+        for (size_t i = 0; i < size; ++i) {
+            if constexpr (IsSIMDTransformable<VecType>) {
+                if (ForwardTransformToBitReverseInPlaceSIMD(
+                        SIMDData(*rootOfUnityTables[i]), SIMDData(*preconRootOfUnityTables[i]),
+                        towers[i]->GetModulus().ConvertToInt(), CycloOrderHf, SIMDData(towers[i])))
+                    continue;
+            }
+            if (lazy)
+                NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverseInPlaceLazy(
+                    *rootOfUnityTables[i], *preconRootOfUnityTables[i], towers[i]);
+            else
+                NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverseInPlace(
+                    *rootOfUnityTables[i], *preconRootOfUnityTables[i], towers[i]);
+        }
+        return;
+    }
+
+    // The first log2(blocks) stages have fewer butterfly groups than blocks; each of them is split into runs of
+    // len butterflies sharing one twiddle. All later stages only combine coefficients within one block.
+    const uint32_t len{CycloOrderHf / (blocks << 1)};
+#pragma omp parallel num_threads(OpenFHEParallelControls.GetThreadLimit(size * blocks))
+    {
+        for (uint32_t m = 1, t = CycloOrderHf >> 1; m < blocks; m <<= 1, t >>= 1) {
+            const uint32_t runsPerGroup{blocks / m};
+#pragma omp for collapse(2)
+            for (size_t i = 0; i < size; ++i) {
+                for (uint32_t r = 0; r < blocks; ++r) {
+                    const uint32_t group{r / runsPerGroup};
+                    const uint32_t lo{(group << 1) * t + (r % runsPerGroup) * len};
+                    const auto& omega{(*rootOfUnityTables[i])[group + m]};
+                    const auto& preconOmega{(*preconRootOfUnityTables[i])[group + m]};
+                    if constexpr (IsSIMDTransformable<VecType>) {
+                        uint64_t* data{SIMDData(towers[i])};
+                        if (ForwardButterflyRunSIMD(omega.ConvertToInt(), preconOmega.ConvertToInt(),
+                                                    towers[i]->GetModulus().ConvertToInt(), len, data + lo,
+                                                    data + lo + t))
+                            continue;
+                    }
+                    NumberTheoreticTransformNat<VecType>().ForwardButterflyRun(omega, preconOmega, lo, t, len,
+                                                                               towers[i]);
+                }
+            }
+        }
+#pragma omp for collapse(2)
+        for (size_t i = 0; i < size; ++i) {
+            for (uint32_t b = 0; b < blocks; ++b) {
+                if constexpr (IsSIMDTransformable<VecType>) {
+                    if (ForwardTransformToBitReverseBlockSIMD(
+                            SIMDData(*rootOfUnityTables[i]), SIMDData(*preconRootOfUnityTables[i]),
+                            towers[i]->GetModulus().ConvertToInt(), CycloOrderHf, blocks, b, SIMDData(towers[i])))
+                        continue;
+                }
+                NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverseInPlaceBlock(
+                    *rootOfUnityTables[i], *preconRootOfUnityTables[i], blocks, b, towers[i]);
+            }
+        }
+    }
+}
+
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverseInPlaceBatch(
+    const std::vector<IntType>& rootOfUnity, const usint CycloOrder, const std::vector<VecType*>& elements,
+    uint32_t blocks) {
+    if (rootOfUnity.size() != elements.size()) {
+        OPENFHE_THROW("size of root of unity and number of elements not of same size");
+    }
+
+    if (!IsPowerOfTwo(CycloOrder)) {
+        OPENFHE_THROW("CyclotomicOrder is not a power of two");
+    }
+
+    usint CycloOrderHf = (CycloOrder >> 1);
+    usint msb          = GetMSB(CycloOrderHf - 1);
+
+    // the tables are looked up (and precomputed) here so that the parallel region below does not touch the maps
+    std::vector<VecType*> towers;
+    std::vector<const VecType*> rootOfUnityInverseTables;
+    std::vector<const VecType*> preconRootOfUnityInverseTables;
+    std::vector<IntType> cycloOrderInv;
+    std::vector<IntType> preconCycloOrderInv;
+    for (size_t i = 0; i < elements.size(); ++i) {
+        if (rootOfUnity[i] == IntType(1) || rootOfUnity[i] == IntType(0))
+            continue;
+
+        if (elements[i]->GetLength() != CycloOrderHf) {
+            OPENFHE_THROW("element size must be equal to CyclotomicOrder / 2");
+        }
+
+        IntType modulus = elements[i]->GetModulus();
+
+        auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
+        if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
+            PreCompute(rootOfUnity[i], CycloOrder, modulus);
+        }
+
+        towers.push_back(elements[i]);
+        rootOfUnityInverseTables.push_back(&m_rootOfUnityInverseReverseTableByModulus[modulus]);
+        preconRootOfUnityInverseTables.push_back(&m_rootOfUnityInversePreconReverseTableByModulus[modulus]);
+        cycloOrderInv.push_back(m_cycloOrderInverseTableByModulus[modulus][msb]);
+        preconCycloOrderInv.push_back(m_cycloOrderInversePreconTableByModulus[modulus][msb]);
+    }
+
+    size_t size{towers.size()};
+    blocks = GetNTTBatchBlockCount(size, CycloOrderHf, blocks);
+
+    if (blocks == 1) {
+        const bool lazy{m_lazyReduction.load(std::memory_order_relaxed)};
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
+        for (size_t i = 0; i < size; ++i) {
+            if constexpr (IsSIMDTransformable<VecType>) {
+                if (InverseTransformFromBitReverseInPlaceSIMD(
+                        SIMDData(*rootOfUnityInverseTables[i]), SIMDData(*preconRootOfUnityInverseTables[i]),
+                        cycloOrderInv[i].ConvertToInt(), preconCycloOrderInv[i].ConvertToInt(),
+                        towers[i]->GetModulus().ConvertToInt(), CycloOrderHf, SIMDData(towers[i])))
+                    continue;
+            }
+            if (lazy)
+                NumberTheoreticTransformNat<VecType>().InverseTransformFromBitReverseInPlaceLazy(
+                    *rootOfUnityInverseTables[i], *preconRootOfUnityInverseTables[i], cycloOrderInv[i],
+                    preconCycloOrderInv[i], towers[i]);
+            else
+                NumberTheoreticTransformNat<VecType>().InverseTransformFromBitReverseInPlace(
+                    *rootOfUnityInverseTables[i], *preconRootOfUnityInverseTables[i], cycloOrderInv[i],
+                    preconCycloOrderInv[i], towers[i]);
+        }
+        return;
+    }
+
+    // precomputed omega[bitreversed(1)] * (n inverse). used in final stage of intt.
+    std::vector<IntType> omega1Inv(size);
+    std::vector<IntType> preconOmega1Inv(size);
+    for (size_t i = 0; i < size; ++i) {
+        const auto& modulus{towers[i]->GetModulus()};
+        omega1Inv[i] = (*rootOfUnityInverseTables[i])[1].ModMulFastConst(cycloOrderInv[i], modulus,
+                                                                         preconCycloOrderInv[i]);
+        preconOmega1Inv[i] = omega1Inv[i].PrepModMulConst(modulus);
+    }
+
+    // mirror image of ForwardTransformToBitReverseInPlaceBatch(): the stages within the blocks come first, the last
+    // log2(blocks) stages are split into runs of len butterflies sharing one twiddle
+    const uint32_t len{CycloOrderHf / (blocks << 1)};
+#pragma omp parallel num_threads(OpenFHEParallelControls.GetThreadLimit(size * blocks))
+    {
+#pragma omp for collapse(2)
+        for (size_t i = 0; i < size; ++i) {
+            for (uint32_t b = 0; b < blocks; ++b) {
+                if constexpr (IsSIMDTransformable<VecType>) {
+                    if (InverseTransformFromBitReverseBlockSIMD(
+                            SIMDData(*rootOfUnityInverseTables[i]), SIMDData(*preconRootOfUnityInverseTables[i]),
+                            towers[i]->GetModulus().ConvertToInt(), CycloOrderHf, blocks, b, SIMDData(towers[i])))
+                        continue;
+                }
+                NumberTheoreticTransformNat<VecType>().InverseTransformFromBitReverseInPlaceBlock(
+                    *rootOfUnityInverseTables[i], *preconRootOfUnityInverseTables[i], blocks, b, towers[i]);
+            }
+        }
+        for (uint32_t m = blocks >> 1, t = CycloOrderHf / blocks; m >= 1; m >>= 1, t <<= 1) {
+            const uint32_t runsPerGroup{blocks / m};
+#pragma omp for collapse(2)
+            for (size_t i = 0; i < size; ++i) {
+                for (uint32_t r = 0; r < blocks; ++r) {
+                    const uint32_t group{r / runsPerGroup};
+                    const uint32_t lo{(group << 1) * t + (r % runsPerGroup) * len};
+                    if (m == 1) {
+                        if constexpr (IsSIMDTransformable<VecType>) {
+                            uint64_t* data{SIMDData(towers[i])};
+                            if (InverseFinalButterflyRunSIMD(
+                                    omega1Inv[i].ConvertToInt(), preconOmega1Inv[i].ConvertToInt(),
+                                    cycloOrderInv[i].ConvertToInt(), preconCycloOrderInv[i].ConvertToInt(),
+                                    towers[i]->GetModulus().ConvertToInt(), len, data + lo, data + lo + t))
+                                continue;
+                        }
+                        NumberTheoreticTransformNat<VecType>().InverseFinalButterflyRun(
+                            omega1Inv[i], preconOmega1Inv[i], cycloOrderInv[i], preconCycloOrderInv[i], lo, len,
+                            towers[i]);
+                        continue;
+                    }
+                    const auto& omega{(*rootOfUnityInverseTables[i])[group + m]};
+                    const auto& preconOmega{(*preconRootOfUnityInverseTables[i])[group + m]};
+                    if constexpr (IsSIMDTransformable<VecType>) {
+                        uint64_t* data{SIMDData(towers[i])};
+                        if (InverseButterflyRunSIMD(omega.ConvertToInt(), preconOmega.ConvertToInt(),
+                                                    towers[i]->GetModulus().ConvertToInt(), len, data + lo,
+                                                    data + lo + t))
+                            continue;
+                    }
+                    NumberTheoreticTransformNat<VecType>().InverseButterflyRun(omega, preconOmega, lo, t, len,
+                                                                               towers[i]);
+                }
+            }
+        }
+    }
+}
+
 template <typename VecType>
 void ChineseRemainderTransformFTTNat<VecType>::PreCompute(const IntType& rootOfUnity, const usint CycloOrder,
                                                           const IntType& modulus) {
@@ -845,6 +1390,16 @@ void ChineseRemainderTransformFTTNat<VecType>::PreCompute(std::vector<IntType>&
     }
 }
 
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::SetLazyReduction(bool lazy) {
+    m_lazyReduction.store(lazy, std::memory_order_relaxed);
+}
+
+template <typename VecType>
+bool ChineseRemainderTransformFTTNat<VecType>::GetLazyReduction() {
+    return m_lazyReduction.load(std::memory_order_relaxed);
+}
+
 template <typename VecType>
 void ChineseRemainderTransformFTTNat<VecType>::Reset() {
     m_cycloOrderInverseTableByModulus.clear();
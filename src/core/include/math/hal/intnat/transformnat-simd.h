@@ -0,0 +1,149 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+ This file contains the runtime-dispatched SIMD kernels (AVX2 and AVX-512 IFMA) for the native NTT
+*/
+
+#ifndef LBCRYPTO_MATH_HAL_INTNAT_TRANSFORMNAT_SIMD_H
+#define LBCRYPTO_MATH_HAL_INTNAT_TRANSFORMNAT_SIMD_H
+
+#include <cstdint>
+#include <iosfwd>
+
+namespace intnat {
+
+/**
+ * @brief Instruction set used by the negacyclic NTT in ChineseRemainderTransformFTTNat.
+ * The kernel is selected once at startup from CPUID and can be overridden with SetNTTKernelType().
+ * All kernels produce results identical to the scalar NumberTheoreticTransformNat code.
+ */
+enum NTTKernelType {
+    NTT_KERNEL_SCALAR     = 0,  // portable scalar butterflies (NumberTheoreticTransformNat)
+    NTT_KERNEL_AVX2       = 1,  // 4 x 64-bit lanes, 64x64-bit products emulated with 32-bit multiplies
+    NTT_KERNEL_AVX512IFMA = 2,  // 8 x 64-bit lanes, 52-bit multiply-add; used for moduli below 2^50
+};
+
+std::ostream& operator<<(std::ostream& s, NTTKernelType t);
+
+/**
+ * Returns the fastest NTT kernel supported by the CPU the library is running on
+ */
+NTTKernelType GetSupportedNTTKernelType();
+
+/**
+ * Returns the NTT kernel currently used by ChineseRemainderTransformFTTNat
+ */
+NTTKernelType GetNTTKernelType();
+
+/**
+ * Overrides the NTT kernel used by ChineseRemainderTransformFTTNat (mostly for testing and benchmarking).
+ * Throws if the CPU does not support the requested kernel.
+ */
+void SetNTTKernelType(NTTKernelType type);
+
+/**
+ * In-place forward negacyclic NTT with bit-reversed output using the kernel selected by GetNTTKernelType().
+ * Same contract as NumberTheoreticTransformNat::ForwardTransformToBitReverseInPlace() with Shoup's
+ * precomputations, operating on raw 64-bit words.
+ *
+ * @return false if no SIMD kernel is selected or applicable for the modulus/ring dimension, in which case
+ * element is left untouched and the caller should run the scalar transform.
+ */
+bool ForwardTransformToBitReverseInPlaceSIMD(const uint64_t* rootOfUnityTable, const uint64_t* preconRootOfUnityTable,
+                                             uint64_t modulus, uint32_t n, uint64_t* element);
+
+/**
+ * In-place inverse negacyclic NTT from bit-reversed input using the kernel selected by GetNTTKernelType().
+ * Same contract as NumberTheoreticTransformNat::InverseTransformFromBitReverseInPlace() with Shoup's
+ * precomputations, operating on raw 64-bit words.
+ *
+ * @return false if no SIMD kernel is selected or applicable for the modulus/ring dimension, in which case
+ * element is left untouched and the caller should run the scalar transform.
+ */
+bool InverseTransformFromBitReverseInPlaceSIMD(const uint64_t* rootOfUnityInverseTable,
+                                               const uint64_t* preconRootOfUnityInverseTable, uint64_t cycloOrderInv,
+                                               uint64_t preconCycloOrderInv, uint64_t modulus, uint32_t n,
+                                               uint64_t* element);
+
+/**
+ * Block of an in-place forward NTT for transforms split across threads: runs the stages with at least blocks
+ * butterfly groups, restricted to the coefficients [block * n / blocks, (block + 1) * n / blocks) of element.
+ * The earlier stages have to be applied before (see ForwardButterflyRunSIMD()). blocks = 1 is the complete
+ * transform.
+ *
+ * @return false if no SIMD kernel is applicable, in which case element is left untouched.
+ */
+bool ForwardTransformToBitReverseBlockSIMD(const uint64_t* rootOfUnityTable, const uint64_t* preconRootOfUnityTable,
+                                           uint64_t modulus, uint32_t n, uint32_t blocks, uint32_t block,
+                                           uint64_t* element);
+
+/**
+ * Block of an in-place inverse NTT for transforms split across threads (blocks >= 2): runs the stages with at
+ * least blocks butterfly groups restricted to one block. The remaining stages, including the final one with
+ * the scaling by (n inverse), have to be applied afterwards (see InverseButterflyRunSIMD() and
+ * InverseFinalButterflyRunSIMD()).
+ *
+ * @return false if no SIMD kernel is applicable, in which case element is left untouched.
+ */
+bool InverseTransformFromBitReverseBlockSIMD(const uint64_t* rootOfUnityInverseTable,
+                                             const uint64_t* preconRootOfUnityInverseTable, uint64_t modulus,
+                                             uint32_t n, uint32_t blocks, uint32_t block, uint64_t* element);
+
+/**
+ * Cooley-Tukey butterflies (lo[j], hi[j]) -> (lo[j] + omega*hi[j], lo[j] - omega*hi[j]) for j in [0, len).
+ *
+ * @return false if no SIMD kernel is applicable, in which case lo and hi are left untouched.
+ */
+bool ForwardButterflyRunSIMD(uint64_t omega, uint64_t preconOmega, uint64_t modulus, uint32_t len, uint64_t* lo,
+                             uint64_t* hi);
+
+/**
+ * Gentleman-Sande butterflies (lo[j], hi[j]) -> (lo[j] + hi[j], (lo[j] - hi[j])*omega) for j in [0, len).
+ *
+ * @return false if no SIMD kernel is applicable, in which case lo and hi are left untouched.
+ */
+bool InverseButterflyRunSIMD(uint64_t omega, uint64_t preconOmega, uint64_t modulus, uint32_t len, uint64_t* lo,
+                             uint64_t* hi);
+
+/**
+ * Final INTT stage (lo[j], hi[j]) -> ((lo[j] + hi[j])*cycloOrderInv, (lo[j] - hi[j])*omega1Inv) for j in [0, len),
+ * where omega1Inv already includes the factor (n inverse).
+ *
+ * @return false if no SIMD kernel is applicable, in which case lo and hi are left untouched.
+ */
+bool InverseFinalButterflyRunSIMD(uint64_t omega1Inv, uint64_t preconOmega1Inv, uint64_t cycloOrderInv,
+                                  uint64_t preconCycloOrderInv, uint64_t modulus, uint32_t len, uint64_t* lo,
+                                  uint64_t* hi);
+
+}  // namespace intnat
+
+#endif
@@ -40,6 +40,7 @@
 
 #include "utils/inttypes.h"
 
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <unordered_map>
@@ -239,6 +240,91 @@ public:
                                                const VecType& preconRootOfUnityInverseTable,
                                                const IntType& cycloOrderInv, const IntType& preconCycloOrderInv,
                                                VecType* element);
+
+    /**
+   * In-place forward transform with Harvey's lazy butterflies: intermediate values are kept in [0, 4q)
+   * and only the last stage reduces them to [0, q), which saves most of the conditional subtractions
+   * of ForwardTransformToBitReverseInPlace(). The output is identical. Requires 4q to fit into the
+   * native word; larger moduli are handled by ForwardTransformToBitReverseInPlace().
+   * [D. Harvey, Faster arithmetic for number-theoretic transforms, https://arxiv.org/abs/1205.2926]
+   *
+   * @param &rootOfUnityTable is the table with the root of unity powers in bit reverse order.
+   * @param &preconRootOfUnityTable is Shoup's precomputations of the table above.
+   * @param &element[in,out] is the input/output of the transform of type VecType and length n.
+   */
+    void ForwardTransformToBitReverseInPlaceLazy(const VecType& rootOfUnityTable,
+                                                 const VecType& preconRootOfUnityTable, VecType* element);
+
+    /**
+   * In-place inverse transform with Harvey's lazy butterflies (intermediate values in [0, 2q)); the
+   * output is identical to InverseTransformFromBitReverseInPlace(), which handles moduli where 4q does
+   * not fit into the native word.
+   *
+   * @param &rootOfUnityInverseTable is the table with the inverse root of unity powers in bit reverse order.
+   * @param &preconRootOfUnityInverseTable is Shoup's precomputations of the table above.
+   * @param &cycloOrderInv is inverse of n modulo q
+   * @param &preconCycloOrderInv is Shoup's precomputation of cycloOrderInv.
+   * @param &element[in,out] is the input/output of the transform of type VecType and length n.
+   */
+    void InverseTransformFromBitReverseInPlaceLazy(const VecType& rootOfUnityInverseTable,
+                                                   const VecType& preconRootOfUnityInverseTable,
+                                                   const IntType& cycloOrderInv, const IntType& preconCycloOrderInv,
+                                                   VecType* element);
+
+    /**
+   * Block of an in-place forward transform split into independent parts for parallel execution
+   * (see ChineseRemainderTransformFTTNat::ForwardTransformToBitReverseInPlaceBatch()). Runs the stages
+   * with at least \p blocks butterfly groups, restricted to the coefficients
+   * [block * n / blocks, (block + 1) * n / blocks). The first log2(blocks) stages have to be
+   * applied before with ForwardButterflyRun().
+   *
+   * @param &rootOfUnityTable is the table with the root of unity powers in bit reverse order.
+   * @param &preconRootOfUnityTable is Shoup's precomputations of the table above.
+   * @param blocks is the number of blocks, a power of two not larger than n.
+   * @param block is the index of the block to transform.
+   * @param &element[in,out] is the input/output of the transform of type VecType and length n.
+   */
+    void ForwardTransformToBitReverseInPlaceBlock(const VecType& rootOfUnityTable,
+                                                  const VecType& preconRootOfUnityTable, uint32_t blocks,
+                                                  uint32_t block, VecType* element);
+
+    /**
+   * Block of an in-place inverse transform split into independent parts for parallel execution
+   * (see ChineseRemainderTransformFTTNat::InverseTransformFromBitReverseInPlaceBatch()). Runs the stages
+   * with at least \p blocks butterfly groups, restricted to one block; blocks >= 2. The remaining stages
+   * have to be applied afterwards with InverseButterflyRun() and InverseFinalButterflyRun().
+   *
+   * @param &rootOfUnityInverseTable is the table with the inverse root of unity powers in bit reverse order.
+   * @param &preconRootOfUnityInverseTable is Shoup's precomputations of the table above.
+   * @param blocks is the number of blocks, a power of two not larger than n.
+   * @param block is the index of the block to transform.
+   * @param &element[in,out] is the input/output of the transform of type VecType and length n.
+   */
+    void InverseTransformFromBitReverseInPlaceBlock(const VecType& rootOfUnityInverseTable,
+                                                    const VecType& preconRootOfUnityInverseTable, uint32_t blocks,
+                                                    uint32_t block, VecType* element);
+
+    /**
+   * Cooley-Tukey butterflies sharing the twiddle omega on the pairs (element[j], element[j + t])
+   * for j in [lo, lo + len)
+   */
+    void ForwardButterflyRun(const IntType& omega, const IntType& preconOmega, uint32_t lo, uint32_t t, uint32_t len,
+                             VecType* element);
+
+    /**
+   * Gentleman-Sande butterflies sharing the twiddle omega on the pairs (element[j], element[j + t])
+   * for j in [lo, lo + len)
+   */
+    void InverseButterflyRun(const IntType& omega, const IntType& preconOmega, uint32_t lo, uint32_t t, uint32_t len,
+                             VecType* element);
+
+    /**
+   * Final stage of the inverse transform on the pairs (element[j], element[j + n/2]) for j in [lo, lo + len):
+   * omega1Inv = omega[bitreversed(1)] * (n inverse) and the sums are scaled by cycloOrderInv = (n inverse).
+   */
+    void InverseFinalButterflyRun(const IntType& omega1Inv, const IntType& preconOmega1Inv,
+                                  const IntType& cycloOrderInv, const IntType& preconCycloOrderInv, uint32_t lo,
+                                  uint32_t len, VecType* element);
 };
 
 /**
@@ -318,6 +404,55 @@ public:
    */
     void InverseTransformFromBitReverseInPlace(const IntType& rootOfUnity, const usint CycloOrder, VecType* element);
 
+    /**
+   * In-place Forward Transform of several RNS towers in the rings Z_qi[X]/(X^n+1). Equivalent to calling
+   * ForwardTransformToBitReverseInPlace() on every element, but parallelized over the towers and, when
+   * there are fewer towers than threads, also over blocks of butterflies within the NTT stages, so that
+   * a few large towers still keep all cores busy.
+   *
+   * @param &rootOfUnity holds the 2n-th root of unity in Z_qi of every element. If rootOfUnity[i] == 0
+   * or 1, then the element i is left unchanged.
+   * @param CycloOrder is 2n, should be a power-of-two or a throw if an error
+   * occurs.
+   * @param[in,out] &elements are the inputs/outputs of the transforms, each of length n.
+   * @param blocks is the number of blocks every transform is split into (a power of two); 0 selects it
+   * from the number of towers and threads.
+   * @see ForwardTransformToBitReverseInPlace()
+   */
+    void ForwardTransformToBitReverseInPlaceBatch(const std::vector<IntType>& rootOfUnity, const usint CycloOrder,
+                                                  const std::vector<VecType*>& elements, uint32_t blocks = 0);
+
+    /**
+   * In-place Inverse Transform of several RNS towers in the rings Z_qi[X]/(X^n+1). Equivalent to calling
+   * InverseTransformFromBitReverseInPlace() on every element; parallelized as
+   * ForwardTransformToBitReverseInPlaceBatch().
+   *
+   * @param &rootOfUnity holds the 2n-th root of unity in Z_qi of every element. If rootOfUnity[i] == 0
+   * or 1, then the element i is left unchanged.
+   * @param CycloOrder is 2n, should be a power-of-two or a throw if an error
+   * occurs.
+   * @param[in,out] &elements are the inputs/outputs of the transforms, each of length n.
+   * @param blocks is the number of blocks every transform is split into (a power of two); 0 selects it
+   * from the number of towers and threads.
+   * @see InverseTransformFromBitReverseInPlace()
+   */
+    void InverseTransformFromBitReverseInPlaceBatch(const std::vector<IntType>& rootOfUnity, const usint CycloOrder,
+                                                    const std::vector<VecType*>& elements, uint32_t blocks = 0);
+
+    /**
+   * Selects Harvey's lazy butterflies (see NumberTheoreticTransformNat::ForwardTransformToBitReverseInPlaceLazy())
+   * for the scalar transforms, i.e., when the NTT kernel is NTT_KERNEL_SCALAR or no SIMD kernel applies.
+   * The results do not depend on this setting.
+   *
+   * @param lazy true for lazy reduction, false (default) for fully reduced butterflies.
+   */
+    static void SetLazyReduction(bool lazy);
+
+    /**
+   * @return true if the scalar transforms use Harvey's lazy butterflies
+   */
+    static bool GetLazyReduction();
+
     /**
    * Precomputation of root of unity tables for transforms in the ring
    * Z_q[X]/(X^n+1)
@@ -347,6 +482,9 @@ public:
    */
     void Reset();
 
+    /// selects the lazy scalar butterflies (see SetLazyReduction())
+    static std::atomic<bool> m_lazyReduction;
+
     /// map to store the cyclo order inverse with modulus as a key
     /// For inverse FTT, we also need #m_cycloOrderInversePreconTableByModulus (this is to use an N-size NTT for FTT instead of 2N-size NTT).
     static std::map<IntType, VecType> m_cycloOrderInverseTableByModulus;
@@ -1490,6 +1490,23 @@ public:
         return *this;
     }
 
+    /**
+   * Modular multiplication using a precomputation for the multiplicand, without
+   * the final correction (Harvey's lazy variant of Shoup's algorithm). This
+   * NativeIntegerT may be any value (not necessarily reduced); the result is
+   * congruent to this * b and lies in [0, 2 * modulus).
+   *
+   * @param &b is the NativeIntegerT to multiply, in [0, modulus).
+   * @param modulus is the modulus to perform operations with.
+   * @param &bInv precomputation for b.
+   * @return is the result of the modulus multiplication operation in [0, 2 * modulus).
+   */
+    NativeIntegerT ModMulFastConstLazy(const NativeIntegerT& b, const NativeIntegerT& modulus,
+                                       const NativeIntegerT& bInv) const {
+        NativeInt q = MultDHi(m_value, bInv.m_value);
+        return {static_cast<NativeInt>(m_value * b.m_value - q * modulus.m_value)};
+    }
+
     /**
    * Modulus exponentiation operation.
    *
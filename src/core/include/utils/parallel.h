@@ -40,6 +40,8 @@
     #include <omp.h>
 #endif
 
+#include <utility>
+
 namespace lbcrypto {
 
 class ParallelControls {
@@ -108,15 +110,31 @@ public:
 #endif
     }
 
-    // @Brief returns min of int n and machineThreads
+    // @Brief returns min of int n, machineThreads and the thread cap of the calling thread
     int GetThreadLimit(int n) const {
 #ifdef PARALLEL
-        return n > machineThreads ? machineThreads : n;
+        int limit     = machineThreads;
+        const int cap = ThreadCap();
+        if (cap > 0 && cap < limit)
+            limit = cap;
+        return n > limit ? limit : n;
 #else
         return 1;
 #endif
     }
 
+    // @Brief caps the number of threads GetThreadLimit() returns on the calling thread only, e.g., for the
+    // parallel loops of one of several concurrent workers; 0 removes the cap. The OpenMP settings are unchanged
+    // @return the previous cap of the calling thread, to be restored by the caller
+    int SetThreadCap(int nthreads) {
+        return std::exchange(ThreadCap(), nthreads);
+    }
+
+    // @Brief returns the thread cap of the calling thread; 0 if there is none
+    int GetThreadCap() const {
+        return ThreadCap();
+    }
+
     // @Brief sets number of threads to use (limited by system value)
     void SetNumThreads(int nthreads) {
 #ifdef PARALLEL
@@ -126,6 +144,11 @@ public:
     }
 
 private:
+    static int& ThreadCap() {
+        static thread_local int cap = 0;
+        return cap;
+    }
+
     int machineThreads{1};
 };
 
@@ -0,0 +1,154 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2024, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+/*
+  PRNG engine based on the AES-256 CTR_DRBG of NIST SP 800-90A
+ */
+
+#ifndef __AESCTRENGINE_H__
+#define __AESCTRENGINE_H__
+
+#include "utils/prng/prng.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace default_prng {
+/**
+ * @brief PRNG engine implementing CTR_DRBG with AES-256 (NIST SP 800-90A, no derivation function). Every buffer of
+ * PRNG_BUFFER_SIZE samples is one generate request: the 128-bit counter V is incremented before each block is
+ * encrypted, and the key and V are replaced afterwards, so earlier output cannot be recovered from the state.
+ * The blocks are encrypted with AES-NI when the CPU supports it (detected at runtime) and with a constant-time
+ * bitsliced implementation otherwise, which is several times slower than ChaCha20Engine. Select the engine with
+ * PseudoRandomNumberGenerator::InitPRNGEngine(PRNGEngineType::AESCTR).
+ */
+class AesCtrEngine : public PRNG {
+public:
+    enum {
+        KEY_SIZE = 8,
+        // seed material of the instantiation: a key and a counter (384 bits)
+        SEED_SIZE = 12,
+        // the buffer stores 4096 samples of 32-bit integers (1024 AES blocks)
+        PRNG_BUFFER_SIZE = 4096
+    };
+    using aesctr_key_array_t  = std::array<PRNG::result_type, KEY_SIZE>;
+    using aesctr_seed_array_t = std::array<PRNG::result_type, SEED_SIZE>;
+
+    /**
+     * @brief Constructor taking the internal state: the key and the counter V = nonce * 2^64 + counter. The first
+     *        block of keystream is the encryption of V + 1. The words of the key are read in little-endian order.
+     * @param useAESNI false selects the portable implementation even if the CPU supports AES-NI
+     */
+    AesCtrEngine(const aesctr_key_array_t& key, uint64_t nonce, uint64_t counter = 0, bool useAESNI = true);
+
+    /**
+     * @brief Instantiates the DRBG from the seed material, which must be full-entropy
+     * @param useAESNI false selects the portable implementation even if the CPU supports AES-NI
+     */
+    explicit AesCtrEngine(const aesctr_seed_array_t& seed, bool useAESNI = true);
+
+    ~AesCtrEngine();
+
+    /**
+     * @brief main call to the PRNG
+     */
+    PRNG::result_type operator()() override {
+        if (m_bufferIndex == static_cast<size_t>(PRNG_BUFFER_SIZE))
+            m_bufferIndex = 0;
+
+        // the keystream is generated only when the currently buffered values are all consumed
+        if (m_bufferIndex == 0)
+            Generate(m_buffer.data());
+
+        return m_buffer[m_bufferIndex++];
+    }
+
+    /**
+     * @brief Writes the next n samples to out. The samples are the same as the ones returned by n calls to
+     *        operator(), but whole buffers of keystream are written straight to out.
+     * @param out the destination; must have room for n samples
+     * @param n the number of samples
+     */
+    void Fill(PRNG::result_type* out, size_t n) override;
+
+    /**
+     * @brief Returns true if the blocks are encrypted with AES-NI
+     */
+    bool UsesAESNI() const {
+        return m_useAESNI;
+    }
+
+    /**
+     * @brief Returns true if the CPU the library is running on supports AES-NI
+     */
+    static bool IsAESNISupported();
+
+private:
+    /**
+     * @brief Writes PRNG_BUFFER_SIZE words of keystream to out, then updates the key and the counter
+     */
+    void Generate(PRNG::result_type* out);
+
+    /**
+     * @brief Increments the counter before each block and writes the encrypted counters to out
+     */
+    void Keystream(uint8_t* out, size_t blocks);
+
+    /**
+     * @brief CTR_DRBG_Update: replaces the key and the counter by the next 384 bits of keystream, XORed with
+     *        providedData if it is not nullptr
+     */
+    void Update(const uint8_t* providedData);
+
+    void SetKey(const uint8_t* key);
+
+    std::array<PRNG::result_type, PRNG_BUFFER_SIZE> m_buffer{};
+    size_t m_bufferIndex = 0;
+    // AES-256 round keys (15 round keys of 16 bytes)
+    std::array<uint8_t, 240> m_roundKeys{};
+    uint64_t m_counterHigh = 0;
+    uint64_t m_counterLow  = 0;
+    bool m_useAESNI        = false;
+};
+
+/**
+ * @brief createAesCtrEngineInstance() generates an AesCtrEngine object which is dynamically allocated.
+ *        The seed material is drawn from a freshly seeded Blake2Engine.
+ * @return pointer to the generated AesCtrEngine object
+ * @attention the caller is responsible for freeing the memory allocated by this function
+ **/
+extern "C" {
+PRNG* createAesCtrEngineInstance();
+}
+
+}  // namespace default_prng
+
+#endif
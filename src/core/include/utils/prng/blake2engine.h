@@ -73,7 +73,7 @@ class Blake2Engine : public PRNG {
         // makes a call to the BLAKE2 generator only when the currently buffered values are all consumed precomputations and
         // done only once for the current buffer
         if (m_bufferIndex == 0)
-            Generate();
+            Generate(m_buffer.data());
 
         PRNG::result_type result = m_buffer[m_bufferIndex];
         m_bufferIndex++;
@@ -81,11 +81,19 @@ class Blake2Engine : public PRNG {
         return result;
     }
 
+    /**
+     * @brief Writes the next n samples to out. The samples are the same as the ones returned by n calls to
+     *        operator(), but whole BLAKE2 blocks are written straight to out without going through the buffer.
+     * @param out the destination; must have room for n samples
+     * @param n the number of samples
+     */
+    void Fill(PRNG::result_type* out, size_t n) override;
+
  private:
     /**
-     * @brief The main call to blake2xb function
+     * @brief The main call to blake2xb function; writes PRNG_BUFFER_SIZE samples to out
      */
-    void Generate();
+    void Generate(PRNG::result_type* out);
 
     // The vector to store random samples generated using the hash function
     std::array<PRNG::result_type, PRNG_BUFFER_SIZE> m_buffer{};
@@ -0,0 +1,114 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2024, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+/*
+  PRNG engine based on the ChaCha20 stream cipher
+ */
+
+#ifndef __CHACHA20ENGINE_H__
+#define __CHACHA20ENGINE_H__
+
+#include "utils/prng/prng.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace default_prng {
+/**
+ * @brief PRNG engine producing the ChaCha20 keystream (20 rounds, 256-bit key, 64-bit nonce and 64-bit block
+ * counter). It is an alternative to Blake2Engine with a higher throughput; select it with
+ * PseudoRandomNumberGenerator::InitPRNGEngine(PRNGEngineType::CHACHA20).
+ */
+class ChaCha20Engine : public PRNG {
+public:
+    enum {
+        KEY_SIZE = 8,
+        // the buffer stores 4096 samples of 32-bit integers (256 ChaCha20 blocks)
+        PRNG_BUFFER_SIZE = 4096
+    };
+    using chacha20_key_array_t = std::array<PRNG::result_type, KEY_SIZE>;
+
+    /**
+     * @brief Main constructor taking the key, the nonce and the number of the first block
+     */
+    ChaCha20Engine(const chacha20_key_array_t& key, uint64_t nonce, uint64_t counter = 0)
+        : m_key(key), m_nonce(nonce), m_counter(counter) {}
+
+    ~ChaCha20Engine();
+
+    /**
+     * @brief main call to the PRNG
+     */
+    PRNG::result_type operator()() override {
+        if (m_bufferIndex == static_cast<size_t>(PRNG_BUFFER_SIZE))
+            m_bufferIndex = 0;
+
+        // the keystream is generated only when the currently buffered values are all consumed
+        if (m_bufferIndex == 0)
+            Generate(m_buffer.data());
+
+        return m_buffer[m_bufferIndex++];
+    }
+
+    /**
+     * @brief Writes the next n samples to out. The samples are the same as the ones returned by n calls to
+     *        operator(), but whole buffers of keystream are written straight to out.
+     * @param out the destination; must have room for n samples
+     * @param n the number of samples
+     */
+    void Fill(PRNG::result_type* out, size_t n) override;
+
+private:
+    /**
+     * @brief Writes PRNG_BUFFER_SIZE words of keystream to out and advances the block counter
+     */
+    void Generate(PRNG::result_type* out);
+
+    std::array<PRNG::result_type, PRNG_BUFFER_SIZE> m_buffer{};
+    size_t m_bufferIndex = 0;
+    chacha20_key_array_t m_key{};
+    uint64_t m_nonce   = 0;
+    uint64_t m_counter = 0;
+};
+
+/**
+ * @brief createChaCha20EngineInstance() generates a ChaCha20Engine object which is dynamically allocated.
+ *        The key and the nonce are drawn from a freshly seeded Blake2Engine.
+ * @return pointer to the generated ChaCha20Engine object
+ * @attention the caller is responsible for freeing the memory allocated by this function
+ **/
+extern "C" {
+PRNG* createChaCha20EngineInstance();
+}
+
+}  // namespace default_prng
+
+#endif
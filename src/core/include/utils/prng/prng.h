@@ -48,6 +48,7 @@
 #ifndef __PRNG_H__
 #define __PRNG_H__
 
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 
@@ -79,6 +80,18 @@ public:
     virtual result_type operator()() = 0;
     virtual ~PRNG()                  = default;
 
+    /**
+     * @brief Writes the next n samples to out; the samples are the same as the ones returned by n calls to
+     *        operator(). Engines that produce their output in blocks should override it to write whole blocks
+     *        straight to out
+     * @param out the destination; must have room for n samples
+     * @param n the number of samples
+     */
+    virtual void Fill(result_type* out, size_t n) {
+        for (size_t i = 0; i < n; ++i)
+            out[i] = (*this)();
+    }
+
 protected:
     PRNG() = default;
 };
@@ -67,6 +67,7 @@
 #include "cereal/archives/portable_binary.hpp"
 #include "cereal/archives/json.hpp"
 #include "cereal/cereal.hpp"
+#include "cereal/types/array.hpp"
 #include "cereal/types/map.hpp"
 #include "cereal/types/memory.hpp"
 #include "cereal/types/polymorphic.hpp"
@@ -136,6 +137,55 @@ bool DeserializeFromFile(const std::string& filename, T& obj, const SerType::SER
     return false;
 }
 
+//========================== COMPACT serialization ==========================
+/**
+		 * Serialize an object with the entries of native vectors bit-packed
+		 * @param obj - object to serialize
+		 * @param stream - Stream to serialize to
+		 * @param sertype - type of serialization
+		 */
+template <typename T>
+void Serialize(const T& obj, std::ostream& stream, const SerType::SERCOMPACT& st) {
+    SerType::CompactScope scope;
+    cereal::PortableBinaryOutputArchive archive(stream);
+    archive(obj);
+}
+
+/**
+		 * Deserialize an object serialized with SerType::COMPACT (every native vector records its layout,
+		 * so this reads SerType::BINARY streams as well)
+		 * @param obj - object to deserialize into
+		 * @param stream - Stream to deserialize from
+		 * @param sertype - type of de-serialization
+		 */
+template <typename T>
+void Deserialize(T& obj, std::istream& stream, const SerType::SERCOMPACT& st) {
+    cereal::PortableBinaryInputArchive archive(stream);
+    archive(obj);
+}
+
+template <typename T>
+bool SerializeToFile(const std::string& filename, const T& obj, const SerType::SERCOMPACT& sertype) {
+    std::ofstream file(filename, std::ios::out | std::ios::binary);
+    if (file.is_open()) {
+        Serial::Serialize(obj, file, sertype);
+        file.close();
+        return true;
+    }
+    return false;
+}
+
+template <typename T>
+bool DeserializeFromFile(const std::string& filename, T& obj, const SerType::SERCOMPACT& sertype) {
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    if (file.is_open()) {
+        Serial::Deserialize(obj, file, sertype);
+        file.close();
+        return true;
+    }
+    return false;
+}
+
 //========================== JSON serialization ==========================
 /**
 		 * Serialize an object
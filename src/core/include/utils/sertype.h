@@ -46,6 +46,38 @@ static const SERJSON JSON;  // should be const static to avoid compilation failu
 class SERBINARY {};
 static const SERBINARY BINARY;  // should be const static to avoid compilation failure
 
+// BINARY with the entries of native vectors bit-packed to the bit length of their modulus
+class SERCOMPACT {};
+static const SERCOMPACT COMPACT;  // should be const static to avoid compilation failure
+
+/**
+ * @brief Selects the bit-packed encoding of native vectors written to the binary archives by the calling
+ * thread while the scope is alive (used by Serial::Serialize with SerType::COMPACT). Every vector records its
+ * layout in the stream, so loading does not depend on the scope.
+ */
+class CompactScope {
+public:
+    CompactScope() : m_previous{Active()} {
+        Active() = true;
+    }
+
+    CompactScope(const CompactScope&)            = delete;
+    CompactScope& operator=(const CompactScope&) = delete;
+
+    ~CompactScope() {
+        Active() = m_previous;
+    }
+
+    static bool IsActive() {
+        return Active();
+    }
+
+private:
+    static bool& Active();
+
+    bool m_previous;
+};
+
 }  // namespace SerType
 
 }  // namespace lbcrypto
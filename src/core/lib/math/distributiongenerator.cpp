@@ -35,10 +35,14 @@
  */
 
 #include "math/distributiongenerator.h"
+#include "utils/prng/aesctrengine.h"
 #include "utils/prng/blake2engine.h"
+#include "utils/prng/chacha20engine.h"
 #include "utils/exception.h"
 
 #include <iostream>
+#include <type_traits>
+#include <utility>
 #if (defined(__linux__) || defined(__unix__)) && !defined(__APPLE__) && defined(__GNUC__) && !defined(__clang__)
     #include <dlfcn.h>
 #endif
@@ -47,6 +51,7 @@ namespace lbcrypto {
 
 std::shared_ptr<PRNG> PseudoRandomNumberGenerator::m_prng                                    = nullptr;
 PseudoRandomNumberGenerator::GenPRNGEngineFuncPtr PseudoRandomNumberGenerator::genPRNGEngine = nullptr;
+thread_local std::shared_ptr<PRNG> PseudoRandomNumberGenerator::t_scopedPRNG              = nullptr;
 
 void PseudoRandomNumberGenerator::InitPRNGEngine(const std::string& libPath) {
     if (genPRNGEngine)  // if genPRNGEngine has already been initialized
@@ -86,7 +91,29 @@ void PseudoRandomNumberGenerator::InitPRNGEngine(const std::string& libPath) {
     }
 }
 
+void PseudoRandomNumberGenerator::InitPRNGEngine(PRNGEngineType engine) {
+    if (genPRNGEngine)  // if genPRNGEngine has already been initialized
+        return;
+
+    switch (engine) {
+        case PRNGEngineType::BLAKE2:
+            genPRNGEngine = default_prng::createEngineInstance;
+            break;
+        case PRNGEngineType::CHACHA20:
+            genPRNGEngine = default_prng::createChaCha20EngineInstance;
+            break;
+        case PRNGEngineType::AESCTR:
+            genPRNGEngine = default_prng::createAesCtrEngineInstance;
+            break;
+        default:
+            OPENFHE_THROW("Unknown PRNG engine type");
+    }
+}
+
 PRNG& PseudoRandomNumberGenerator::GetPRNG() {
+    if (t_scopedPRNG)
+        return *t_scopedPRNG;
+
     // initialization of PRNGs
     if (m_prng == nullptr) {
 #pragma omp critical
@@ -105,4 +132,32 @@ PRNG& PseudoRandomNumberGenerator::GetPRNG() {
     return *m_prng;
 }
 
+PRNGSeed PseudoRandomNumberGenerator::GenerateSeed() {
+    PRNG& prng = GetPRNG();
+    PRNGSeed seed;
+    for (auto& s : seed)
+        s = prng();
+    return seed;
+}
+
+std::shared_ptr<PRNG> PseudoRandomNumberGenerator::CreateSeededPRNG(const PRNGSeed& seed, uint32_t stream) {
+    static_assert(std::is_same_v<PRNGSeed, default_prng::Blake2Engine::blake2_seed_array_t>,
+                  "PRNGSeed must match the seed of Blake2Engine");
+    return std::make_shared<default_prng::Blake2Engine>(seed, static_cast<uint64_t>(stream) << 32);
+}
+
+PseudoRandomNumberGenerator::ScopedPRNG::ScopedPRNG(std::shared_ptr<PRNG> prng) {
+    if (!prng)
+        OPENFHE_THROW("The PRNG engine is null");
+    m_prev = std::exchange(t_scopedPRNG, std::move(prng));
+}
+
+PseudoRandomNumberGenerator::ScopedPRNG::~ScopedPRNG() {
+    t_scopedPRNG = std::move(m_prev);
+}
+
+bool PseudoRandomNumberGenerator::HasScopedPRNG() {
+    return t_scopedPRNG != nullptr;
+}
+
 }  // namespace lbcrypto
@@ -0,0 +1,234 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  This code provides the thread-local pool allocator for the storage of native vectors
+ */
+
+#include "math/hal/intnat/mubintvecnat-alloc.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace intnat {
+
+#ifdef WITH_VECTOR_POOL
+
+namespace {
+
+// buffers of 2^POOL_MIN_CLASS bytes and more are pooled (smaller vectors are cheap to allocate)
+constexpr uint32_t POOL_MIN_CLASS = 10;
+constexpr uint32_t POOL_MAX_CLASS = 30;
+// maximum number of cached buffers per size class and thread
+constexpr uint32_t POOL_MAX_BUFFERS = 64;
+// maximum number of cached bytes per thread
+constexpr size_t POOL_MAX_BYTES = size_t(1) << 28;
+constexpr std::align_val_t POOL_ALIGNMENT{64};
+
+// Counters of one thread. Only the owning thread writes them, so an increment is a relaxed load and store
+// (no locked instruction, no shared cache line); the atomics only make the reads of GetNativeVectorPoolStats()
+// from other threads well defined.
+struct PoolCounters {
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> poolHits{0};
+    std::atomic<uint64_t> deallocations{0};
+    std::atomic<uint64_t> poolReturns{0};
+
+    static void Increment(std::atomic<uint64_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    void AddTo(NativeVectorPoolStats& stats) const {
+        stats.allocations += allocations.load(std::memory_order_relaxed);
+        stats.poolHits += poolHits.load(std::memory_order_relaxed);
+        stats.deallocations += deallocations.load(std::memory_order_relaxed);
+        stats.poolReturns += poolReturns.load(std::memory_order_relaxed);
+    }
+
+    void Reset() {
+        allocations.store(0, std::memory_order_relaxed);
+        poolHits.store(0, std::memory_order_relaxed);
+        deallocations.store(0, std::memory_order_relaxed);
+        poolReturns.store(0, std::memory_order_relaxed);
+    }
+};
+
+struct NativeVectorPool;
+
+// pools of the live threads and the counters of the threads that have exited; only touched when a thread
+// creates or destroys its pool and when the counters are read or reset
+struct PoolRegistry {
+    std::mutex mutex;
+    std::vector<NativeVectorPool*> pools;
+    NativeVectorPoolStats retired;
+};
+
+// never destroyed, so threads that exit during static destruction can still unregister
+PoolRegistry& GetPoolRegistry() {
+    static auto* registry = new PoolRegistry;
+    return *registry;
+}
+
+struct NativeVectorPool {
+    std::array<std::array<void*, POOL_MAX_BUFFERS>, POOL_MAX_CLASS + 1> buffers{};
+    std::array<uint32_t, POOL_MAX_CLASS + 1> counts{};
+    size_t bytes{0};
+    PoolCounters counters;
+
+    NativeVectorPool() {
+        auto& registry{GetPoolRegistry()};
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.pools.push_back(this);
+    }
+
+    void Release() {
+        for (uint32_t c = POOL_MIN_CLASS; c <= POOL_MAX_CLASS; ++c) {
+            for (uint32_t i = 0; i < counts[c]; ++i)
+                ::operator delete(buffers[c][i], POOL_ALIGNMENT);
+            counts[c] = 0;
+        }
+        bytes = 0;
+    }
+
+    ~NativeVectorPool();
+};
+
+// trivially destructible, so it can still be read after the pool of the thread is destroyed
+thread_local bool t_poolDestroyed{false};
+
+NativeVectorPool::~NativeVectorPool() {
+    Release();
+    {
+        auto& registry{GetPoolRegistry()};
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        counters.AddTo(registry.retired);
+        registry.pools.erase(std::find(registry.pools.begin(), registry.pools.end(), this));
+    }
+    t_poolDestroyed = true;
+}
+
+NativeVectorPool* GetThreadPool() {
+    if (t_poolDestroyed)
+        return nullptr;
+    static thread_local NativeVectorPool pool;
+    return &pool;
+}
+
+// smallest c such that bytes <= 2^c
+inline uint32_t SizeClass(size_t bytes) {
+    uint32_t c{0};
+    while ((size_t(1) << c) < bytes)
+        ++c;
+    return c;
+}
+
+}  // namespace
+
+void* NativeVectorPoolAllocate(size_t bytes) {
+    auto* pool{GetThreadPool()};
+    if (pool)
+        PoolCounters::Increment(pool->counters.allocations);
+    uint32_t c{SizeClass(bytes)};
+    if (c < POOL_MIN_CLASS || c > POOL_MAX_CLASS)
+        return ::operator new(bytes);
+    if (pool && pool->counts[c] > 0) {
+        PoolCounters::Increment(pool->counters.poolHits);
+        pool->bytes -= size_t(1) << c;
+        return pool->buffers[c][--pool->counts[c]];
+    }
+    return ::operator new(size_t(1) << c, POOL_ALIGNMENT);
+}
+
+void NativeVectorPoolDeallocate(void* p, size_t bytes) noexcept {
+    auto* pool{GetThreadPool()};
+    if (pool)
+        PoolCounters::Increment(pool->counters.deallocations);
+    uint32_t c{SizeClass(bytes)};
+    if (c < POOL_MIN_CLASS || c > POOL_MAX_CLASS) {
+        ::operator delete(p);
+        return;
+    }
+    if (pool && pool->counts[c] < POOL_MAX_BUFFERS && pool->bytes + (size_t(1) << c) <= POOL_MAX_BYTES) {
+        PoolCounters::Increment(pool->counters.poolReturns);
+        pool->bytes += size_t(1) << c;
+        pool->buffers[c][pool->counts[c]++] = p;
+        return;
+    }
+    ::operator delete(p, POOL_ALIGNMENT);
+}
+
+void ReleaseNativeVectorPool() {
+    if (auto* pool = GetThreadPool())
+        pool->Release();
+}
+
+NativeVectorPoolStats GetNativeVectorPoolStats() {
+    auto& registry{GetPoolRegistry()};
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    NativeVectorPoolStats stats{registry.retired};
+    for (const auto* pool : registry.pools)
+        pool->counters.AddTo(stats);
+    return stats;
+}
+
+void ResetNativeVectorPoolStats() {
+    auto& registry{GetPoolRegistry()};
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.retired = NativeVectorPoolStats();
+    for (auto* pool : registry.pools)
+        pool->counters.Reset();
+}
+
+#else
+
+void* NativeVectorPoolAllocate(size_t bytes) {
+    return ::operator new(bytes);
+}
+
+void NativeVectorPoolDeallocate(void* p, size_t bytes) noexcept {
+    ::operator delete(p);
+}
+
+void ReleaseNativeVectorPool() {}
+
+NativeVectorPoolStats GetNativeVectorPoolStats() {
+    return NativeVectorPoolStats();
+}
+
+void ResetNativeVectorPoolStats() {}
+
+#endif
+
+}  // namespace intnat
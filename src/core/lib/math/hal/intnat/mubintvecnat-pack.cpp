@@ -0,0 +1,89 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  This code provides the bit-packing of native vector entries used by the compact serialization
+ */
+
+#include "math/hal/intnat/mubintvecnat-pack.h"
+
+#include <algorithm>
+
+namespace intnat {
+
+// Both loops stream whole 64-bit words, so every entry costs one shift/or pair and at most one extra word access
+
+void PackBits(const uint64_t* in, size_t n, uint32_t bits, uint64_t* out) {
+    if (bits >= 64) {
+        std::copy(in, in + n, out);
+        return;
+    }
+    uint64_t acc{0};
+    uint32_t used{0};
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t v{in[i]};
+        acc |= v << used;
+        used += bits;
+        if (used >= 64) {
+            *out++ = acc;
+            used -= 64;
+            // the high bits of v that did not fit into the word just written
+            acc = (used > 0) ? v >> (bits - used) : 0;
+        }
+    }
+    if (used > 0)
+        *out = acc;
+}
+
+void UnpackBits(const uint64_t* in, size_t n, uint32_t bits, uint64_t* out) {
+    if (bits >= 64) {
+        std::copy(in, in + n, out);
+        return;
+    }
+    const uint64_t mask{(uint64_t(1) << bits) - 1};
+    uint64_t acc{0};
+    uint32_t avail{0};
+    for (size_t i = 0; i < n; ++i) {
+        if (avail >= bits) {
+            out[i] = acc & mask;
+            acc >>= bits;
+            avail -= bits;
+        }
+        else {
+            uint64_t w{*in++};
+            out[i] = (acc | (w << avail)) & mask;
+            acc    = w >> (bits - avail);
+            avail += 64 - bits;
+        }
+    }
+}
+
+}  // namespace intnat
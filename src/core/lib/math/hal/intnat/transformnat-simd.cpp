@@ -0,0 +1,693 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  This code provides the AVX2 and AVX-512 IFMA kernels for the native negacyclic NTT and their runtime dispatch
+ */
+
+#include "math/hal/intnat/transformnat-simd.h"
+#include "math/hal/intnat/ubintnat.h"
+
+#include "utils/exception.h"
+
+#include <atomic>
+#include <ostream>
+
+// The kernels are compiled with function-level target attributes, so the library itself does not need to be
+// built with -mavx2/-mavx512ifma and still runs on CPUs without these extensions.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(__EMSCRIPTEN__)
+    #define OPENFHE_NTT_X86_KERNELS
+    #include <immintrin.h>
+#endif
+
+namespace intnat {
+
+namespace {
+
+#ifdef OPENFHE_NTT_X86_KERNELS
+
+    // GCC reports the _mm512_undefined_epi32() placeholders inside the AVX-512 intrinsics as uninitialized
+    #if defined(__GNUC__) && !defined(__clang__)
+        #pragma GCC diagnostic push
+        #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    #endif
+
+    #define OPENFHE_TARGET_AVX2       __attribute__((target("avx2")))
+    #define OPENFHE_TARGET_AVX512IFMA __attribute__((target("avx512f,avx512ifma")))
+
+// AVX2 compares are signed, so all values in [0, 2q) have to fit in 63 bits
+constexpr uint64_t AVX2_MODULUS_BOUND = uint64_t(1) << 62;
+// Shoup's reduction with 52-bit products leaves values in [0, 2q), which must stay below 2^52
+constexpr uint64_t IFMA_MODULUS_BOUND = uint64_t(1) << 50;
+constexpr uint64_t IFMA_MASK          = (uint64_t(1) << 52) - 1;
+
+// Returns omega[bitreversed(1)] * (n inverse) and its Shoup precomputation (used in the final stage of the INTT)
+std::pair<uint64_t, uint64_t> FinalStageOmega(const uint64_t* rootOfUnityInverseTable, uint64_t cycloOrderInv,
+                                              uint64_t preconCycloOrderInv, uint64_t modulus) {
+    NativeIntegerT<uint64_t> q{modulus};
+    auto omega1Inv{NativeIntegerT<uint64_t>(rootOfUnityInverseTable[1])
+                       .ModMulFastConst(cycloOrderInv, q, NativeIntegerT<uint64_t>(preconCycloOrderInv))};
+    return {omega1Inv.ConvertToInt(), omega1Inv.PrepModMulConst(q).ConvertToInt()};
+}
+
+//=================================== AVX2 ===================================
+
+// high 64 bits of the 128-bit products, assembled from four 32x32-bit partial products
+OPENFHE_TARGET_AVX2 inline __m256i MulHiAVX2(__m256i x, __m256i y) {
+    const __m256i lo32{_mm256_set1_epi64x(0xFFFFFFFF)};
+    __m256i xh{_mm256_srli_epi64(x, 32)};
+    __m256i yh{_mm256_srli_epi64(y, 32)};
+    __m256i ll{_mm256_mul_epu32(x, y)};
+    __m256i lh{_mm256_mul_epu32(x, yh)};
+    __m256i hl{_mm256_mul_epu32(xh, y)};
+    __m256i hh{_mm256_mul_epu32(xh, yh)};
+    __m256i mid{_mm256_add_epi64(_mm256_srli_epi64(ll, 32), _mm256_and_si256(lh, lo32))};
+    mid = _mm256_add_epi64(mid, _mm256_and_si256(hl, lo32));
+    hh  = _mm256_add_epi64(hh, _mm256_srli_epi64(lh, 32));
+    hh  = _mm256_add_epi64(hh, _mm256_srli_epi64(hl, 32));
+    return _mm256_add_epi64(hh, _mm256_srli_epi64(mid, 32));
+}
+
+// low 64 bits of the 128-bit products
+OPENFHE_TARGET_AVX2 inline __m256i MulLoAVX2(__m256i x, __m256i y) {
+    __m256i cross{_mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(x, 32), y),
+                                   _mm256_mul_epu32(x, _mm256_srli_epi64(y, 32)))};
+    return _mm256_add_epi64(_mm256_mul_epu32(x, y), _mm256_slli_epi64(cross, 32));
+}
+
+// selects b in the lanes where the sign bit of mask is set and a elsewhere
+OPENFHE_TARGET_AVX2 inline __m256i BlendAVX2(__m256i a, __m256i b, __m256i mask) {
+    return _mm256_castpd_si256(
+        _mm256_blendv_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _mm256_castsi256_pd(mask)));
+}
+
+// [0, 2q) -> [0, q)
+OPENFHE_TARGET_AVX2 inline __m256i ReduceOnceAVX2(__m256i a, __m256i q) {
+    __m256i d{_mm256_sub_epi64(a, q)};
+    return BlendAVX2(d, a, d);
+}
+
+OPENFHE_TARGET_AVX2 inline __m256i ModAddAVX2(__m256i a, __m256i b, __m256i q) {
+    return ReduceOnceAVX2(_mm256_add_epi64(a, b), q);
+}
+
+OPENFHE_TARGET_AVX2 inline __m256i ModSubAVX2(__m256i a, __m256i b, __m256i q) {
+    __m256i d{_mm256_sub_epi64(a, b)};
+    return BlendAVX2(d, _mm256_add_epi64(d, q), d);
+}
+
+// Shoup's modular multiplication by a constant w with precomputation wp = floor(w * 2^64 / q)
+OPENFHE_TARGET_AVX2 inline __m256i ModMulFastConstAVX2(__m256i x, __m256i w, __m256i wp, __m256i q) {
+    __m256i r{_mm256_sub_epi64(MulLoAVX2(x, w), MulLoAVX2(MulHiAVX2(x, wp), q))};
+    return ReduceOnceAVX2(r, q);
+}
+
+// Cooley-Tukey butterfly: (lo, hi) -> (lo + hi*w, lo - hi*w)
+OPENFHE_TARGET_AVX2 inline void ButterflyCTAVX2(__m256i& lo, __m256i& hi, __m256i w, __m256i wp, __m256i q) {
+    __m256i omegaFactor{ModMulFastConstAVX2(hi, w, wp, q)};
+    hi = ModSubAVX2(lo, omegaFactor, q);
+    lo = ModAddAVX2(lo, omegaFactor, q);
+}
+
+// Gentleman-Sande butterfly: (lo, hi) -> (lo + hi, (lo - hi)*w)
+OPENFHE_TARGET_AVX2 inline void ButterflyGSAVX2(__m256i& lo, __m256i& hi, __m256i w, __m256i wp, __m256i q) {
+    __m256i diff{ModSubAVX2(lo, hi, q)};
+    lo = ModAddAVX2(lo, hi, q);
+    hi = ModMulFastConstAVX2(diff, w, wp, q);
+}
+
+    #define LOADU256(p)     _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))
+    #define STOREU256(p, v) _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v)
+
+// Loads the twiddles of two consecutive butterfly groups as [w0, w0, w1, w1] (stage t = 2)
+OPENFHE_TARGET_AVX2 inline __m256i LoadPairAVX2(const uint64_t* p) {
+    return _mm256_permute4x64_epi64(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))),
+                                    0x50);
+}
+
+// Loads the twiddles of four consecutive butterfly groups as [w0, w2, w1, w3] (stage t = 1)
+OPENFHE_TARGET_AVX2 inline __m256i LoadQuadAVX2(const uint64_t* p) {
+    return _mm256_permute4x64_epi64(LOADU256(p), 0xD8);
+}
+
+// Butterflies (lo[j], hi[j]), j in [0, len), sharing one twiddle; len is a multiple of 4
+template <bool Forward>
+OPENFHE_TARGET_AVX2 inline void ButterflyRunAVX2(__m256i w, __m256i wp, __m256i q, uint32_t len, uint64_t* lo,
+                                                 uint64_t* hi) {
+    for (uint32_t j{0}; j < len; j += 4) {
+        __m256i x{LOADU256(lo + j)};
+        __m256i y{LOADU256(hi + j)};
+        if (Forward)
+            ButterflyCTAVX2(x, y, w, wp, q);
+        else
+            ButterflyGSAVX2(x, y, w, wp, q);
+        STOREU256(lo + j, x);
+        STOREU256(hi + j, y);
+    }
+}
+
+// Final INTT stage: omega already includes (n inverse), lo is scaled by (n inverse) separately
+OPENFHE_TARGET_AVX2 inline void FinalButterflyRunAVX2(__m256i w, __m256i wp, __m256i nInv, __m256i nInvp, __m256i q,
+                                                      uint32_t len, uint64_t* lo, uint64_t* hi) {
+    for (uint32_t j{0}; j < len; j += 4) {
+        __m256i x{LOADU256(lo + j)};
+        __m256i y{LOADU256(hi + j)};
+        ButterflyGSAVX2(x, y, w, wp, q);
+        STOREU256(lo + j, ModMulFastConstAVX2(x, nInv, nInvp, q));
+        STOREU256(hi + j, y);
+    }
+}
+
+// Entry points of the runs for the dispatch code, which is not compiled for AVX2
+template <bool Forward>
+OPENFHE_TARGET_AVX2 void ButterflyRunAVX2(uint64_t omega, uint64_t preconOmega, uint64_t modulus, uint32_t len,
+                                          uint64_t* lo, uint64_t* hi) {
+    ButterflyRunAVX2<Forward>(_mm256_set1_epi64x(omega), _mm256_set1_epi64x(preconOmega), _mm256_set1_epi64x(modulus),
+                              len, lo, hi);
+}
+
+OPENFHE_TARGET_AVX2 void FinalButterflyRunAVX2(uint64_t omega1Inv, uint64_t preconOmega1Inv, uint64_t cycloOrderInv,
+                                               uint64_t preconCycloOrderInv, uint64_t modulus, uint32_t len,
+                                               uint64_t* lo, uint64_t* hi) {
+    FinalButterflyRunAVX2(_mm256_set1_epi64x(omega1Inv), _mm256_set1_epi64x(preconOmega1Inv),
+                          _mm256_set1_epi64x(cycloOrderInv), _mm256_set1_epi64x(preconCycloOrderInv),
+                          _mm256_set1_epi64x(modulus), len, lo, hi);
+}
+
+// Runs the NTT stages with m >= blocks restricted to the butterfly groups of one block, i.e., to the coefficients
+// [block * n / blocks, (block + 1) * n / blocks). blocks = 1 is the complete transform.
+OPENFHE_TARGET_AVX2 void ForwardTransformAVX2(const uint64_t* rootOfUnityTable, const uint64_t* preconRootOfUnityTable,
+                                              uint64_t modulus, uint32_t n, uint32_t blocks, uint32_t block,
+                                              uint64_t* element) {
+    const __m256i q{_mm256_set1_epi64x(modulus)};
+    uint32_t m{blocks};
+    for (uint32_t t{n / (blocks << 1)}; t >= 4; m <<= 1, t >>= 1) {
+        for (uint32_t i{block * (m / blocks)}, i1{i + m / blocks}; i < i1; ++i) {
+            uint64_t* x{element + (i << 1) * t};
+            ButterflyRunAVX2<true>(_mm256_set1_epi64x(rootOfUnityTable[i + m]),
+                                   _mm256_set1_epi64x(preconRootOfUnityTable[i + m]), q, t, x, x + t);
+        }
+    }
+    // t = 2: every 8 coefficients hold two butterfly groups; swap 128-bit halves to separate lo and hi
+    for (uint32_t i{block * (m / blocks)}, i1{i + m / blocks}; i < i1; i += 2) {
+        uint64_t* x{element + (i << 2)};
+        __m256i a{LOADU256(x)};
+        __m256i b{LOADU256(x + 4)};
+        __m256i lo{_mm256_permute2x128_si256(a, b, 0x20)};
+        __m256i hi{_mm256_permute2x128_si256(a, b, 0x31)};
+        ButterflyCTAVX2(lo, hi, LoadPairAVX2(rootOfUnityTable + m + i), LoadPairAVX2(preconRootOfUnityTable + m + i),
+                        q);
+        STOREU256(x, _mm256_permute2x128_si256(lo, hi, 0x20));
+        STOREU256(x + 4, _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+    m <<= 1;
+    // t = 1: even/odd coefficients form the butterflies; unpack yields the groups in [0, 2, 1, 3] order
+    for (uint32_t i{block * (m / blocks)}, i1{i + m / blocks}; i < i1; i += 4) {
+        uint64_t* x{element + (i << 1)};
+        __m256i a{LOADU256(x)};
+        __m256i b{LOADU256(x + 4)};
+        __m256i lo{_mm256_unpacklo_epi64(a, b)};
+        __m256i hi{_mm256_unpackhi_epi64(a, b)};
+        ButterflyCTAVX2(lo, hi, LoadQuadAVX2(rootOfUnityTable + m + i), LoadQuadAVX2(preconRootOfUnityTable + m + i),
+                        q);
+        STOREU256(x, _mm256_unpacklo_epi64(lo, hi));
+        STOREU256(x + 4, _mm256_unpackhi_epi64(lo, hi));
+    }
+}
+
+// Runs the INTT stages with m >= blocks restricted to one block (see ForwardTransformAVX2); the final stage and
+// the scaling by (n inverse) are only applied for blocks = 1
+OPENFHE_TARGET_AVX2 void InverseTransformAVX2(const uint64_t* rootOfUnityInverseTable,
+                                              const uint64_t* preconRootOfUnityInverseTable, uint64_t cycloOrderInv,
+                                              uint64_t preconCycloOrderInv, uint64_t modulus, uint32_t n,
+                                              uint32_t blocks, uint32_t block, uint64_t* element) {
+    const __m256i q{_mm256_set1_epi64x(modulus)};
+    uint32_t m{n >> 1};
+    // t = 1
+    for (uint32_t i{block * (m / blocks)}, i1{i + m / blocks}; i < i1; i += 4) {
+        uint64_t* x{element + (i << 1)};
+        __m256i a{LOADU256(x)};
+        __m256i b{LOADU256(x + 4)};
+        __m256i lo{_mm256_unpacklo_epi64(a, b)};
+        __m256i hi{_mm256_unpackhi_epi64(a, b)};
+        ButterflyGSAVX2(lo, hi, LoadQuadAVX2(rootOfUnityInverseTable + m + i),
+                        LoadQuadAVX2(preconRootOfUnityInverseTable + m + i), q);
+        STOREU256(x, _mm256_unpacklo_epi64(lo, hi));
+        STOREU256(x + 4, _mm256_unpackhi_epi64(lo, hi));
+    }
+    m >>= 1;
+    // t = 2
+    for (uint32_t i{block * (m / blocks)}, i1{i + m / blocks}; i < i1; i += 2) {
+        uint64_t* x{element + (i << 2)};
+        __m256i a{LOADU256(x)};
+        __m256i b{LOADU256(x + 4)};
+        __m256i lo{_mm256_permute2x128_si256(a, b, 0x20)};
+        __m256i hi{_mm256_permute2x128_si256(a, b, 0x31)};
+        ButterflyGSAVX2(lo, hi, LoadPairAVX2(rootOfUnityInverseTable + m + i),
+                        LoadPairAVX2(preconRootOfUnityInverseTable + m + i), q);
+        STOREU256(x, _mm256_permute2x128_si256(lo, hi, 0x20));
+        STOREU256(x + 4, _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+    m >>= 1;
+    // inner stages
+    const uint32_t mEnd{blocks > 1 ? blocks : 2};
+    for (uint32_t t{4}; m >= mEnd; m >>= 1, t <<= 1) {
+        for (uint32_t i{block * (m / blocks)}, i1{i + m / blocks}; i < i1; ++i) {
+            uint64_t* x{element + (i << 1) * t};
+            ButterflyRunAVX2<false>(_mm256_set1_epi64x(rootOfUnityInverseTable[i + m]),
+                                    _mm256_set1_epi64x(preconRootOfUnityInverseTable[i + m]), q, t, x, x + t);
+        }
+    }
+    if (blocks > 1)
+        return;
+    // final stage with the multiplication by (n inverse) folded into the twiddle
+    auto [omega1Inv, preconOmega1Inv] =
+        FinalStageOmega(rootOfUnityInverseTable, cycloOrderInv, preconCycloOrderInv, modulus);
+    FinalButterflyRunAVX2(_mm256_set1_epi64x(omega1Inv), _mm256_set1_epi64x(preconOmega1Inv),
+                          _mm256_set1_epi64x(cycloOrderInv), _mm256_set1_epi64x(preconCycloOrderInv), q, n >> 1,
+                          element, element + (n >> 1));
+}
+
+//=============================== AVX-512 IFMA ===============================
+
+// Shoup's modular multiplication with 52-bit limbs: wp = floor(w * 2^52 / q), x and w below 2^52
+OPENFHE_TARGET_AVX512IFMA inline __m512i ModMulFastConstIFMA(__m512i x, __m512i w, __m512i wp, __m512i q) {
+    const __m512i zero{_mm512_setzero_si512()};
+    __m512i quot{_mm512_madd52hi_epu64(zero, x, wp)};
+    __m512i r{_mm512_sub_epi64(_mm512_madd52lo_epu64(zero, x, w), _mm512_madd52lo_epu64(zero, quot, q))};
+    r = _mm512_and_si512(r, _mm512_set1_epi64(IFMA_MASK));
+    return _mm512_min_epu64(r, _mm512_sub_epi64(r, q));
+}
+
+OPENFHE_TARGET_AVX512IFMA inline __m512i ModAddIFMA(__m512i a, __m512i b, __m512i q) {
+    __m512i s{_mm512_add_epi64(a, b)};
+    return _mm512_min_epu64(s, _mm512_sub_epi64(s, q));
+}
+
+OPENFHE_TARGET_AVX512IFMA inline __m512i ModSubIFMA(__m512i a, __m512i b, __m512i q) {
+    __m512i d{_mm512_sub_epi64(a, b)};
+    return _mm512_min_epu64(d, _mm512_add_epi64(d, q));
+}
+
+OPENFHE_TARGET_AVX512IFMA inline void ButterflyCTIFMA(__m512i& lo, __m512i& hi, __m512i w, __m512i wp, __m512i q) {
+    __m512i omegaFactor{ModMulFastConstIFMA(hi, w, wp, q)};
+    hi = ModSubIFMA(lo, omegaFactor, q);
+    lo = ModAddIFMA(lo, omegaFactor, q);
+}
+
+OPENFHE_TARGET_AVX512IFMA inline void ButterflyGSIFMA(__m512i& lo, __m512i& hi, __m512i w, __m512i wp, __m512i q) {
+    __m512i diff{ModSubIFMA(lo, hi, q)};
+    lo = ModAddIFMA(lo, hi, q);
+    hi = ModMulFastConstIFMA(diff, w, wp, q);
+}
+
+// the 64-bit Shoup precomputations are converted to 52-bit ones on the fly: floor(wp64 / 2^12) = floor(w * 2^52 / q)
+    #define PRECON52(x) ((x) >> 12)
+
+    #define LOADU512(p)     _mm512_loadu_si512(reinterpret_cast<const void*>(p))
+    #define STOREU512(p, v) _mm512_storeu_si512(reinterpret_cast<void*>(p), v)
+
+// Lane permutations for the stages with t < 8: every 16 consecutive coefficients (registers a and b) hold 8/t
+// butterfly groups. "split" gathers the lo/hi halves, "merge" scatters them back and "omega" replicates the
+// twiddle of each group over its t lanes.
+struct ShortStageIFMA {
+    uint64_t splitLo[8];
+    uint64_t splitHi[8];
+    uint64_t mergeA[8];
+    uint64_t mergeB[8];
+    uint64_t omega[8];
+};
+
+constexpr ShortStageIFMA SHORT_STAGE_T4{{0, 1, 2, 3, 8, 9, 10, 11},
+                                        {4, 5, 6, 7, 12, 13, 14, 15},
+                                        {0, 1, 2, 3, 8, 9, 10, 11},
+                                        {4, 5, 6, 7, 12, 13, 14, 15},
+                                        {0, 0, 0, 0, 1, 1, 1, 1}};
+constexpr ShortStageIFMA SHORT_STAGE_T2{{0, 1, 4, 5, 8, 9, 12, 13},
+                                        {2, 3, 6, 7, 10, 11, 14, 15},
+                                        {0, 1, 8, 9, 2, 3, 10, 11},
+                                        {4, 5, 12, 13, 6, 7, 14, 15},
+                                        {0, 0, 1, 1, 2, 2, 3, 3}};
+constexpr ShortStageIFMA SHORT_STAGE_T1{{0, 2, 4, 6, 8, 10, 12, 14},
+                                        {1, 3, 5, 7, 9, 11, 13, 15},
+                                        {0, 8, 1, 9, 2, 10, 3, 11},
+                                        {4, 12, 5, 13, 6, 14, 7, 15},
+                                        {0, 1, 2, 3, 4, 5, 6, 7}};
+
+template <bool Forward>
+OPENFHE_TARGET_AVX512IFMA inline void ShortStageTransformIFMA(const ShortStageIFMA& perm, uint32_t t,
+                                                              const uint64_t* table, const uint64_t* preconTable,
+                                                              uint32_t m, uint32_t iBegin, uint32_t iEnd, __m512i q,
+                                                              uint64_t* element) {
+    const __m512i splitLo{LOADU512(perm.splitLo)};
+    const __m512i splitHi{LOADU512(perm.splitHi)};
+    const __m512i mergeA{LOADU512(perm.mergeA)};
+    const __m512i mergeB{LOADU512(perm.mergeB)};
+    const __m512i omegaIdx{LOADU512(perm.omega)};
+    const uint32_t groups{8 / t};
+    const __mmask8 groupMask = static_cast<__mmask8>((1u << groups) - 1);
+    for (uint32_t i{iBegin}; i < iEnd; i += groups) {
+        uint64_t* x{element + (i << 1) * t};
+        __m512i a{LOADU512(x)};
+        __m512i b{LOADU512(x + 8)};
+        __m512i lo{_mm512_permutex2var_epi64(a, splitLo, b)};
+        __m512i hi{_mm512_permutex2var_epi64(a, splitHi, b)};
+        __m512i w{_mm512_permutexvar_epi64(omegaIdx, _mm512_maskz_loadu_epi64(groupMask, table + m + i))};
+        __m512i wp{_mm512_permutexvar_epi64(omegaIdx, _mm512_maskz_loadu_epi64(groupMask, preconTable + m + i))};
+        wp = _mm512_srli_epi64(wp, 12);
+        if (Forward)
+            ButterflyCTIFMA(lo, hi, w, wp, q);
+        else
+            ButterflyGSIFMA(lo, hi, w, wp, q);
+        STOREU512(x, _mm512_permutex2var_epi64(lo, mergeA, hi));
+        STOREU512(x + 8, _mm512_permutex2var_epi64(lo, mergeB, hi));
+    }
+}
+
+// Butterflies (lo[j], hi[j]), j in [0, len), sharing one twiddle; len is a multiple of 8
+template <bool Forward>
+OPENFHE_TARGET_AVX512IFMA inline void ButterflyRunIFMA(__m512i w, __m512i wp, __m512i q, uint32_t len, uint64_t* lo,
+                                                       uint64_t* hi) {
+    for (uint32_t j{0}; j < len; j += 8) {
+        __m512i x{LOADU512(lo + j)};
+        __m512i y{LOADU512(hi + j)};
+        if (Forward)
+            ButterflyCTIFMA(x, y, w, wp, q);
+        else
+            ButterflyGSIFMA(x, y, w, wp, q);
+        STOREU512(lo + j, x);
+        STOREU512(hi + j, y);
+    }
+}
+
+// Final INTT stage: omega already includes (n inverse), lo is scaled by (n inverse) separately
+OPENFHE_TARGET_AVX512IFMA inline void FinalButterflyRunIFMA(__m512i w, __m512i wp, __m512i nInv, __m512i nInvp,
+                                                            __m512i q, uint32_t len, uint64_t* lo, uint64_t* hi) {
+    for (uint32_t j{0}; j < len; j += 8) {
+        __m512i x{LOADU512(lo + j)};
+        __m512i y{LOADU512(hi + j)};
+        ButterflyGSIFMA(x, y, w, wp, q);
+        STOREU512(lo + j, ModMulFastConstIFMA(x, nInv, nInvp, q));
+        STOREU512(hi + j, y);
+    }
+}
+
+// Entry points of the runs for the dispatch code, which is not compiled for AVX-512
+template <bool Forward>
+OPENFHE_TARGET_AVX512IFMA void ButterflyRunIFMA(uint64_t omega, uint64_t preconOmega, uint64_t modulus, uint32_t len,
+                                                uint64_t* lo, uint64_t* hi) {
+    ButterflyRunIFMA<Forward>(_mm512_set1_epi64(omega), _mm512_set1_epi64(PRECON52(preconOmega)),
+                              _mm512_set1_epi64(modulus), len, lo, hi);
+}
+
+OPENFHE_TARGET_AVX512IFMA void FinalButterflyRunIFMA(uint64_t omega1Inv, uint64_t preconOmega1Inv,
+                                                     uint64_t cycloOrderInv, uint64_t preconCycloOrderInv,
+                                                     uint64_t modulus, uint32_t len, uint64_t* lo, uint64_t* hi) {
+    FinalButterflyRunIFMA(_mm512_set1_epi64(omega1Inv), _mm512_set1_epi64(PRECON52(preconOmega1Inv)),
+                          _mm512_set1_epi64(cycloOrderInv), _mm512_set1_epi64(PRECON52(preconCycloOrderInv)),
+                          _mm512_set1_epi64(modulus), len, lo, hi);
+}
+
+// Same block decomposition as ForwardTransformAVX2
+OPENFHE_TARGET_AVX512IFMA void ForwardTransformIFMA(const uint64_t* rootOfUnityTable,
+                                                    const uint64_t* preconRootOfUnityTable, uint64_t modulus,
+                                                    uint32_t n, uint32_t blocks, uint32_t block, uint64_t* element) {
+    const __m512i q{_mm512_set1_epi64(modulus)};
+    uint32_t m{blocks};
+    for (uint32_t t{n / (blocks << 1)}; t >= 8; m <<= 1, t >>= 1) {
+        for (uint32_t i{block * (m / blocks)}, i1{i + m / blocks}; i < i1; ++i) {
+            uint64_t* x{element + (i << 1) * t};
+            ButterflyRunIFMA<true>(_mm512_set1_epi64(rootOfUnityTable[i + m]),
+                                   _mm512_set1_epi64(PRECON52(preconRootOfUnityTable[i + m])), q, t, x, x + t);
+        }
+    }
+    const uint32_t span{m / blocks};
+    ShortStageTransformIFMA<true>(SHORT_STAGE_T4, 4, rootOfUnityTable, preconRootOfUnityTable, m, block * span,
+                                  (block + 1) * span, q, element);
+    ShortStageTransformIFMA<true>(SHORT_STAGE_T2, 2, rootOfUnityTable, preconRootOfUnityTable, m << 1,
+                                  (block * span) << 1, ((block + 1) * span) << 1, q, element);
+    ShortStageTransformIFMA<true>(SHORT_STAGE_T1, 1, rootOfUnityTable, preconRootOfUnityTable, m << 2,
+                                  (block * span) << 2, ((block + 1) * span) << 2, q, element);
+}
+
+// Same block decomposition as InverseTransformAVX2
+OPENFHE_TARGET_AVX512IFMA void InverseTransformIFMA(const uint64_t* rootOfUnityInverseTable,
+                                                    const uint64_t* preconRootOfUnityInverseTable,
+                                                    uint64_t cycloOrderInv, uint64_t preconCycloOrderInv,
+                                                    uint64_t modulus, uint32_t n, uint32_t blocks, uint32_t block,
+                                                    uint64_t* element) {
+    const __m512i q{_mm512_set1_epi64(modulus)};
+    uint32_t m{n >> 1};
+    const uint32_t span{m / blocks};
+    ShortStageTransformIFMA<false>(SHORT_STAGE_T1, 1, rootOfUnityInverseTable, preconRootOfUnityInverseTable, m,
+                                   block * span, (block + 1) * span, q, element);
+    ShortStageTransformIFMA<false>(SHORT_STAGE_T2, 2, rootOfUnityInverseTable, preconRootOfUnityInverseTable, m >> 1,
+                                   (block * span) >> 1, ((block + 1) * span) >> 1, q, element);
+    ShortStageTransformIFMA<false>(SHORT_STAGE_T4, 4, rootOfUnityInverseTable, preconRootOfUnityInverseTable, m >> 2,
+                                   (block * span) >> 2, ((block + 1) * span) >> 2, q, element);
+    m >>= 3;
+    // inner stages
+    const uint32_t mEnd{blocks > 1 ? blocks : 2};
+    for (uint32_t t{8}; m >= mEnd; m >>= 1, t <<= 1) {
+        for (uint32_t i{block * (m / blocks)}, i1{i + m / blocks}; i < i1; ++i) {
+            uint64_t* x{element + (i << 1) * t};
+            ButterflyRunIFMA<false>(_mm512_set1_epi64(rootOfUnityInverseTable[i + m]),
+                                    _mm512_set1_epi64(PRECON52(preconRootOfUnityInverseTable[i + m])), q, t, x,
+                                    x + t);
+        }
+    }
+    if (blocks > 1)
+        return;
+    // final stage with the multiplication by (n inverse) folded into the twiddle
+    auto [omega1Inv, preconOmega1Inv] =
+        FinalStageOmega(rootOfUnityInverseTable, cycloOrderInv, preconCycloOrderInv, modulus);
+    FinalButterflyRunIFMA(_mm512_set1_epi64(omega1Inv), _mm512_set1_epi64(PRECON52(preconOmega1Inv)),
+                          _mm512_set1_epi64(cycloOrderInv), _mm512_set1_epi64(PRECON52(preconCycloOrderInv)), q,
+                          n >> 1, element, element + (n >> 1));
+}
+
+// Returns the kernel to use for a call that processes the given number of coefficients (a power of two or a
+// multiple of the vector width) modulo modulus
+NTTKernelType ApplicableNTTKernel(uint64_t modulus, uint32_t coefficients) {
+    switch (GetNTTKernelType()) {
+        case NTT_KERNEL_AVX512IFMA:
+            if (coefficients >= 16 && coefficients % 16 == 0 && modulus < IFMA_MODULUS_BOUND)
+                return NTT_KERNEL_AVX512IFMA;
+            // wider moduli are handled by the AVX2 kernel
+            [[fallthrough]];
+        case NTT_KERNEL_AVX2:
+            if (coefficients >= 8 && coefficients % 8 == 0 && modulus < AVX2_MODULUS_BOUND)
+                return NTT_KERNEL_AVX2;
+            break;
+        default:
+            break;
+    }
+    return NTT_KERNEL_SCALAR;
+}
+
+    #if defined(__GNUC__) && !defined(__clang__)
+        #pragma GCC diagnostic pop
+    #endif
+
+#endif  // OPENFHE_NTT_X86_KERNELS
+
+NTTKernelType DetectNTTKernelType() {
+#ifdef OPENFHE_NTT_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512ifma"))
+        return NTT_KERNEL_AVX512IFMA;
+    if (__builtin_cpu_supports("avx2"))
+        return NTT_KERNEL_AVX2;
+#endif
+    return NTT_KERNEL_SCALAR;
+}
+
+std::atomic<NTTKernelType>& SelectedNTTKernelType() {
+    static std::atomic<NTTKernelType> selected{GetSupportedNTTKernelType()};
+    return selected;
+}
+
+}  // namespace
+
+std::ostream& operator<<(std::ostream& s, NTTKernelType t) {
+    switch (t) {
+        case NTT_KERNEL_SCALAR:
+            s << "SCALAR";
+            break;
+        case NTT_KERNEL_AVX2:
+            s << "AVX2";
+            break;
+        case NTT_KERNEL_AVX512IFMA:
+            s << "AVX512IFMA";
+            break;
+        default:
+            s << "UNKNOWN";
+            break;
+    }
+    return s;
+}
+
+NTTKernelType GetSupportedNTTKernelType() {
+    static const NTTKernelType supported{DetectNTTKernelType()};
+    return supported;
+}
+
+NTTKernelType GetNTTKernelType() {
+    return SelectedNTTKernelType().load(std::memory_order_relaxed);
+}
+
+void SetNTTKernelType(NTTKernelType type) {
+    if (type < NTT_KERNEL_SCALAR || type > GetSupportedNTTKernelType())
+        OPENFHE_THROW("The requested NTT kernel is not supported on this CPU");
+    SelectedNTTKernelType().store(type, std::memory_order_relaxed);
+}
+
+bool ForwardTransformToBitReverseInPlaceSIMD(const uint64_t* rootOfUnityTable, const uint64_t* preconRootOfUnityTable,
+                                             uint64_t modulus, uint32_t n, uint64_t* element) {
+    return ForwardTransformToBitReverseBlockSIMD(rootOfUnityTable, preconRootOfUnityTable, modulus, n, 1, 0, element);
+}
+
+bool InverseTransformFromBitReverseInPlaceSIMD(const uint64_t* rootOfUnityInverseTable,
+                                               const uint64_t* preconRootOfUnityInverseTable, uint64_t cycloOrderInv,
+                                               uint64_t preconCycloOrderInv, uint64_t modulus, uint32_t n,
+                                               uint64_t* element) {
+#ifdef OPENFHE_NTT_X86_KERNELS
+    switch (ApplicableNTTKernel(modulus, n)) {
+        case NTT_KERNEL_AVX512IFMA:
+            InverseTransformIFMA(rootOfUnityInverseTable, preconRootOfUnityInverseTable, cycloOrderInv,
+                                 preconCycloOrderInv, modulus, n, 1, 0, element);
+            return true;
+        case NTT_KERNEL_AVX2:
+            InverseTransformAVX2(rootOfUnityInverseTable, preconRootOfUnityInverseTable, cycloOrderInv,
+                                 preconCycloOrderInv, modulus, n, 1, 0, element);
+            return true;
+        default:
+            break;
+    }
+#endif
+    return false;
+}
+
+bool ForwardTransformToBitReverseBlockSIMD(const uint64_t* rootOfUnityTable, const uint64_t* preconRootOfUnityTable,
+                                           uint64_t modulus, uint32_t n, uint32_t blocks, uint32_t block,
+                                           uint64_t* element) {
+#ifdef OPENFHE_NTT_X86_KERNELS
+    switch (ApplicableNTTKernel(modulus, n / blocks)) {
+        case NTT_KERNEL_AVX512IFMA:
+            ForwardTransformIFMA(rootOfUnityTable, preconRootOfUnityTable, modulus, n, blocks, block, element);
+            return true;
+        case NTT_KERNEL_AVX2:
+            ForwardTransformAVX2(rootOfUnityTable, preconRootOfUnityTable, modulus, n, blocks, block, element);
+            return true;
+        default:
+            break;
+    }
+#endif
+    return false;
+}
+
+bool InverseTransformFromBitReverseBlockSIMD(const uint64_t* rootOfUnityInverseTable,
+                                             const uint64_t* preconRootOfUnityInverseTable, uint64_t modulus,
+                                             uint32_t n, uint32_t blocks, uint32_t block, uint64_t* element) {
+#ifdef OPENFHE_NTT_X86_KERNELS
+    if (blocks < 2)
+        return false;
+    switch (ApplicableNTTKernel(modulus, n / blocks)) {
+        case NTT_KERNEL_AVX512IFMA:
+            InverseTransformIFMA(rootOfUnityInverseTable, preconRootOfUnityInverseTable, 0, 0, modulus, n, blocks,
+                                 block, element);
+            return true;
+        case NTT_KERNEL_AVX2:
+            InverseTransformAVX2(rootOfUnityInverseTable, preconRootOfUnityInverseTable, 0, 0, modulus, n, blocks,
+                                 block, element);
+            return true;
+        default:
+            break;
+    }
+#endif
+    return false;
+}
+
+bool ForwardButterflyRunSIMD(uint64_t omega, uint64_t preconOmega, uint64_t modulus, uint32_t len, uint64_t* lo,
+                             uint64_t* hi) {
+#ifdef OPENFHE_NTT_X86_KERNELS
+    switch (ApplicableNTTKernel(modulus, len << 1)) {
+        case NTT_KERNEL_AVX512IFMA:
+            ButterflyRunIFMA<true>(omega, preconOmega, modulus, len, lo, hi);
+            return true;
+        case NTT_KERNEL_AVX2:
+            ButterflyRunAVX2<true>(omega, preconOmega, modulus, len, lo, hi);
+            return true;
+        default:
+            break;
+    }
+#endif
+    return false;
+}
+
+bool InverseButterflyRunSIMD(uint64_t omega, uint64_t preconOmega, uint64_t modulus, uint32_t len, uint64_t* lo,
+                             uint64_t* hi) {
+#ifdef OPENFHE_NTT_X86_KERNELS
+    switch (ApplicableNTTKernel(modulus, len << 1)) {
+        case NTT_KERNEL_AVX512IFMA:
+            ButterflyRunIFMA<false>(omega, preconOmega, modulus, len, lo, hi);
+            return true;
+        case NTT_KERNEL_AVX2:
+            ButterflyRunAVX2<false>(omega, preconOmega, modulus, len, lo, hi);
+            return true;
+        default:
+            break;
+    }
+#endif
+    return false;
+}
+
+bool InverseFinalButterflyRunSIMD(uint64_t omega1Inv, uint64_t preconOmega1Inv, uint64_t cycloOrderInv,
+                                  uint64_t preconCycloOrderInv, uint64_t modulus, uint32_t len, uint64_t* lo,
+                                  uint64_t* hi) {
+#ifdef OPENFHE_NTT_X86_KERNELS
+    switch (ApplicableNTTKernel(modulus, len << 1)) {
+        case NTT_KERNEL_AVX512IFMA:
+            FinalButterflyRunIFMA(omega1Inv, preconOmega1Inv, cycloOrderInv, preconCycloOrderInv, modulus, len, lo,
+                                  hi);
+            return true;
+        case NTT_KERNEL_AVX2:
+            FinalButterflyRunAVX2(omega1Inv, preconOmega1Inv, cycloOrderInv, preconCycloOrderInv, modulus, len, lo,
+                                  hi);
+            return true;
+        default:
+            break;
+    }
+#endif
+    return false;
+}
+
+}  // namespace intnat
@@ -0,0 +1,563 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2024, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+#include "utils/prng/aesctrengine.h"
+#include "utils/prng/blake2engine.h"
+#include "utils/memory.h"
+
+#include <algorithm>
+#include <memory>
+
+// The AES-NI kernel is compiled with a function-level target attribute, so the library itself does not need to be
+// built with -maes and still runs on CPUs without AES-NI.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(__EMSCRIPTEN__)
+    #define OPENFHE_AESNI_KERNEL
+    #include <immintrin.h>
+#endif
+
+namespace default_prng {
+
+namespace {
+
+constexpr size_t AES_BLOCK_SIZE = 16;
+constexpr size_t AES_ROUNDS     = 14;
+
+//============================== portable (bitsliced) ==============================
+
+// The portable kernel encrypts 4 blocks at a time without secret-dependent table lookups or branches. The state
+// is bitsliced: bit b of byte i of block k is bit 16 * k + i of q[b]. Byte i is in row i % 4 and column i / 4.
+constexpr size_t BITSLICE_BLOCKS = 4;
+
+// Boyar-Peralta circuit of the AES S-box (q[0] holds the least significant bits)
+void SubBytesBitsliced(uint64_t* q) {
+    const uint64_t x0 = q[7], x1 = q[6], x2 = q[5], x3 = q[4], x4 = q[3], x5 = q[2], x6 = q[1], x7 = q[0];
+
+    // top linear transformation
+    const uint64_t y14 = x3 ^ x5;
+    const uint64_t y13 = x0 ^ x6;
+    const uint64_t y9  = x0 ^ x3;
+    const uint64_t y8  = x0 ^ x5;
+    const uint64_t t0  = x1 ^ x2;
+    const uint64_t y1  = t0 ^ x7;
+    const uint64_t y4  = y1 ^ x3;
+    const uint64_t y12 = y13 ^ y14;
+    const uint64_t y2  = y1 ^ x0;
+    const uint64_t y5  = y1 ^ x6;
+    const uint64_t y3  = y5 ^ y8;
+    const uint64_t t1  = x4 ^ y12;
+    const uint64_t y15 = t1 ^ x5;
+    const uint64_t y20 = t1 ^ x1;
+    const uint64_t y6  = y15 ^ x7;
+    const uint64_t y10 = y15 ^ t0;
+    const uint64_t y11 = y20 ^ y9;
+    const uint64_t y7  = x7 ^ y11;
+    const uint64_t y17 = y10 ^ y11;
+    const uint64_t y19 = y10 ^ y8;
+    const uint64_t y16 = t0 ^ y11;
+    const uint64_t y21 = y13 ^ y16;
+    const uint64_t y18 = x0 ^ y16;
+
+    // non-linear section
+    const uint64_t t2  = y12 & y15;
+    const uint64_t t3  = y3 & y6;
+    const uint64_t t4  = t3 ^ t2;
+    const uint64_t t5  = y4 & x7;
+    const uint64_t t6  = t5 ^ t2;
+    const uint64_t t7  = y13 & y16;
+    const uint64_t t8  = y5 & y1;
+    const uint64_t t9  = t8 ^ t7;
+    const uint64_t t10 = y2 & y7;
+    const uint64_t t11 = t10 ^ t7;
+    const uint64_t t12 = y9 & y11;
+    const uint64_t t13 = y14 & y17;
+    const uint64_t t14 = t13 ^ t12;
+    const uint64_t t15 = y8 & y10;
+    const uint64_t t16 = t15 ^ t12;
+    const uint64_t t17 = t4 ^ t14;
+    const uint64_t t18 = t6 ^ t16;
+    const uint64_t t19 = t9 ^ t14;
+    const uint64_t t20 = t11 ^ t16;
+    const uint64_t t21 = t17 ^ y20;
+    const uint64_t t22 = t18 ^ y19;
+    const uint64_t t23 = t19 ^ y21;
+    const uint64_t t24 = t20 ^ y18;
+
+    const uint64_t t25 = t21 ^ t22;
+    const uint64_t t26 = t21 & t23;
+    const uint64_t t27 = t24 ^ t26;
+    const uint64_t t28 = t25 & t27;
+    const uint64_t t29 = t28 ^ t22;
+    const uint64_t t30 = t23 ^ t24;
+    const uint64_t t31 = t22 ^ t26;
+    const uint64_t t32 = t31 & t30;
+    const uint64_t t33 = t32 ^ t24;
+    const uint64_t t34 = t23 ^ t33;
+    const uint64_t t35 = t27 ^ t33;
+    const uint64_t t36 = t24 & t35;
+    const uint64_t t37 = t36 ^ t34;
+    const uint64_t t38 = t27 ^ t36;
+    const uint64_t t39 = t29 & t38;
+    const uint64_t t40 = t25 ^ t39;
+
+    const uint64_t t41 = t40 ^ t37;
+    const uint64_t t42 = t29 ^ t33;
+    const uint64_t t43 = t29 ^ t40;
+    const uint64_t t44 = t33 ^ t37;
+    const uint64_t t45 = t42 ^ t41;
+    const uint64_t z0  = t44 & y15;
+    const uint64_t z1  = t37 & y6;
+    const uint64_t z2  = t33 & x7;
+    const uint64_t z3  = t43 & y16;
+    const uint64_t z4  = t40 & y1;
+    const uint64_t z5  = t29 & y7;
+    const uint64_t z6  = t42 & y11;
+    const uint64_t z7  = t45 & y17;
+    const uint64_t z8  = t41 & y10;
+    const uint64_t z9  = t44 & y12;
+    const uint64_t z10 = t37 & y3;
+    const uint64_t z11 = t33 & y4;
+    const uint64_t z12 = t43 & y13;
+    const uint64_t z13 = t40 & y5;
+    const uint64_t z14 = t29 & y2;
+    const uint64_t z15 = t42 & y9;
+    const uint64_t z16 = t45 & y14;
+    const uint64_t z17 = t41 & y8;
+
+    // bottom linear transformation
+    const uint64_t t46 = z15 ^ z16;
+    const uint64_t t47 = z10 ^ z11;
+    const uint64_t t48 = z5 ^ z13;
+    const uint64_t t49 = z9 ^ z10;
+    const uint64_t t50 = z2 ^ z12;
+    const uint64_t t51 = z2 ^ z5;
+    const uint64_t t52 = z7 ^ z8;
+    const uint64_t t53 = z0 ^ z3;
+    const uint64_t t54 = z6 ^ z7;
+    const uint64_t t55 = z16 ^ z17;
+    const uint64_t t56 = z12 ^ t48;
+    const uint64_t t57 = t50 ^ t53;
+    const uint64_t t58 = z4 ^ t46;
+    const uint64_t t59 = z3 ^ t54;
+    const uint64_t t60 = t46 ^ t57;
+    const uint64_t t61 = z14 ^ t57;
+    const uint64_t t62 = t52 ^ t58;
+    const uint64_t t63 = t49 ^ t58;
+    const uint64_t t64 = z4 ^ t59;
+    const uint64_t t65 = t61 ^ t62;
+    const uint64_t t66 = z1 ^ t63;
+    const uint64_t s0  = t59 ^ t63;
+    const uint64_t s6  = t56 ^ ~t62;
+    const uint64_t s7  = t48 ^ ~t60;
+    const uint64_t t67 = t64 ^ t65;
+    const uint64_t s3  = t53 ^ t66;
+    const uint64_t s4  = t51 ^ t66;
+    const uint64_t s5  = t47 ^ t65;
+    const uint64_t s1  = t64 ^ ~s3;
+    const uint64_t s2  = t55 ^ ~t67;
+
+    q[7] = s0;
+    q[6] = s1;
+    q[5] = s2;
+    q[4] = s3;
+    q[3] = s4;
+    q[2] = s5;
+    q[1] = s6;
+    q[0] = s7;
+}
+
+// the given 16-bit pattern in each of the 4 blocks
+constexpr uint64_t PerBlock(uint64_t pattern) {
+    return pattern * 0x0001000100010001;
+}
+
+// rotates the bits of each block right by s
+inline uint64_t RotateBlocksRight(uint64_t x, uint32_t s) {
+    return ((x >> s) & PerBlock((uint64_t(1) << (16 - s)) - 1)) |
+           ((x << (16 - s)) & PerBlock(0xFFFF ^ ((uint64_t(1) << (16 - s)) - 1)));
+}
+
+// row r moves r columns to the left: byte r + 4c takes byte r + 4(c + r)
+inline uint64_t ShiftRowsBitsliced(uint64_t x) {
+    return (x & PerBlock(0x1111)) | RotateBlocksRight(x & PerBlock(0x2222), 4) |
+           RotateBlocksRight(x & PerBlock(0x4444), 8) | RotateBlocksRight(x & PerBlock(0x8888), 12);
+}
+
+// byte r of each column takes byte (r + k) % 4 of the column
+inline uint64_t RotateColumns1(uint64_t x) {
+    return ((x >> 1) & PerBlock(0x7777)) | ((x << 3) & PerBlock(0x8888));
+}
+inline uint64_t RotateColumns2(uint64_t x) {
+    return ((x >> 2) & PerBlock(0x3333)) | ((x << 2) & PerBlock(0xCCCC));
+}
+inline uint64_t RotateColumns3(uint64_t x) {
+    return ((x >> 3) & PerBlock(0x1111)) | ((x << 1) & PerBlock(0xEEEE));
+}
+
+// b_r = 2 a_r + 3 a_(r+1) + a_(r+2) + a_(r+3) = 2 (a_r + a_(r+1)) + a_(r+1) + a_(r+2) + a_(r+3)
+void MixColumnsBitsliced(uint64_t* q) {
+    uint64_t sum[8], rest[8];
+    for (size_t b = 0; b < 8; ++b) {
+        const uint64_t r1 = RotateColumns1(q[b]);
+        sum[b]            = q[b] ^ r1;
+        rest[b]           = r1 ^ RotateColumns2(q[b]) ^ RotateColumns3(q[b]);
+    }
+    // multiplication of sum by x modulo x^8 + x^4 + x^3 + x + 1
+    q[0] = sum[7] ^ rest[0];
+    q[1] = sum[0] ^ sum[7] ^ rest[1];
+    q[2] = sum[1] ^ rest[2];
+    q[3] = sum[2] ^ sum[7] ^ rest[3];
+    q[4] = sum[3] ^ sum[7] ^ rest[4];
+    q[5] = sum[4] ^ rest[5];
+    q[6] = sum[5] ^ rest[6];
+    q[7] = sum[6] ^ rest[7];
+}
+
+// transposes the 8x8 bit matrix whose rows are the bytes of x
+inline uint64_t Transpose8x8(uint64_t x) {
+    uint64_t t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AA;
+    x ^= t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCC;
+    x ^= t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0;
+    x ^= t ^ (t << 28);
+    return x;
+}
+
+// bytes[j] becomes bit j of the planes q[0..7]
+void Bitslice(const uint8_t* bytes, uint64_t* q) {
+    std::fill_n(q, 8, 0);
+    for (size_t j = 0; j < 64; j += 8) {
+        uint64_t x = 0;
+        for (size_t k = 0; k < 8; ++k)
+            x |= uint64_t(bytes[j + k]) << (8 * k);
+        x = Transpose8x8(x);
+        for (size_t b = 0; b < 8; ++b)
+            q[b] |= ((x >> (8 * b)) & 0xFF) << j;
+    }
+}
+
+void Unbitslice(const uint64_t* q, uint8_t* bytes) {
+    for (size_t j = 0; j < 64; j += 8) {
+        uint64_t x = 0;
+        for (size_t b = 0; b < 8; ++b)
+            x |= ((q[b] >> j) & 0xFF) << (8 * b);
+        x = Transpose8x8(x);
+        for (size_t k = 0; k < 8; ++k)
+            bytes[j + k] = static_cast<uint8_t>(x >> (8 * k));
+    }
+}
+
+void EncryptBlocksPortable(const uint8_t* roundKeys, uint8_t* data, size_t blocks) {
+    // the round keys are bitsliced once and repeated for the 4 blocks
+    uint64_t keys[AES_ROUNDS + 1][8];
+    uint8_t keyBytes[BITSLICE_BLOCKS * AES_BLOCK_SIZE];
+    for (size_t r = 0; r <= AES_ROUNDS; ++r) {
+        for (size_t k = 0; k < BITSLICE_BLOCKS; ++k)
+            std::copy_n(roundKeys + r * AES_BLOCK_SIZE, AES_BLOCK_SIZE, keyBytes + k * AES_BLOCK_SIZE);
+        Bitslice(keyBytes, keys[r]);
+    }
+
+    uint8_t group[BITSLICE_BLOCKS * AES_BLOCK_SIZE];
+    for (size_t i = 0; i < blocks; i += BITSLICE_BLOCKS) {
+        // a partial last group is padded with zero blocks that are not written back
+        const size_t bytes = std::min(BITSLICE_BLOCKS, blocks - i) * AES_BLOCK_SIZE;
+        std::fill(std::copy_n(data + i * AES_BLOCK_SIZE, bytes, group), group + sizeof(group), 0);
+
+        uint64_t q[8];
+        Bitslice(group, q);
+        for (size_t b = 0; b < 8; ++b)
+            q[b] ^= keys[0][b];
+        for (size_t r = 1; r <= AES_ROUNDS; ++r) {
+            SubBytesBitsliced(q);
+            for (size_t b = 0; b < 8; ++b)
+                q[b] = ShiftRowsBitsliced(q[b]);
+            if (r != AES_ROUNDS)
+                MixColumnsBitsliced(q);
+            for (size_t b = 0; b < 8; ++b)
+                q[b] ^= keys[r][b];
+        }
+        Unbitslice(q, group);
+        std::copy_n(group, bytes, data + i * AES_BLOCK_SIZE);
+    }
+
+    // IMPORTANT: clear the round keys and the keystream for security reasons
+    lbcrypto::secure_memset(keys, 0, sizeof(keys));
+    lbcrypto::secure_memset(keyBytes, 0, sizeof(keyBytes));
+    lbcrypto::secure_memset(group, 0, sizeof(group));
+}
+
+// S-box of each of the 4 bytes of a word of the key schedule
+void SubWord(uint8_t* word) {
+    uint8_t bytes[64] = {};
+    std::copy_n(word, 4, bytes);
+    uint64_t q[8];
+    Bitslice(bytes, q);
+    SubBytesBitsliced(q);
+    Unbitslice(q, bytes);
+    std::copy_n(bytes, 4, word);
+    lbcrypto::secure_memset(bytes, 0, sizeof(bytes));
+    lbcrypto::secure_memset(q, 0, sizeof(q));
+}
+
+// AES-256 key expansion (FIPS 197, section 5.2)
+void ExpandKey(const uint8_t* key, uint8_t* roundKeys) {
+    constexpr size_t keyWords = 8;
+    constexpr size_t words    = 4 * (AES_ROUNDS + 1);
+    std::copy_n(key, 4 * keyWords, roundKeys);
+    uint8_t rcon = 0x01;
+    for (size_t i = keyWords; i < words; ++i) {
+        uint8_t temp[4];
+        std::copy_n(roundKeys + 4 * (i - 1), 4, temp);
+        if (i % keyWords == 0) {
+            std::rotate(temp, temp + 1, temp + 4);
+            SubWord(temp);
+            temp[0] ^= rcon;
+            rcon = static_cast<uint8_t>((rcon << 1) ^ ((rcon >> 7) * 0x1B));
+        }
+        else if (i % keyWords == 4) {
+            SubWord(temp);
+        }
+        for (size_t k = 0; k < 4; ++k)
+            roundKeys[4 * i + k] = roundKeys[4 * (i - keyWords) + k] ^ temp[k];
+        lbcrypto::secure_memset(temp, 0, sizeof(temp));
+    }
+}
+
+//===================================== AES-NI =====================================
+
+#ifdef OPENFHE_AESNI_KERNEL
+
+    #define OPENFHE_TARGET_AESNI __attribute__((target("aes")))
+
+OPENFHE_TARGET_AESNI void EncryptBlocksAESNI(const uint8_t* roundKeys, uint8_t* data, size_t blocks) {
+    __m128i keys[AES_ROUNDS + 1];
+    for (size_t r = 0; r <= AES_ROUNDS; ++r)
+        keys[r] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(roundKeys + r * AES_BLOCK_SIZE));
+
+    // 8 independent blocks hide the latency of aesenc
+    constexpr size_t lanes = 8;
+    size_t i               = 0;
+    for (; i + lanes <= blocks; i += lanes) {
+        __m128i x[lanes];
+        for (size_t l = 0; l < lanes; ++l)
+            x[l] = _mm_xor_si128(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + (i + l) * AES_BLOCK_SIZE)), keys[0]);
+        for (size_t r = 1; r < AES_ROUNDS; ++r) {
+            for (size_t l = 0; l < lanes; ++l)
+                x[l] = _mm_aesenc_si128(x[l], keys[r]);
+        }
+        for (size_t l = 0; l < lanes; ++l)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(data + (i + l) * AES_BLOCK_SIZE),
+                             _mm_aesenclast_si128(x[l], keys[AES_ROUNDS]));
+    }
+    for (; i < blocks; ++i) {
+        __m128i x = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * AES_BLOCK_SIZE)),
+                                  keys[0]);
+        for (size_t r = 1; r < AES_ROUNDS; ++r)
+            x = _mm_aesenc_si128(x, keys[r]);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i * AES_BLOCK_SIZE),
+                         _mm_aesenclast_si128(x, keys[AES_ROUNDS]));
+    }
+
+    // IMPORTANT: clear the round keys for security reasons
+    lbcrypto::secure_memset(keys, 0, sizeof(keys));
+}
+
+#endif  // OPENFHE_AESNI_KERNEL
+
+bool DetectAESNI() {
+#ifdef OPENFHE_AESNI_KERNEL
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("aes");
+#else
+    return false;
+#endif
+}
+
+void EncryptBlocks([[maybe_unused]] bool useAESNI, const uint8_t* roundKeys, uint8_t* data, size_t blocks) {
+#ifdef OPENFHE_AESNI_KERNEL
+    if (useAESNI) {
+        EncryptBlocksAESNI(roundKeys, data, blocks);
+        return;
+    }
+#endif
+    EncryptBlocksPortable(roundKeys, data, blocks);
+}
+
+void StoreBigEndian(uint64_t v, uint8_t* out) {
+    for (size_t k = 0; k < 8; ++k)
+        out[k] = static_cast<uint8_t>(v >> (56 - 8 * k));
+}
+
+uint64_t LoadBigEndian(const uint8_t* in) {
+    uint64_t v = 0;
+    for (size_t k = 0; k < 8; ++k)
+        v = (v << 8) | in[k];
+    return v;
+}
+
+// seedlen of CTR_DRBG with AES-256: the key and the counter
+constexpr size_t SEED_BYTES = 48;
+
+}  // namespace
+
+bool AesCtrEngine::IsAESNISupported() {
+    static const bool supported{DetectAESNI()};
+    return supported;
+}
+
+AesCtrEngine::AesCtrEngine(const aesctr_key_array_t& key, uint64_t nonce, uint64_t counter, bool useAESNI)
+    : m_counterHigh(nonce), m_counterLow(counter), m_useAESNI(useAESNI && IsAESNISupported()) {
+    uint8_t keyBytes[4 * KEY_SIZE];
+    for (size_t i = 0; i < KEY_SIZE; ++i) {
+        for (size_t k = 0; k < 4; ++k)
+            keyBytes[4 * i + k] = static_cast<uint8_t>(key[i] >> (8 * k));
+    }
+    SetKey(keyBytes);
+    lbcrypto::secure_memset(keyBytes, 0, sizeof(keyBytes));
+}
+
+AesCtrEngine::AesCtrEngine(const aesctr_seed_array_t& seed, bool useAESNI)
+    : m_useAESNI(useAESNI && IsAESNISupported()) {
+    // CTR_DRBG_Instantiate without derivation function: Update(seed material) from a zero key and counter
+    uint8_t seedBytes[SEED_BYTES];
+    for (size_t i = 0; i < SEED_SIZE; ++i) {
+        for (size_t k = 0; k < 4; ++k)
+            seedBytes[4 * i + k] = static_cast<uint8_t>(seed[i] >> (8 * k));
+    }
+    const uint8_t zeroKey[4 * KEY_SIZE] = {};
+    SetKey(zeroKey);
+    Update(seedBytes);
+    lbcrypto::secure_memset(seedBytes, 0, sizeof(seedBytes));
+}
+
+AesCtrEngine::~AesCtrEngine() {
+    // IMPORTANT: clear the key, the counter and the keystream for security reasons
+    lbcrypto::secure_memset(m_roundKeys.data(), 0, m_roundKeys.size());
+    lbcrypto::secure_memset(m_buffer.data(), 0, m_buffer.size() * sizeof(m_buffer[0]));
+    lbcrypto::secure_memset(&m_counterHigh, 0, sizeof(m_counterHigh));
+    lbcrypto::secure_memset(&m_counterLow, 0, sizeof(m_counterLow));
+}
+
+void AesCtrEngine::SetKey(const uint8_t* key) {
+    ExpandKey(key, m_roundKeys.data());
+}
+
+void AesCtrEngine::Keystream(uint8_t* out, size_t blocks) {
+    for (size_t i = 0; i < blocks; ++i) {
+        if (++m_counterLow == 0)
+            ++m_counterHigh;
+        StoreBigEndian(m_counterHigh, out + i * AES_BLOCK_SIZE);
+        StoreBigEndian(m_counterLow, out + i * AES_BLOCK_SIZE + 8);
+    }
+    EncryptBlocks(m_useAESNI, m_roundKeys.data(), out, blocks);
+}
+
+void AesCtrEngine::Update(const uint8_t* providedData) {
+    constexpr size_t blocks = SEED_BYTES / AES_BLOCK_SIZE;
+    uint8_t temp[SEED_BYTES];
+    Keystream(temp, blocks);
+    if (providedData != nullptr) {
+        for (size_t i = 0; i < SEED_BYTES; ++i)
+            temp[i] ^= providedData[i];
+    }
+    SetKey(temp);
+    m_counterHigh = LoadBigEndian(temp + 32);
+    m_counterLow  = LoadBigEndian(temp + 40);
+    lbcrypto::secure_memset(temp, 0, sizeof(temp));
+}
+
+void AesCtrEngine::Generate(PRNG::result_type* out) {
+    // the keystream is produced in chunks and read as little-endian words
+    constexpr size_t chunkBlocks = 64;
+    constexpr size_t chunkWords  = chunkBlocks * AES_BLOCK_SIZE / sizeof(PRNG::result_type);
+    static_assert(PRNG_BUFFER_SIZE % chunkWords == 0, "the buffer must hold a multiple of chunkBlocks blocks");
+
+    uint8_t chunk[chunkBlocks * AES_BLOCK_SIZE];
+    for (size_t w = 0; w < PRNG_BUFFER_SIZE; w += chunkWords) {
+        Keystream(chunk, chunkBlocks);
+        for (size_t i = 0; i < chunkWords; ++i) {
+            const uint8_t* b = chunk + sizeof(PRNG::result_type) * i;
+            out[w + i] = PRNG::result_type(b[0]) | (PRNG::result_type(b[1]) << 8) | (PRNG::result_type(b[2]) << 16) |
+                         (PRNG::result_type(b[3]) << 24);
+        }
+    }
+    lbcrypto::secure_memset(chunk, 0, sizeof(chunk));
+
+    // every buffer is one generate request of 16 KiB, which is below the limit of 64 KiB per request. The
+    // reseed interval of 2^48 requests cannot be reached, so the engine is never reseeded
+    Update(nullptr);
+}
+
+void AesCtrEngine::Fill(PRNG::result_type* out, size_t n) {
+    constexpr size_t bufferSize = static_cast<size_t>(PRNG_BUFFER_SIZE);
+
+    // samples still buffered from a previous call come first. m_bufferIndex == 0 means that the buffer has not
+    // been generated yet, m_bufferIndex == bufferSize that it has been consumed
+    if (m_bufferIndex != 0 && m_bufferIndex != bufferSize) {
+        const size_t count = std::min(n, bufferSize - m_bufferIndex);
+        std::copy_n(m_buffer.begin() + m_bufferIndex, count, out);
+        m_bufferIndex += count;
+        out += count;
+        n -= count;
+    }
+
+    for (; n >= bufferSize; n -= bufferSize, out += bufferSize) {
+        Generate(out);
+        m_bufferIndex = bufferSize;
+    }
+
+    if (n > 0) {
+        Generate(m_buffer.data());
+        std::copy_n(m_buffer.begin(), n, out);
+        m_bufferIndex = n;
+    }
+}
+
+extern "C" {
+
+PRNG* createAesCtrEngineInstance() {
+    // the seed material comes from the built-in BLAKE2 engine, which gathers a fresh 512-bit seed
+    std::unique_ptr<PRNG> seeder(createEngineInstance());
+
+    AesCtrEngine::aesctr_seed_array_t seed{};
+    for (auto& s : seed)
+        s = (*seeder)();
+
+    PRNG* ptr = new AesCtrEngine(seed);
+
+    // IMPORTANT: re-init seed for security reasons
+    lbcrypto::secure_memset(seed.data(), 0, seed.size() * sizeof(seed[0]));
+
+    return ptr;
+}
+}
+
+}  // namespace default_prng
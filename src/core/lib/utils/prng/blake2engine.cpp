@@ -33,6 +33,7 @@
 #include "utils/exception.h"
 #include "utils/memory.h"
 
+#include <algorithm>
 #include <chrono>
 #include <random>
 #include <thread>
@@ -45,16 +46,41 @@ Blake2Engine::~Blake2Engine() {
     lbcrypto::secure_memset(m_seed.data(), 0, bytes_to_clear);
 }
 
-void Blake2Engine::Generate() {
+void Blake2Engine::Generate(PRNG::result_type* out) {
     // m_counter is the input to the hash function
-    // m_buffer is the output
-    if (blake2xb(m_buffer.begin(), m_buffer.size() * sizeof(PRNG::result_type), &m_counter, sizeof(m_counter),
-                 m_seed.cbegin(), m_seed.size() * sizeof(PRNG::result_type)) != 0) {
+    // out (m_buffer or the caller's memory) is the output
+    if (blake2xb(out, PRNG_BUFFER_SIZE * sizeof(PRNG::result_type), &m_counter, sizeof(m_counter), m_seed.cbegin(),
+                 m_seed.size() * sizeof(PRNG::result_type)) != 0) {
         OPENFHE_THROW("PRNG: blake2xb failed");
     }
     m_counter++;
 }
 
+void Blake2Engine::Fill(PRNG::result_type* out, size_t n) {
+    constexpr size_t blockSize = static_cast<size_t>(PRNG_BUFFER_SIZE);
+
+    // samples still buffered from a previous call come first. m_bufferIndex == 0 means that the buffer has not
+    // been generated yet, m_bufferIndex == blockSize that it has been consumed
+    if (m_bufferIndex != 0 && m_bufferIndex != blockSize) {
+        const size_t count = std::min(n, blockSize - m_bufferIndex);
+        std::copy_n(m_buffer.begin() + m_bufferIndex, count, out);
+        m_bufferIndex += count;
+        out += count;
+        n -= count;
+    }
+
+    for (; n >= blockSize; n -= blockSize, out += blockSize) {
+        Generate(out);
+        m_bufferIndex = blockSize;
+    }
+
+    if (n > 0) {
+        Generate(m_buffer.data());
+        std::copy_n(m_buffer.begin(), n, out);
+        m_bufferIndex = n;
+    }
+}
+
 extern "C" {
 // if FIXED_SEED is defined, then PRNG uses a fixed seed number for reproducible results during debug.
 // Use only one OMP thread to ensure reproducibility
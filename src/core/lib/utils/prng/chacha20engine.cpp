@@ -0,0 +1,164 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2024, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+#include "utils/prng/chacha20engine.h"
+#include "utils/prng/blake2engine.h"
+#include "utils/memory.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace default_prng {
+
+namespace {
+
+// the keystream of LANES consecutive blocks is computed together; the loops over the lanes are vectorized
+constexpr size_t LANES = 8;
+
+using ChaCha20State = uint32_t[16][LANES];
+
+inline uint32_t Rotl(uint32_t v, int c) {
+    return (v << c) | (v >> (32 - c));
+}
+
+inline void QuarterRound(ChaCha20State& x, size_t a, size_t b, size_t c, size_t d) {
+    for (size_t l = 0; l < LANES; ++l) {
+        x[a][l] += x[b][l];
+        x[d][l] = Rotl(x[d][l] ^ x[a][l], 16);
+        x[c][l] += x[d][l];
+        x[b][l] = Rotl(x[b][l] ^ x[c][l], 12);
+        x[a][l] += x[b][l];
+        x[d][l] = Rotl(x[d][l] ^ x[a][l], 8);
+        x[c][l] += x[d][l];
+        x[b][l] = Rotl(x[b][l] ^ x[c][l], 7);
+    }
+}
+
+}  // namespace
+
+ChaCha20Engine::~ChaCha20Engine() {
+    // IMPORTANT: clear the key and the keystream for security reasons
+    lbcrypto::secure_memset(m_key.data(), 0, m_key.size() * sizeof(m_key[0]));
+    lbcrypto::secure_memset(m_buffer.data(), 0, m_buffer.size() * sizeof(m_buffer[0]));
+}
+
+void ChaCha20Engine::Generate(PRNG::result_type* out) {
+    constexpr size_t blockSize = 16;
+    static_assert(PRNG_BUFFER_SIZE % (blockSize * LANES) == 0, "the buffer must hold a multiple of LANES blocks");
+
+    ChaCha20State in;
+    for (size_t l = 0; l < LANES; ++l) {
+        // "expand 32-byte k"
+        in[0][l] = 0x61707865;
+        in[1][l] = 0x3320646e;
+        in[2][l] = 0x79622d32;
+        in[3][l] = 0x6b206574;
+        for (size_t i = 0; i < KEY_SIZE; ++i)
+            in[4 + i][l] = m_key[i];
+        in[14][l] = static_cast<uint32_t>(m_nonce);
+        in[15][l] = static_cast<uint32_t>(m_nonce >> 32);
+    }
+
+    for (size_t block = 0; block < PRNG_BUFFER_SIZE / blockSize; block += LANES) {
+        for (size_t l = 0; l < LANES; ++l) {
+            const uint64_t counter = m_counter + l;
+            in[12][l]              = static_cast<uint32_t>(counter);
+            in[13][l]              = static_cast<uint32_t>(counter >> 32);
+        }
+        m_counter += LANES;
+
+        ChaCha20State x;
+        std::copy(&in[0][0], &in[0][0] + blockSize * LANES, &x[0][0]);
+        for (size_t round = 0; round < 10; ++round) {
+            QuarterRound(x, 0, 4, 8, 12);
+            QuarterRound(x, 1, 5, 9, 13);
+            QuarterRound(x, 2, 6, 10, 14);
+            QuarterRound(x, 3, 7, 11, 15);
+            QuarterRound(x, 0, 5, 10, 15);
+            QuarterRound(x, 1, 6, 11, 12);
+            QuarterRound(x, 2, 7, 8, 13);
+            QuarterRound(x, 3, 4, 9, 14);
+        }
+
+        for (size_t l = 0; l < LANES; ++l) {
+            PRNG::result_type* blockOut = out + (block + l) * blockSize;
+            for (size_t i = 0; i < blockSize; ++i)
+                blockOut[i] = x[i][l] + in[i][l];
+        }
+    }
+}
+
+void ChaCha20Engine::Fill(PRNG::result_type* out, size_t n) {
+    constexpr size_t bufferSize = static_cast<size_t>(PRNG_BUFFER_SIZE);
+
+    // samples still buffered from a previous call come first. m_bufferIndex == 0 means that the buffer has not
+    // been generated yet, m_bufferIndex == bufferSize that it has been consumed
+    if (m_bufferIndex != 0 && m_bufferIndex != bufferSize) {
+        const size_t count = std::min(n, bufferSize - m_bufferIndex);
+        std::copy_n(m_buffer.begin() + m_bufferIndex, count, out);
+        m_bufferIndex += count;
+        out += count;
+        n -= count;
+    }
+
+    for (; n >= bufferSize; n -= bufferSize, out += bufferSize) {
+        Generate(out);
+        m_bufferIndex = bufferSize;
+    }
+
+    if (n > 0) {
+        Generate(m_buffer.data());
+        std::copy_n(m_buffer.begin(), n, out);
+        m_bufferIndex = n;
+    }
+}
+
+extern "C" {
+
+PRNG* createChaCha20EngineInstance() {
+    // the key and the nonce come from the built-in BLAKE2 engine, which gathers a fresh 512-bit seed
+    std::unique_ptr<PRNG> seeder(createEngineInstance());
+
+    ChaCha20Engine::chacha20_key_array_t key{};
+    for (auto& k : key)
+        k = (*seeder)();
+    uint64_t nonce = (*seeder)();
+    nonce          = (nonce << 32) | (*seeder)();
+
+    PRNG* ptr = new ChaCha20Engine(key, nonce, 0);
+
+    // IMPORTANT: re-init key for security reasons
+    lbcrypto::secure_memset(key.data(), 0, key.size() * sizeof(key[0]));
+
+    return ptr;
+}
+}
+
+}  // namespace default_prng
@@ -550,3 +550,31 @@ void modmul_vector(const std::string& msg) {
 TEST(UTBinVect, modmul_vector) {
     RUN_BIG_BACKENDS(modmul_vector, "modmul_vector")
 }
+
+TEST(UTBinVect, native_vector_pool) {
+    NativeInteger modulus(65537);
+    intnat::ReleaseNativeVectorPool();
+    intnat::ResetNativeVectorPoolStats();
+
+    [[maybe_unused]] uintptr_t freed;
+    {
+        NativeVector v(4096, modulus);
+        freed = reinterpret_cast<uintptr_t>(&v[0]);
+    }
+    NativeVector w(4096, modulus);
+    NativeVector x(4096, modulus);
+    auto stats = intnat::GetNativeVectorPoolStats();
+#ifdef WITH_VECTOR_POOL
+    EXPECT_EQ(freed, reinterpret_cast<uintptr_t>(&w[0])) << "the freed buffer was not reused";
+    EXPECT_EQ(stats.allocations, 3u);
+    EXPECT_EQ(stats.poolHits, 1u);
+    EXPECT_EQ(stats.deallocations, 1u);
+    EXPECT_EQ(stats.poolReturns, 1u);
+#else
+    EXPECT_EQ(stats.allocations, 0u);
+    EXPECT_EQ(stats.poolHits, 0u);
+#endif
+    EXPECT_EQ(w, NativeVector(4096, modulus));
+    EXPECT_EQ(w, x);
+    intnat::ReleaseNativeVectorPool();
+}
@@ -592,6 +592,107 @@ TEST(UTDCRTPoly, DCRT_mod_ops_on_two_elements) {
     RUN_BIG_DCRTPOLYS(DCRT_mod_ops_on_two_elements, "DCRT DCRT_mod_ops_on_two_elements");
 }
 
+TEST(UTDCRTPoly, DCRT_approx_switch_crt_basis) {
+    uint32_t order = 2048;
+    uint32_t sizeQ = 5;
+    uint32_t sizeP = 6;
+
+    auto paramsQP = std::make_shared<ILDCRTParams<BigInteger>>(order, sizeQ + sizeP, 50);
+    std::vector<NativeInteger> moduliQ(sizeQ), rootsQ(sizeQ), moduliP(sizeP), rootsP(sizeP);
+    for (uint32_t i = 0; i < sizeQ; ++i) {
+        moduliQ[i] = paramsQP->GetParams()[i]->GetModulus();
+        rootsQ[i]  = paramsQP->GetParams()[i]->GetRootOfUnity();
+    }
+    for (uint32_t j = 0; j < sizeP; ++j) {
+        moduliP[j] = paramsQP->GetParams()[sizeQ + j]->GetModulus();
+        rootsP[j]  = paramsQP->GetParams()[sizeQ + j]->GetRootOfUnity();
+    }
+    auto paramsQ = std::make_shared<ILDCRTParams<BigInteger>>(order, moduliQ, rootsQ);
+    auto paramsP = std::make_shared<ILDCRTParams<BigInteger>>(order, moduliP, rootsP);
+
+    const BigInteger& Q(paramsQ->GetModulus());
+    const auto BarrettBase128Bit(BigInteger(1).LShiftEq(128));
+    std::vector<NativeInteger> QHatInvModq(sizeQ), QHatInvModqPrecon(sizeQ);
+    std::vector<std::vector<NativeInteger>> QHatModp(sizeQ, std::vector<NativeInteger>(sizeP));
+    std::vector<DoubleNativeInt> modpBarrettMu(sizeP);
+    for (uint32_t i = 0; i < sizeQ; ++i) {
+        BigInteger qi(moduliQ[i]);
+        BigInteger QHati     = Q / qi;
+        QHatInvModq[i]       = NativeInteger(QHati.Mod(qi).ModInverse(qi).ConvertToInt());
+        QHatInvModqPrecon[i] = QHatInvModq[i].PrepModMulConst(moduliQ[i]);
+        for (uint32_t j = 0; j < sizeP; ++j)
+            QHatModp[i][j] = NativeInteger(QHati.Mod(BigInteger(moduliP[j])).ConvertToInt());
+    }
+    for (uint32_t j = 0; j < sizeP; ++j)
+        modpBarrettMu[j] = (BarrettBase128Bit / BigInteger(moduliP[j])).ConvertToInt<DoubleNativeInt>();
+
+    DCRTPoly::DugType dug;
+    DCRTPoly x(dug, paramsQ, Format::COEFFICIENT);
+    DCRTPoly ans;
+    for (uint32_t trial = 0; trial < 2; ++trial) {
+        // the second trial writes into the towers allocated by the first one
+        x.ApproxSwitchCRTBasis(paramsQ, paramsP, QHatInvModq, QHatInvModqPrecon, QHatModp, modpBarrettMu, &ans);
+        ASSERT_EQ(ans.GetNumOfElements(), sizeP);
+        EXPECT_EQ(ans.GetFormat(), Format::COEFFICIENT);
+        for (uint32_t j = 0; j < sizeP; ++j) {
+            const auto& pj = moduliP[j];
+            for (uint32_t ri = 0; ri < paramsQ->GetRingDimension(); ++ri) {
+                NativeInteger expected(0);
+                for (uint32_t i = 0; i < sizeQ; ++i) {
+                    auto xQHatInvModqi = x.GetElementAtIndex(i)[ri].ModMul(QHatInvModq[i], moduliQ[i]);
+                    expected.ModAddEq(xQHatInvModqi.Mod(pj).ModMul(QHatModp[i][j], pj), pj);
+                }
+                EXPECT_EQ(expected, ans.GetElementAtIndex(j)[ri]) << "tower " << j << " index " << ri;
+            }
+        }
+        EXPECT_EQ(ans, x.ApproxSwitchCRTBasis(paramsQ, paramsP, QHatInvModq, QHatInvModqPrecon, QHatModp,
+                                              modpBarrettMu));
+        x = DCRTPoly(dug, paramsQ, Format::COEFFICIENT);
+    }
+}
+
+TEST(UTDCRTPoly, DCRT_contiguous_storage) {
+    const bool contiguous{DCRTPoly::GetContiguousStorage()};
+    auto params = std::make_shared<ILDCRTParams<BigInteger>>(64, 4, 50);
+    DCRTPoly::DugType dug;
+
+    DCRTPoly::SetContiguousStorage(false);
+    DCRTPoly a(dug, params, Format::EVALUATION);
+    DCRTPoly b(dug, params, Format::EVALUATION);
+    EXPECT_FALSE(a.IsContiguous());
+    DCRTPoly expected = a * b + a;
+    DCRTPoly expectedZero(params, Format::EVALUATION, true);
+
+    DCRTPoly::SetContiguousStorage(true);
+    DCRTPoly zero(params, Format::EVALUATION, true);
+    EXPECT_TRUE(zero.IsContiguous());
+    EXPECT_EQ(expectedZero, zero);
+
+    DCRTPoly c(a);
+    EXPECT_TRUE(c.IsContiguous());
+    EXPECT_EQ(a, c);
+    c *= b;
+    c += a;
+    EXPECT_TRUE(c.IsContiguous()) << "in-place operations keep the layout";
+    EXPECT_EQ(expected, c);
+
+    zero = a;
+    EXPECT_TRUE(zero.IsContiguous()) << "assignment copies into the existing buffer";
+    EXPECT_EQ(a, zero);
+
+    auto towers = c.CloneTowers(1, 2);
+    EXPECT_TRUE(towers.IsContiguous());
+    EXPECT_EQ(towers.GetNumOfElements(), 2u);
+    EXPECT_EQ(towers.GetElementAtIndex(0), c.GetElementAtIndex(1));
+    EXPECT_EQ(towers.GetElementAtIndex(1), c.GetElementAtIndex(2));
+
+    a.MakeContiguous();
+    EXPECT_TRUE(a.IsContiguous());
+    EXPECT_EQ(a, zero);
+
+    DCRTPoly::SetContiguousStorage(contiguous);
+}
+
 // only need to try this with one
 void testDCRTPolyConstructorNegative(std::vector<NativePoly>& towers) {
     DCRTPoly expectException(towers);
@@ -43,6 +43,9 @@
 #include "math/nbtheory.h"
 #include "utils/debug.h"
 #include "utils/inttypes.h"
+#include "utils/parallel.h"
+#include "utils/prng/aesctrengine.h"
+#include "utils/prng/chacha20engine.h"
 #include "utils/utilities.h"
 
 #include "testdefs.h"
@@ -217,6 +220,184 @@ void testDiscreteUniformGenerator(typename V::Integer& modulus, std::string test
         << "Failure testing second_moment_test_convertToDouble " << test_name;
 }
 
+template <typename V>
+void SeededDiscreteUniformGenerator(const std::string& msg) {
+    typename V::Integer modulus("10402635286389262637365363");
+    const PRNGSeed seed = PseudoRandomNumberGenerator::GenerateSeed();
+
+    // the same seed and stream give the same vector, another stream gives a different one
+    auto dug0 = DiscreteUniformGeneratorImpl<V>();
+    dug0.SetPRNG(PseudoRandomNumberGenerator::CreateSeededPRNG(seed, 0));
+    auto dug0Again = DiscreteUniformGeneratorImpl<V>();
+    dug0Again.SetPRNG(PseudoRandomNumberGenerator::CreateSeededPRNG(seed, 0));
+    auto dug1 = DiscreteUniformGeneratorImpl<V>();
+    dug1.SetPRNG(PseudoRandomNumberGenerator::CreateSeededPRNG(seed, 1));
+
+    usint size = 1000;
+    V v0       = dug0.GenerateVector(size, modulus);
+    V v0Again  = dug0Again.GenerateVector(size, modulus);
+    V v1       = dug1.GenerateVector(size, modulus);
+
+    EXPECT_EQ(v0, v0Again) << msg << " Failure: same seed, different vectors";
+    EXPECT_FALSE(v0 == v1) << msg << " Failure: different streams, same vector";
+    for (usint i = 0; i < size; ++i)
+        EXPECT_LT(v0.at(i), modulus) << msg << " Failure: value not reduced at index " << i;
+}
+
+TEST(UTDistrGen, SeededDiscreteUniformGenerator) {
+    RUN_BIG_BACKENDS(SeededDiscreteUniformGenerator, "SeededDiscreteUniformGenerator")
+}
+
+TEST(UTDistrGen, ScopedPRNG) {
+    const PRNGSeed seed = PseudoRandomNumberGenerator::GenerateSeed();
+    auto expected       = PseudoRandomNumberGenerator::CreateSeededPRNG(seed);
+    auto nested         = PseudoRandomNumberGenerator::CreateSeededPRNG(seed, 1);
+    EXPECT_FALSE(PseudoRandomNumberGenerator::HasScopedPRNG()) << "Failure: scoped engine set outside of a scope";
+    {
+        PseudoRandomNumberGenerator::ScopedPRNG scope(PseudoRandomNumberGenerator::CreateSeededPRNG(seed));
+        EXPECT_TRUE(PseudoRandomNumberGenerator::HasScopedPRNG()) << "Failure: scoped engine not set";
+        EXPECT_EQ(PseudoRandomNumberGenerator::GetPRNG()(), (*expected)()) << "Failure: scoped engine not used";
+        {
+            PseudoRandomNumberGenerator::ScopedPRNG inner(PseudoRandomNumberGenerator::CreateSeededPRNG(seed, 1));
+            EXPECT_EQ(PseudoRandomNumberGenerator::GetPRNG()(), (*nested)()) << "Failure: nested engine not used";
+        }
+        // the outer engine continues where it stopped
+        EXPECT_EQ(PseudoRandomNumberGenerator::GetPRNG()(), (*expected)()) << "Failure: outer engine not restored";
+
+    }
+
+    // the towers of a DCRTPoly are sampled in parallel from streams of a seed drawn from the scoped engine, so the
+    // result does not depend on the number of threads
+    auto params  = std::make_shared<ILDCRTParams<BigInteger>>(64, 4, 50);
+    auto sampled = [&](int threads) {
+        const int cap = OpenFHEParallelControls.SetThreadCap(threads);
+        PseudoRandomNumberGenerator::ScopedPRNG scope(PseudoRandomNumberGenerator::CreateSeededPRNG(seed, 2));
+        DCRTPoly::DugType dug;
+        DCRTPoly result(dug, params, Format::EVALUATION);
+        OpenFHEParallelControls.SetThreadCap(cap);
+        return result;
+    };
+    const DCRTPoly expectedPoly = sampled(1);
+    EXPECT_EQ(sampled(1), expectedPoly) << "Failure: DCRTPoly sampled from the same scoped engine differs";
+    EXPECT_EQ(sampled(0), expectedPoly) << "Failure: DCRTPoly depends on the number of threads";
+    EXPECT_FALSE(expectedPoly.GetElementAtIndex(0).GetValues() == expectedPoly.GetElementAtIndex(1).GetValues())
+        << "Failure: towers sampled from the same stream";
+    EXPECT_FALSE(PseudoRandomNumberGenerator::HasScopedPRNG()) << "Failure: scoped engine not reset";
+}
+
+TEST(UTDistrGen, ChaCha20Engine) {
+    // RFC 8439, section 2.3.2: key 00:01:...:1f, block counter 1, nonce 00:00:00:09:00:00:00:4a:00:00:00:00.
+    // The 64-bit counter of the engine holds the block counter and the first word of the 96-bit nonce
+    default_prng::ChaCha20Engine::chacha20_key_array_t key;
+    for (uint32_t i = 0; i < key.size(); ++i)
+        key[i] = (4 * i) | ((4 * i + 1) << 8) | ((4 * i + 2) << 16) | ((4 * i + 3) << 24);
+    default_prng::ChaCha20Engine kat(key, 0x4a000000, (uint64_t(0x09000000) << 32) | 1);
+
+    const std::vector<PRNG::result_type> expected = {0xe4e7f110, 0x15593bd1, 0x1fdd0f50, 0xc47120a3,
+                                                     0xc7f4d1c7, 0x0368c033, 0x9aaa2204, 0x4e6cd4c3,
+                                                     0x466482d2, 0x09aa9f07, 0x05d7c214, 0xa2028bd9,
+                                                     0xd19c12b5, 0xb94e16de, 0xe883d0cb, 0x4e3c50a2};
+    for (size_t i = 0; i < expected.size(); ++i)
+        EXPECT_EQ(kat(), expected[i]) << "Failure: ChaCha20 keystream mismatch at word " << i;
+
+    // Fill() returns the same samples as operator()
+    default_prng::ChaCha20Engine bulk(key, 7), scalar(key, 7);
+    for (size_t n : {3, 4093, 9000, 1}) {
+        std::vector<PRNG::result_type> words(n);
+        bulk.Fill(words.data(), n);
+        for (size_t i = 0; i < n; ++i)
+            EXPECT_EQ(words[i], scalar()) << "Failure: ChaCha20 Fill mismatch at word " << i;
+    }
+
+    // uniform sampling with the engine
+    NativeInteger modulus(FirstPrime<NativeInteger>(MAX_MODULUS_SIZE, 2048));
+    auto dug = DiscreteUniformGeneratorImpl<NativeVector>(modulus);
+    dug.SetPRNG(std::make_shared<default_prng::ChaCha20Engine>(key, 8));
+    NativeVector v = dug.GenerateVector(1000);
+    for (usint i = 0; i < v.GetLength(); ++i)
+        EXPECT_LT(v.at(i), modulus) << "Failure: ChaCha20 sample not reduced at index " << i;
+}
+
+TEST(UTDistrGen, AesCtrEngine) {
+    // NIST SP 800-38A, F.5.5 (CTR-AES256.Encrypt): the keystream is the XOR of the plaintext and the ciphertext.
+    // The engine encrypts V + 1 first, so V is the initial counter block minus 1
+    const uint8_t keyBytes[] = {0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae,
+                                0xf0, 0x85, 0x7d, 0x77, 0x81, 0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61,
+                                0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4};
+    default_prng::AesCtrEngine::aesctr_key_array_t key;
+    for (uint32_t i = 0; i < key.size(); ++i)
+        key[i] = keyBytes[4 * i] | (keyBytes[4 * i + 1] << 8) | (keyBytes[4 * i + 2] << 16) |
+                 (uint32_t(keyBytes[4 * i + 3]) << 24);
+
+    const std::vector<PRNG::result_type> expected = {0xf17ddf0b, 0x33161759, 0x158b9a5e, 0x02c560c8,
+                                                     0x9d696e5a, 0x06196153, 0x3c863354, 0x947b658f,
+                                                     0x9c2cc11b, 0x5d0d6101, 0xa3d68b0d, 0x62ca8e37,
+                                                     0xc8e15629, 0xb1363569, 0x739ce9be, 0xb67615a3};
+    for (bool useAESNI : {false, true}) {
+        default_prng::AesCtrEngine kat(key, 0xf0f1f2f3f4f5f6f7, 0xf8f9fafbfcfdfefe, useAESNI);
+        for (size_t i = 0; i < expected.size(); ++i)
+            EXPECT_EQ(kat(), expected[i]) << "Failure: AES-CTR keystream mismatch at word " << i
+                                          << (kat.UsesAESNI() ? " with AES-NI" : " without AES-NI");
+    }
+
+    // the AES-NI and the portable implementations agree, also after the key and the counter are updated
+    default_prng::AesCtrEngine::aesctr_seed_array_t seed;
+    for (uint32_t i = 0; i < seed.size(); ++i)
+        seed[i] = 0x9e3779b9 * (i + 1);
+    default_prng::AesCtrEngine portable(seed, false), native(seed);
+    EXPECT_FALSE(portable.UsesAESNI());
+    EXPECT_EQ(native.UsesAESNI(), default_prng::AesCtrEngine::IsAESNISupported());
+    for (size_t i = 0; i < 3 * default_prng::AesCtrEngine::PRNG_BUFFER_SIZE; ++i) {
+        const auto word = portable();
+        if (word != native()) {
+            ADD_FAILURE() << "Failure: AES-CTR implementations differ at word " << i;
+            break;
+        }
+    }
+
+    // Fill() returns the same samples as operator()
+    default_prng::AesCtrEngine bulk(seed), scalar(seed);
+    for (size_t n : {3, 4093, 9000, 1}) {
+        std::vector<PRNG::result_type> words(n);
+        bulk.Fill(words.data(), n);
+        for (size_t i = 0; i < n; ++i)
+            EXPECT_EQ(words[i], scalar()) << "Failure: AES-CTR Fill mismatch at word " << i;
+    }
+
+    // uniform sampling with the engine
+    NativeInteger modulus(FirstPrime<NativeInteger>(MAX_MODULUS_SIZE, 2048));
+    auto dug = DiscreteUniformGeneratorImpl<NativeVector>(modulus);
+    dug.SetPRNG(std::make_shared<default_prng::AesCtrEngine>(seed));
+    NativeVector v = dug.GenerateVector(1000);
+    for (usint i = 0; i < v.GetLength(); ++i)
+        EXPECT_LT(v.at(i), modulus) << "Failure: AES-CTR sample not reduced at index " << i;
+}
+
+TEST(UTDistrGen, BulkDiscreteUniformGenerator) {
+    // the bulk path of GenerateVector for native vectors: one chunk (small modulus) and two chunks per value
+    NativeInteger small_modulus("7919");
+    testDiscreteUniformGenerator<NativeVector>(small_modulus, "bulk small_modulus");
+
+    NativeInteger large_modulus(FirstPrime<NativeInteger>(MAX_MODULUS_SIZE, 2048));
+    testDiscreteUniformGenerator<NativeVector>(large_modulus, "bulk large_modulus");
+
+    // with a seeded engine, the bulk path consumes the engine output exactly like GenerateInteger()
+    const PRNGSeed seed = PseudoRandomNumberGenerator::GenerateSeed();
+    for (const auto& modulus : {small_modulus, large_modulus}) {
+        auto dugBulk = DiscreteUniformGeneratorImpl<NativeVector>(modulus);
+        dugBulk.SetPRNG(PseudoRandomNumberGenerator::CreateSeededPRNG(seed));
+        auto dugScalar = DiscreteUniformGeneratorImpl<NativeVector>(modulus);
+        dugScalar.SetPRNG(PseudoRandomNumberGenerator::CreateSeededPRNG(seed));
+
+        // two vectors so that the second one starts in the middle of a BLAKE2 block
+        for (usint size : {3000, 1500}) {
+            NativeVector v = dugBulk.GenerateVector(size);
+            for (usint i = 0; i < size; ++i)
+                EXPECT_EQ(v.at(i), dugScalar.GenerateInteger()) << "Failure: bulk sample mismatch at index " << i;
+        }
+    }
+}
+
 #ifdef PARALLEL
 template <typename V>
 void ParallelDiscreteUniformGenerator_LONG(const std::string& msg) {
@@ -39,6 +39,7 @@
   */
 
 #include <iostream>
+#include <sstream>
 #include "gtest/gtest.h"
 
 #include "lattice/lat-hal.h"
@@ -111,3 +112,145 @@ void switch_format_simple_double_crt(const std::string& msg) {
 TEST(UTNTT, switch_format_simple_double_crt) {
     RUN_BIG_DCRTPOLYS(switch_format_simple_double_crt, "switch_format_simple_double_crt")
 }
+
+TEST(UTNTT, simd_kernels_match_scalar) {
+    const auto selected{intnat::GetNTTKernelType()};
+    const auto supported{intnat::GetSupportedNTTKernelType()};
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+
+    // 49 bits takes the AVX-512 IFMA path (if available), 60 bits falls back to AVX2
+    for (usint bits : {30, 49, 60}) {
+        for (usint n : {8, 16, 32, 4096}) {
+            usint m{n << 1};
+            NativeInteger modulus{LastPrime<NativeInteger>(bits, m)};
+            NativeInteger rootOfUnity{RootOfUnity(m, modulus)};
+            ChineseRemainderTransformFTT<NativeVector> crtFTT;
+            crtFTT.PreCompute(rootOfUnity, m, modulus);
+
+            NativeVector x{dug.GenerateVector(n, modulus)};
+
+            intnat::SetNTTKernelType(intnat::NTT_KERNEL_SCALAR);
+            NativeVector fwdExpected(n);
+            crtFTT.ForwardTransformToBitReverse(x, rootOfUnity, m, &fwdExpected);
+            NativeVector invExpected(n);
+            crtFTT.InverseTransformFromBitReverse(x, rootOfUnity, m, &invExpected);
+
+            for (int k = intnat::NTT_KERNEL_SCALAR + 1; k <= supported; ++k) {
+                auto kernel{static_cast<intnat::NTTKernelType>(k)};
+                std::stringstream msg;
+                msg << "kernel " << kernel << ", " << bits << "-bit modulus, n = " << n;
+                intnat::SetNTTKernelType(kernel);
+
+                NativeVector fwd(n);
+                crtFTT.ForwardTransformToBitReverse(x, rootOfUnity, m, &fwd);
+                EXPECT_EQ(fwdExpected, fwd) << msg.str() << ": ForwardTransformToBitReverse";
+
+                NativeVector fwdInPlace{x};
+                crtFTT.ForwardTransformToBitReverseInPlace(rootOfUnity, m, &fwdInPlace);
+                EXPECT_EQ(fwdExpected, fwdInPlace) << msg.str() << ": ForwardTransformToBitReverseInPlace";
+
+                NativeVector inv(n);
+                crtFTT.InverseTransformFromBitReverse(x, rootOfUnity, m, &inv);
+                EXPECT_EQ(invExpected, inv) << msg.str() << ": InverseTransformFromBitReverse";
+
+                crtFTT.InverseTransformFromBitReverseInPlace(rootOfUnity, m, &fwdInPlace);
+                EXPECT_EQ(x, fwdInPlace) << msg.str() << ": InverseTransformFromBitReverseInPlace";
+            }
+        }
+    }
+    intnat::SetNTTKernelType(selected);
+}
+
+TEST(UTNTT, batch_matches_single_tower) {
+    const auto selected{intnat::GetNTTKernelType()};
+    const auto supported{intnat::GetSupportedNTTKernelType()};
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+
+    for (usint n : {16, 64, 4096}) {
+        usint m{n << 1};
+        // towers of different sizes, so that every kernel sees both applicable and non-applicable moduli
+        std::vector<NativeInteger> moduli{LastPrime<NativeInteger>(30, m), LastPrime<NativeInteger>(49, m),
+                                          LastPrime<NativeInteger>(60, m)};
+        moduli.push_back(PreviousPrime(moduli[1], m));
+        moduli.push_back(PreviousPrime(moduli[2], m));
+        std::vector<NativeInteger> roots;
+        std::vector<NativeVector> x;
+        for (const auto& q : moduli) {
+            roots.push_back(RootOfUnity(m, q));
+            x.push_back(dug.GenerateVector(n, q));
+        }
+
+        for (int k = intnat::NTT_KERNEL_SCALAR; k <= supported; ++k) {
+            auto kernel{static_cast<intnat::NTTKernelType>(k)};
+            intnat::SetNTTKernelType(kernel);
+            ChineseRemainderTransformFTT<NativeVector> crtFTT;
+
+            std::vector<NativeVector> expected{x};
+            for (size_t i = 0; i < x.size(); ++i)
+                crtFTT.ForwardTransformToBitReverseInPlace(roots[i], m, &expected[i]);
+
+            for (uint32_t blocks : {0, 1, 2, 4, 8}) {
+                std::stringstream msg;
+                msg << "kernel " << kernel << ", n = " << n << ", blocks = " << blocks;
+
+                std::vector<NativeVector> y{x};
+                std::vector<NativeVector*> towers;
+                for (auto& v : y)
+                    towers.push_back(&v);
+
+                crtFTT.ForwardTransformToBitReverseInPlaceBatch(roots, m, towers, blocks);
+                EXPECT_EQ(expected, y) << msg.str() << ": ForwardTransformToBitReverseInPlaceBatch";
+
+                crtFTT.InverseTransformFromBitReverseInPlaceBatch(roots, m, towers, blocks);
+                EXPECT_EQ(x, y) << msg.str() << ": InverseTransformFromBitReverseInPlaceBatch";
+            }
+        }
+    }
+    intnat::SetNTTKernelType(selected);
+}
+
+TEST(UTNTT, lazy_reduction_matches_full) {
+    const auto selected{intnat::GetNTTKernelType()};
+    const bool lazy{ChineseRemainderTransformFTT<NativeVector>::GetLazyReduction()};
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+
+    intnat::SetNTTKernelType(intnat::NTT_KERNEL_SCALAR);
+    for (usint bits : {30, 49, 60}) {
+        for (usint n : {8, 16, 4096}) {
+            usint m{n << 1};
+            NativeInteger modulus{LastPrime<NativeInteger>(bits, m)};
+            NativeInteger rootOfUnity{RootOfUnity(m, modulus)};
+            ChineseRemainderTransformFTT<NativeVector> crtFTT;
+            std::stringstream msg;
+            msg << bits << "-bit modulus, n = " << n;
+
+            NativeVector x{dug.GenerateVector(n, modulus)};
+            // the extreme values exercise the [0, 4q) bounds
+            x[0] = modulus - NativeInteger(1);
+            x[n - 1] = modulus - NativeInteger(1);
+
+            crtFTT.SetLazyReduction(false);
+            NativeVector fwdExpected(n);
+            crtFTT.ForwardTransformToBitReverse(x, rootOfUnity, m, &fwdExpected);
+            NativeVector invExpected(n);
+            crtFTT.InverseTransformFromBitReverse(x, rootOfUnity, m, &invExpected);
+
+            crtFTT.SetLazyReduction(true);
+            NativeVector fwd(n);
+            crtFTT.ForwardTransformToBitReverse(x, rootOfUnity, m, &fwd);
+            EXPECT_EQ(fwdExpected, fwd) << msg.str() << ": ForwardTransformToBitReverse";
+
+            NativeVector inv(n);
+            crtFTT.InverseTransformFromBitReverse(x, rootOfUnity, m, &inv);
+            EXPECT_EQ(invExpected, inv) << msg.str() << ": InverseTransformFromBitReverse";
+
+            NativeVector y{x};
+            crtFTT.ForwardTransformToBitReverseInPlace(rootOfUnity, m, &y);
+            EXPECT_EQ(fwdExpected, y) << msg.str() << ": ForwardTransformToBitReverseInPlace";
+            crtFTT.InverseTransformFromBitReverseInPlace(rootOfUnity, m, &y);
+            EXPECT_EQ(x, y) << msg.str() << ": InverseTransformFromBitReverseInPlace";
+        }
+    }
+    ChineseRemainderTransformFTT<NativeVector>::SetLazyReduction(lazy);
+    intnat::SetNTTKernelType(selected);
+}
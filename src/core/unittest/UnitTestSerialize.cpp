@@ -134,11 +134,46 @@ void vector_of_bigint(const std::string& msg) {
         Serial::Serialize(val, s, SerType::BINARY);
         Serial::Deserialize(deser, s, SerType::BINARY);
         EXPECT_EQ(val, deser) << msg << " vector binary ser/deser fails";
+
+        // deserializing into vectors that already have storage
+        for (usint size : {val.GetLength(), val.GetLength() / 2, 2 * val.GetLength()}) {
+            V sized(size, mod);
+            s.clear();
+            s.seekg(0);
+            Serial::Deserialize(sized, s, SerType::BINARY);
+            EXPECT_EQ(val, sized) << msg << " vector binary deser into a vector of size " << size << " fails";
+        }
+        auto binarySize = s.str().size();
+
+        s.str("");
+        s.clear();
+        Serial::Serialize(val, s, SerType::COMPACT);
+        EXPECT_LT(s.str().size(), binarySize) << msg << " compact serialization is not smaller than binary";
+        V compact;
+        Serial::Deserialize(compact, s, SerType::COMPACT);
+        EXPECT_EQ(val, compact) << msg << " vector compact ser/deser fails";
+
+        // the layout is recorded in the stream, so the compact stream also loads as binary and vice versa
+        const std::string compactStream = s.str();
+        std::stringstream c(compactStream);
+        V fromCompact;
+        Serial::Deserialize(fromCompact, c, SerType::BINARY);
+        EXPECT_EQ(val, fromCompact) << msg << " vector compact ser/binary deser fails";
+
+        std::stringstream b;
+        Serial::Serialize(val, b, SerType::BINARY);
+        V fromBinary;
+        Serial::Deserialize(fromBinary, b, SerType::COMPACT);
+        EXPECT_EQ(val, fromBinary) << msg << " vector binary ser/compact deser fails";
     };
 
     sfunc(testvec);
 }
 
+TEST(UTSer, native_vector) {
+    vector_of_bigint<NativeVector>("native_vector");
+}
+
 template <typename Element>
 void ilparams_test(const std::string& msg) {
     auto p = std::make_shared<typename Element::Params>(1024);
@@ -95,6 +95,8 @@ public:
         encodingType       = ciphertext.encodingType;
         m_slots            = ciphertext.m_slots;
         m_metadataMap      = ciphertext.m_metadataMap;
+        m_seed             = ciphertext.m_seed;
+        m_seeded           = ciphertext.m_seeded;
     }
 
     explicit CiphertextImpl(Ciphertext<Element> ciphertext) : CryptoObject<Element>(*ciphertext) {
@@ -107,6 +109,8 @@ public:
         encodingType       = ciphertext->encodingType;
         m_slots            = ciphertext->m_slots;
         m_metadataMap      = ciphertext->m_metadataMap;
+        m_seed             = ciphertext->m_seed;
+        m_seeded           = ciphertext->m_seeded;
     }
 
     /**
@@ -122,6 +126,8 @@ public:
         encodingType       = std::move(ciphertext.encodingType);
         m_slots            = std::move(ciphertext.m_slots);
         m_metadataMap      = std::move(ciphertext.m_metadataMap);
+        m_seed             = ciphertext.m_seed;
+        m_seeded           = ciphertext.m_seeded;
     }
 
     explicit CiphertextImpl(Ciphertext<Element>&& ciphertext) : CryptoObject<Element>(*ciphertext) {
@@ -134,6 +140,8 @@ public:
         encodingType       = std::move(ciphertext->encodingType);
         m_slots            = std::move(ciphertext->m_slots);
         m_metadataMap      = std::move(ciphertext->m_metadataMap);
+        m_seed             = ciphertext->m_seed;
+        m_seeded           = ciphertext->m_seeded;
     }
 
     /**
@@ -192,6 +200,8 @@ public:
             this->encodingType       = rhs.encodingType;
             this->m_slots            = rhs.m_slots;
             this->m_metadataMap      = rhs.m_metadataMap;
+            this->m_seed             = rhs.m_seed;
+            this->m_seeded           = rhs.m_seeded;
         }
 
         return *this;
@@ -215,6 +225,8 @@ public:
             this->encodingType       = std::move(rhs.encodingType);
             this->m_slots            = std::move(rhs.m_slots);
             this->m_metadataMap      = std::move(rhs.m_metadataMap);
+            this->m_seed             = rhs.m_seed;
+            this->m_seeded           = rhs.m_seeded;
         }
 
         return *this;
@@ -242,6 +254,7 @@ public:
    * @return the first (and only!) ring element
    */
     Element& GetElement() {
+        m_seeded = false;
         if (m_elements.size() == 1)
             return m_elements[0];
 
@@ -263,6 +276,7 @@ public:
    * @return vector of ring elements
    */
     std::vector<Element>& GetElements() {
+        m_seeded = false;
         return m_elements;
     }
 
@@ -277,6 +291,7 @@ public:
    * @param &element is a polynomial ring element.
    */
     void SetElement(const Element& element) {
+        m_seeded = false;
         if (m_elements.size() == 0)
             m_elements.push_back(element);
         else if (m_elements.size() == 1)
@@ -294,6 +309,7 @@ public:
    */
     void SetElements(const std::vector<Element>& elements) {
         m_elements = elements;
+        m_seeded   = false;
     }
 
     /**
@@ -303,6 +319,25 @@ public:
    */
     void SetElements(std::vector<Element>&& elements) {
         m_elements = std::move(elements);
+        m_seeded   = false;
+    }
+
+    /**
+   * Records that the second ring element was generated by GenerateSeededUniform() from the given seed
+   * (stream 0, parameters of the first element). Serialization then stores the seed instead of the element.
+   * Must be called after SetElements; any later non-const access to the elements drops the seed.
+   * @param &seed is the seed of the second ring element.
+   */
+    void SetElementsSeed(const PRNGSeed& seed) {
+        m_seed   = seed;
+        m_seeded = true;
+    }
+
+    /**
+   * @return true if the second ring element can be regenerated from a seed.
+   */
+    bool IsSeeded() const {
+        return m_seeded;
     }
 
     /**
@@ -551,7 +586,15 @@ public:
     template <class Archive>
     void save(Archive& ar, std::uint32_t const version) const {
         ar(cereal::base_class<CryptoObject<Element>>(this));
-        ar(cereal::make_nvp("v", m_elements));
+        const bool seeded = m_seeded && m_elements.size() == 2;
+        if (seeded) {
+            // the first element alone is followed by the seed of the second one
+            std::vector<Element> elements{m_elements[0]};
+            ar(cereal::make_nvp("v", elements));
+        }
+        else {
+            ar(cereal::make_nvp("v", m_elements));
+        }
         ar(cereal::make_nvp("d", m_noiseScaleDeg));
         ar(cereal::make_nvp("l", m_level));
         ar(cereal::make_nvp("t", m_hopslevel));
@@ -560,6 +603,9 @@ public:
         ar(cereal::make_nvp("e", encodingType));
         ar(cereal::make_nvp("sl", m_slots));
         ar(cereal::make_nvp("m", m_metadataMap));
+        ar(cereal::make_nvp("sd", seeded));
+        if (seeded)
+            ar(cereal::make_nvp("ss", m_seed));
     }
 
     template <class Archive>
@@ -578,13 +624,21 @@ public:
         ar(cereal::make_nvp("e", encodingType));
         ar(cereal::make_nvp("sl", m_slots));
         ar(cereal::make_nvp("m", m_metadataMap));
+        m_seeded = false;
+        if (version > 1) {
+            ar(cereal::make_nvp("sd", m_seeded));
+            if (m_seeded) {
+                ar(cereal::make_nvp("ss", m_seed));
+                m_elements.push_back(GenerateSeededUniform<Element>(m_seed, 0, m_elements.at(0).GetParams()));
+            }
+        }
     }
 
     std::string SerializedObjectName() const {
         return "Ciphertext";
     }
     static uint32_t SerializedVersion() {
-        return 1;
+        return 2;
     }
 
 private:
@@ -609,6 +663,10 @@ private:
 
     // A map to hold different Metadata objects - used for flexible extensions of Ciphertext
     MetadataMap m_metadataMap = std::make_shared<std::map<std::string, std::shared_ptr<Metadata>>>();
+
+    // seed of the second ring element when it is a fresh uniform sample (see SetElementsSeed)
+    PRNGSeed m_seed{};
+    bool m_seeded = false;
 };
 
 // TODO the op= are not doing the work in-place, and should be updated
@@ -121,6 +121,14 @@ template bool CryptoContextImpl<DCRTPoly>::SerializeEvalAutomorphismKey<SerType:
     std::ostream& ser, const SerType::SERJSON&, const CryptoContext<DCRTPoly> cc);
 template bool CryptoContextImpl<DCRTPoly>::DeserializeEvalAutomorphismKey<SerType::SERJSON>(std::istream& ser,
                                                                                             const SerType::SERJSON&);
+template bool CryptoContextImpl<DCRTPoly>::SerializeEvalAutomorphismKeyStream<SerType::SERJSON>(
+    std::ostream& ser, const SerType::SERJSON&, const std::string& keyID, const std::vector<uint32_t>& indexList);
+template bool CryptoContextImpl<DCRTPoly>::DeserializeEvalAutomorphismKeyStream<SerType::SERJSON>(
+    std::istream& ser, const SerType::SERJSON&, const std::vector<uint32_t>& indexList);
+template bool CryptoContextImpl<DCRTPoly>::SerializeEvalAutomorphismKeyStore<SerType::SERJSON>(
+    const std::string& filename, const SerType::SERJSON&, const std::string& keyID);
+template bool CryptoContextImpl<DCRTPoly>::DeserializeEvalAutomorphismKeyStore<SerType::SERJSON>(
+    const std::string& filename, const SerType::SERJSON&, size_t memoryBudget);
 
 // ================================= BINARY serialization/deserialization
 namespace Serial {
@@ -205,6 +213,91 @@ template bool CryptoContextImpl<DCRTPoly>::SerializeEvalAutomorphismKey<SerType:
     std::ostream& ser, const SerType::SERBINARY&, const CryptoContext<DCRTPoly> cc);
 template bool CryptoContextImpl<DCRTPoly>::DeserializeEvalAutomorphismKey<SerType::SERBINARY>(
     std::istream& ser, const SerType::SERBINARY&);
+template bool CryptoContextImpl<DCRTPoly>::SerializeEvalAutomorphismKeyStream<SerType::SERBINARY>(
+    std::ostream& ser, const SerType::SERBINARY&, const std::string& keyID, const std::vector<uint32_t>& indexList);
+template bool CryptoContextImpl<DCRTPoly>::DeserializeEvalAutomorphismKeyStream<SerType::SERBINARY>(
+    std::istream& ser, const SerType::SERBINARY&, const std::vector<uint32_t>& indexList);
+template bool CryptoContextImpl<DCRTPoly>::SerializeEvalAutomorphismKeyStore<SerType::SERBINARY>(
+    const std::string& filename, const SerType::SERBINARY&, const std::string& keyID);
+template bool CryptoContextImpl<DCRTPoly>::DeserializeEvalAutomorphismKeyStore<SerType::SERBINARY>(
+    const std::string& filename, const SerType::SERBINARY&, size_t memoryBudget);
+
+// ================================= COMPACT serialization/deserialization
+namespace Serial {
+/**
+ * Deserialize for a CryptoContext (that is, a shared pointer to a
+ * CryptoContextImpl OpenFHE doesn't want multiple copies of the same crypto
+ * context floating around, and it enforces that here
+ *
+ * @param obj - the target for the deserialization
+ * @param stream - where the serialization is coming from
+ * @param sertype - COMPACT serialization type
+ */
+template <typename T>
+void Deserialize(CryptoContext<T>& obj, std::istream& stream, const SerType::SERCOMPACT&) {
+    CryptoContext<T> newob;
+
+    cereal::PortableBinaryInputArchive archive(stream);
+    archive(newob);
+
+    obj = CryptoContextFactory<T>::GetContext(newob->GetCryptoParameters(), newob->GetScheme(), newob->getSchemeId());
+}
+
+template <typename T>
+bool SerializeToFile(const std::string& filename, const CryptoContext<T>& obj, const SerType::SERCOMPACT& sertype) {
+    std::ofstream file(filename, std::ios::out | std::ios::binary);
+    if (file.is_open()) {
+        Serial::Serialize(obj, file, sertype);
+        file.close();
+        return true;
+    }
+    return false;
+}
+
+template <typename T>
+bool DeserializeFromFile(const std::string& filename, CryptoContext<T>& obj, const SerType::SERCOMPACT& sertype) {
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    if (file.is_open()) {
+        Serial::Deserialize(obj, file, sertype);
+        file.close();
+        return true;
+    }
+    return false;
+}
+}  // namespace Serial
+
+template void Serial::Deserialize(std::shared_ptr<CryptoContextImpl<DCRTPoly>>& obj, std::istream& stream,
+                                  const SerType::SERCOMPACT&);
+template bool CryptoContextImpl<DCRTPoly>::SerializeEvalMultKey<SerType::SERCOMPACT>(std::ostream& ser,
+                                                                                     const SerType::SERCOMPACT&,
+                                                                                     std::string id);
+template bool CryptoContextImpl<DCRTPoly>::SerializeEvalMultKey<SerType::SERCOMPACT>(std::ostream& ser,
+                                                                                     const SerType::SERCOMPACT&,
+                                                                                     const CryptoContext<DCRTPoly> cc);
+template bool CryptoContextImpl<DCRTPoly>::DeserializeEvalMultKey<SerType::SERCOMPACT>(std::istream& ser,
+                                                                                       const SerType::SERCOMPACT&);
+template bool CryptoContextImpl<DCRTPoly>::SerializeEvalSumKey<SerType::SERCOMPACT>(std::ostream& ser,
+                                                                                    const SerType::SERCOMPACT&,
+                                                                                    std::string id);
+template bool CryptoContextImpl<DCRTPoly>::SerializeEvalSumKey<SerType::SERCOMPACT>(std::ostream& ser,
+                                                                                    const SerType::SERCOMPACT&,
+                                                                                    const CryptoContext<DCRTPoly> cc);
+template bool CryptoContextImpl<DCRTPoly>::DeserializeEvalSumKey<SerType::SERCOMPACT>(std::istream& ser,
+                                                                                      const SerType::SERCOMPACT&);
+template bool CryptoContextImpl<DCRTPoly>::SerializeEvalAutomorphismKey<SerType::SERCOMPACT>(
+    std::ostream& ser, const SerType::SERCOMPACT&, std::string id);
+template bool CryptoContextImpl<DCRTPoly>::SerializeEvalAutomorphismKey<SerType::SERCOMPACT>(
+    std::ostream& ser, const SerType::SERCOMPACT&, const CryptoContext<DCRTPoly> cc);
+template bool CryptoContextImpl<DCRTPoly>::DeserializeEvalAutomorphismKey<SerType::SERCOMPACT>(
+    std::istream& ser, const SerType::SERCOMPACT&);
+template bool CryptoContextImpl<DCRTPoly>::SerializeEvalAutomorphismKeyStream<SerType::SERCOMPACT>(
+    std::ostream& ser, const SerType::SERCOMPACT&, const std::string& keyID, const std::vector<uint32_t>& indexList);
+template bool CryptoContextImpl<DCRTPoly>::DeserializeEvalAutomorphismKeyStream<SerType::SERCOMPACT>(
+    std::istream& ser, const SerType::SERCOMPACT&, const std::vector<uint32_t>& indexList);
+template bool CryptoContextImpl<DCRTPoly>::SerializeEvalAutomorphismKeyStore<SerType::SERCOMPACT>(
+    const std::string& filename, const SerType::SERCOMPACT&, const std::string& keyID);
+template bool CryptoContextImpl<DCRTPoly>::DeserializeEvalAutomorphismKeyStore<SerType::SERCOMPACT>(
+    const std::string& filename, const SerType::SERCOMPACT&, size_t memoryBudget);
 
 }  // namespace lbcrypto
 
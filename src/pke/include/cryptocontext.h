@@ -43,6 +43,9 @@
 #include "encoding/plaintextfactory.h"
 
 #include "key/evalkey.h"
+#include "key/evalkeyregistry.h"
+#include "key/evalkeyrelin.h"
+#include "key/evalkeystore.h"
 #include "key/keypair.h"
 
 #include "schemebase/base-pke.h"
@@ -57,6 +60,7 @@
 
 #include "binfhecontext.h"
 
+#include <fstream>
 #include <functional>
 #include <map>
 #include <memory>
@@ -66,6 +70,7 @@
 #include <algorithm>
 #include <unordered_map>
 #include <set>
+#include <sstream>
 
 namespace lbcrypto {
 
@@ -238,10 +243,6 @@ class CryptoContextImpl : public Serializable {
                                            CryptoContextImpl<Element>::GetUniqueValues(existingIndices, indices);
     }
     /**
-   * Get automorphism keys for a specific secret key tag
-   */
-    static std::shared_ptr<std::map<usint, EvalKey<Element>>> GetEvalAutomorphismKeyMapPtr(const std::string& keyID);
-    /**
    * @brief Get automorphism keys for a specific secret key tag and an array of specific indices
    * @param keyID - secret key tag
    * @param indexList - array of specific indices to retrieve key for
@@ -250,10 +251,10 @@ class CryptoContextImpl : public Serializable {
     static std::shared_ptr<std::map<usint, EvalKey<Element>>> GetPartialEvalAutomorphismKeyMapPtr(
         const std::string& keyID, const std::vector<uint32_t>& indexList);
 
-    // cached evalmult keys, by secret key UID
-    static std::map<std::string, std::vector<EvalKey<Element>>> s_evalMultKeyMap;
-    // cached evalautomorphism keys, by secret key UID
-    static std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>> s_evalAutomorphismKeyMap;
+    // cached evalmult keys, by secret key UID; safe to read while another thread inserts or clears keys
+    static EvalKeyRegistry<std::vector<EvalKey<Element>>> s_evalMultKeyMap;
+    // cached evalautomorphism keys, by secret key UID; safe to read while another thread inserts or clears keys
+    static EvalKeyRegistry<std::map<usint, EvalKey<Element>>> s_evalAutomorphismKeyMap;
 
 protected:
     // crypto parameters used for this context
@@ -357,6 +358,11 @@ protected:
         }
     }
 
+    /**
+   * Throws if a rotation key is missing for any of the (non-zero) indices.
+   */
+    void CheckRotationKeys(ConstCiphertext<Element> ciphertext, const std::vector<int32_t>& indices) const;
+
     virtual Plaintext MakeCKKSPackedPlaintextInternal(const std::vector<std::complex<double>>& value,
                                                       size_t noiseScaleDeg, uint32_t level,
                                                       const std::shared_ptr<ParmType> params, usint slots) const {
@@ -634,7 +640,7 @@ public:
    */
     template <typename ST>
     static bool SerializeEvalMultKey(std::ostream& ser, const ST& sertype, std::string id = "") {
-        const auto& evalMultKeys = CryptoContextImpl<Element>::GetAllEvalMultKeys();
+        const auto evalMultKeys = CryptoContextImpl<Element>::GetAllEvalMultKeys();
         if (id.length() == 0) {
             Serial::Serialize(evalMultKeys, ser, sertype);
         }
@@ -802,17 +808,14 @@ public:
     template <typename ST>
     static bool SerializeEvalAutomorphismKey(std::ostream& ser, const ST& sertype, std::string id = "") {
         // TODO (dsuponit): do we need Serailize/Deserialized to return bool?
-        std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>* smap;
-        std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>> omap;
+        std::map<std::string, std::shared_ptr<const std::map<usint, EvalKey<Element>>>> omap;
         if (id.length() == 0) {
-            smap = &CryptoContextImpl<Element>::GetAllEvalAutomorphismKeys();
+            omap = CryptoContextImpl<Element>::GetAllEvalAutomorphismKeys();
         }
         else {
-            const auto keys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(id);
-            omap[id]        = keys;
-            smap            = &omap;
+            omap[id] = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(id);
         }
-        Serial::Serialize(*smap, ser, sertype);
+        Serial::Serialize(omap, ser, sertype);
         return true;
     }
 
@@ -826,7 +829,7 @@ public:
    */
     template <typename ST>
     static bool SerializeEvalAutomorphismKey(std::ostream& ser, const ST& sertype, const CryptoContext<Element> cc) {
-        std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>> omap;
+        std::map<std::string, std::shared_ptr<const std::map<usint, EvalKey<Element>>>> omap;
         for (const auto& k : CryptoContextImpl<Element>::GetAllEvalAutomorphismKeys()) {
             if (k.second->begin()->second->GetCryptoContext() == cc) {
                 omap[k.first] = k.second;
@@ -922,6 +925,173 @@ public:
         return true;
     }
 
+    /**
+   * SerializeEvalAutomorphismKeyStream writes the automorphism keys of a secret key tag one key at a time, so that
+   * no more than one serialized key is buffered. Every key is preceded by its size, so that
+   * DeserializeEvalAutomorphismKeyStream() can skip the keys it does not need.
+   *
+   * @param ser - stream to serialize to
+   * @param sertype - type of serialization of the keys
+   * @param keyID - secret key tag
+   * @param indexList - indices of the keys to serialize; empty means all keys
+   * @return true on success
+   */
+    template <typename ST>
+    static bool SerializeEvalAutomorphismKeyStream(std::ostream& ser, const ST& sertype, const std::string& keyID,
+                                                   const std::vector<uint32_t>& indexList = {}) {
+        const auto keys =
+            indexList.empty() ? CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(keyID) :
+                                CryptoContextImpl<Element>::GetPartialEvalAutomorphismKeyMapPtr(keyID, indexList);
+
+        EvalKeyStore<Element>::WriteStreamHeader(ser, keyID, keys->size());
+        for (const auto& k : *keys) {
+            std::ostringstream blob;
+            Serial::Serialize(k.second, blob, sertype);
+            EvalKeyStore<Element>::WriteStreamKey(ser, k.first, blob.str());
+        }
+        return true;
+    }
+
+    /**
+   * DeserializeEvalAutomorphismKeyStream reads keys written by SerializeEvalAutomorphismKeyStream() one key at a
+   * time and adds them for the indices that have no automorphism key yet for their secret key tag. Keys that are
+   * not in indexList are skipped without being deserialized, so the memory needed is that of the selected keys
+   * plus one serialized key.
+   *
+   * @param ser - stream to deserialize from
+   * @param sertype - type of serialization of the keys
+   * @param indexList - indices of the keys to deserialize; empty means all keys
+   * @return true on success
+   */
+    template <typename ST>
+    static bool DeserializeEvalAutomorphismKeyStream(std::istream& ser, const ST& sertype,
+                                                     const std::vector<uint32_t>& indexList = {}) {
+        std::string keyTag;
+        const uint64_t count = EvalKeyStore<Element>::ReadStreamHeader(ser, keyTag);
+        const std::set<uint32_t> wanted(indexList.begin(), indexList.end());
+
+        auto keys = std::make_shared<std::map<usint, EvalKey<Element>>>();
+        std::string blob;
+        for (uint64_t i = 0; i < count; ++i) {
+            const auto [index, size] = EvalKeyStore<Element>::ReadStreamKey(ser);
+            if (!wanted.empty() && wanted.count(index) == 0) {
+                ser.ignore(static_cast<std::streamsize>(size));
+                continue;
+            }
+            blob.resize(size);
+            if (!ser.read(&blob[0], static_cast<std::streamsize>(size)))
+                OPENFHE_THROW("Unexpected end of the key stream");
+            EvalKeyBlobBuffer buffer(&blob[0], blob.size());
+            std::istream is(&buffer);
+            EvalKey<Element> key;
+            Serial::Deserialize(key, is, sertype);
+            (*keys)[index] = key;
+        }
+        if (!ser)
+            OPENFHE_THROW("Unexpected end of the key stream");
+
+        for (const uint32_t indx : wanted) {
+            if (keys->find(indx) == keys->end())
+                OPENFHE_THROW("No automorphism key for index [" + std::to_string(indx) + "] within keyID [" + keyTag +
+                              "] in the key stream.");
+        }
+        CryptoContextImpl<Element>::InsertEvalAutomorphismKey(keys, keyTag);
+        return true;
+    }
+
+    /**
+   * SerializeEvalAutomorphismKeyStore writes the automorphism keys of a secret key tag to a key file that can be
+   * loaded on demand with DeserializeEvalAutomorphismKeyStore(). Every key is serialized separately and the file
+   * starts with the offset of every key, so that a single key can be read without reading the others.
+   *
+   * @param filename - name of the key file
+   * @param sertype - type of serialization of the keys
+   * @param keyID - secret key tag
+   * @return true on success
+   */
+    template <typename ST>
+    static bool SerializeEvalAutomorphismKeyStore(const std::string& filename, const ST& sertype,
+                                                  const std::string& keyID) {
+        const auto keys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(keyID);
+        if (keys->empty())
+            return false;
+
+        std::ofstream file(filename, std::ios::out | std::ios::binary);
+        if (!file.is_open())
+            return false;
+
+        std::ostringstream context;
+        Serial::Serialize(keys->begin()->second->GetCryptoContext(), context, sertype);
+
+        // the header is written twice: first to reserve its space and then with the positions of the keys
+        typename EvalKeyStore<Element>::KeyIndex index;
+        for (const auto& k : *keys)
+            index[k.first] = {0, 0};
+        EvalKeyStore<Element>::WriteHeader(file, keyID, context.str(), index);
+
+        for (const auto& k : *keys) {
+            std::ostringstream blob;
+            Serial::Serialize(k.second, blob, sertype);
+            const auto str = blob.str();
+            index[k.first] = {static_cast<uint64_t>(file.tellp()), str.size()};
+            file.write(str.data(), static_cast<std::streamsize>(str.size()));
+        }
+
+        file.seekp(0);
+        EvalKeyStore<Element>::WriteHeader(file, keyID, context.str(), index);
+        return static_cast<bool>(file);
+    }
+
+    /**
+   * DeserializeEvalAutomorphismKeyStore reads the index of a key file written by
+   * SerializeEvalAutomorphismKeyStore() and adds placeholder keys for the indices that have no automorphism key
+   * yet for its secret key tag. A key is read from the file when it is first used, e.g., by
+   * EvalRotate(). When memoryBudget is not 0, the least recently used keys are dropped from memory once the loaded
+   * keys exceed memoryBudget bytes and are read again when needed. Keys are not dropped while an OpenMP parallel
+   * region is running, so the budget may be exceeded temporarily, and with a budget the keys must not be used
+   * from several non-OpenMP threads at the same time. The file must stay available while the keys are in use.
+   *
+   * @param filename - name of the key file
+   * @param sertype - type of serialization of the keys
+   * @param memoryBudget - maximum number of bytes of keys kept in memory; 0 means no limit
+   * @return true on success
+   */
+    template <typename ST>
+    static bool DeserializeEvalAutomorphismKeyStore(const std::string& filename, const ST& sertype,
+                                                    size_t memoryBudget = 0) {
+        std::ifstream file(filename, std::ios::in | std::ios::binary);
+        if (!file.is_open())
+            return false;
+
+        std::string keyTag;
+        std::string context;
+        auto index = EvalKeyStore<Element>::ReadHeader(file, keyTag, context);
+        file.close();
+
+        CryptoContext<Element> cc;
+        std::istringstream ccStream(context);
+        Serial::Deserialize(cc, ccStream, sertype);
+        cc = CryptoContextFactory<Element>::GetFullContextByDeserializedContext(cc);
+
+        auto reader = [sertype](std::istream& is) {
+            EvalKey<Element> key;
+            Serial::Deserialize(key, is, sertype);
+            return key;
+        };
+        auto store = std::make_shared<EvalKeyStore<Element>>(filename, index, reader, memoryBudget);
+
+        auto keys = std::make_shared<std::map<usint, EvalKey<Element>>>();
+        for (const auto& entry : index) {
+            auto key = std::make_shared<EvalKeyRelinImpl<Element>>(cc);
+            key->SetKeyTag(keyTag);
+            key->SetStore(store, entry.first);
+            store->Register(entry.first, key);
+            (*keys)[entry.first] = key;
+        }
+        CryptoContextImpl<Element>::InsertEvalAutomorphismKey(keys, keyTag);
+        return true;
+    }
+
     /**
    * ClearEvalAutomorphismKeys - flush EvalAutomorphismKey cache
    */
@@ -1056,34 +1226,68 @@ public:
     //------------------------------------------------------------------------------
 
     /**
-   * Get a map of relinearization keys for all secret keys
+   * Get a map of relinearization keys for all secret keys.
+   * The map is a snapshot: keys inserted or cleared later are not reflected in it.
    */
-    static std::map<std::string, std::vector<EvalKey<Element>>>& GetAllEvalMultKeys();
+    static std::map<std::string, std::vector<EvalKey<Element>>> GetAllEvalMultKeys();
 
     /**
-   * Get relinearization keys for a specific secret key tag
+   * Get relinearization keys for a specific secret key tag.
+   * Returns a copy of the vector, which is not affected by keys inserted or cleared later, possibly by another
+   * thread. The copy is const so that existing callers binding the result to a reference keep compiling.
    */
-    static const std::vector<EvalKey<Element>>& GetEvalMultKeyVector(const std::string& keyID);
+    [[deprecated("Use GetEvalMultKeyVectorPtr(const std::string& keyID) instead.")]] static const std::vector<
+        EvalKey<Element>>
+    GetEvalMultKeyVector(const std::string& keyID) {
+        return *(CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(keyID));
+    }
+    /**
+   * Get relinearization keys for a specific secret key tag; the keys are kept for as long as the pointer is held
+   */
+    static std::shared_ptr<const std::vector<EvalKey<Element>>> GetEvalMultKeyVectorPtr(const std::string& keyID);
 
     /**
-   * Get a map of automorphism keys for all secret keys
+   * Get a map of automorphism keys for all secret keys.
+   * The map is a snapshot: keys inserted or cleared later are not reflected in it.
    */
-    static std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>& GetAllEvalAutomorphismKeys();
+    static std::map<std::string, std::shared_ptr<const std::map<usint, EvalKey<Element>>>> GetAllEvalAutomorphismKeys();
     /**
-   * Get automorphism keys for a specific secret key tag
+   * Get automorphism keys for a specific secret key tag.
+   * Returns a copy of the map, which is not affected by keys inserted or cleared later, possibly by another
+   * thread. The copy is const so that existing callers binding the result to a reference keep compiling.
    */
-    static std::map<usint, EvalKey<Element>>& GetEvalAutomorphismKeyMap(const std::string& keyID) {
+    [[deprecated("Use GetEvalAutomorphismKeyMapPtr(const std::string& keyID) instead.")]] static const std::map<
+        usint, EvalKey<Element>>
+    GetEvalAutomorphismKeyMap(const std::string& keyID) {
         return *(CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(keyID));
     }
     /**
+   * Get automorphism keys for a specific secret key tag; the keys are kept for as long as the pointer is held
+   */
+    static std::shared_ptr<const std::map<usint, EvalKey<Element>>> GetEvalAutomorphismKeyMapPtr(
+        const std::string& keyID);
+    /**
    * Get a map of summation keys (each is composed of several automorphism keys) for all secret keys
    */
-    static std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>& GetAllEvalSumKeys();
+    static std::map<std::string, std::shared_ptr<const std::map<usint, EvalKey<Element>>>> GetAllEvalSumKeys();
 
     /**
-   * Get a map of summation keys (each is composed of several automorphism keys) for a specific secret key tag
+   * Get a map of summation keys (each is composed of several automorphism keys) for a specific secret key tag.
+   * Returns a copy of the map, which is not affected by keys inserted or cleared later, possibly by another
+   * thread. The copy is const so that existing callers binding the result to a reference keep compiling.
+   */
+    [[deprecated("Use GetEvalSumKeyMapPtr(const std::string& id) instead.")]] static const std::map<
+        usint, EvalKey<Element>>
+    GetEvalSumKeyMap(const std::string& id) {
+        return *(CryptoContextImpl<Element>::GetEvalSumKeyMapPtr(id));
+    }
+    /**
+   * Get a map of summation keys (each is composed of several automorphism keys) for a specific secret key tag;
+   * the keys are kept for as long as the pointer is held
    */
-    static const std::map<usint, EvalKey<Element>>& GetEvalSumKeyMap(const std::string& id);
+    static std::shared_ptr<const std::map<usint, EvalKey<Element>>> GetEvalSumKeyMapPtr(const std::string& id) {
+        return CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(id);
+    }
 
     //------------------------------------------------------------------------------
     // PLAINTEXT FACTORY METHODS
@@ -1738,12 +1942,12 @@ public:
     Ciphertext<Element> EvalMult(ConstCiphertext<Element> ciphertext1, ConstCiphertext<Element> ciphertext2) const {
         TypeCheck(ciphertext1, ciphertext2);
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext1->GetKeyTag());
-        if (!evalKeyVec.size()) {
+        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(ciphertext1->GetKeyTag());
+        if (!evalKeyVec->size()) {
             OPENFHE_THROW("Evaluation key has not been generated for EvalMult");
         }
 
-        return GetScheme()->EvalMult(ciphertext1, ciphertext2, evalKeyVec[0]);
+        return GetScheme()->EvalMult(ciphertext1, ciphertext2, (*evalKeyVec)[0]);
     }
 
     /**
@@ -1755,12 +1959,12 @@ public:
     Ciphertext<Element> EvalMultMutable(Ciphertext<Element>& ciphertext1, Ciphertext<Element>& ciphertext2) const {
         TypeCheck(ciphertext1, ciphertext2);
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext1->GetKeyTag());
-        if (!evalKeyVec.size()) {
+        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(ciphertext1->GetKeyTag());
+        if (!evalKeyVec->size()) {
             OPENFHE_THROW("Evaluation key has not been generated for EvalMultMutable");
         }
 
-        return GetScheme()->EvalMultMutable(ciphertext1, ciphertext2, evalKeyVec[0]);
+        return GetScheme()->EvalMultMutable(ciphertext1, ciphertext2, (*evalKeyVec)[0]);
     }
 
     /**
@@ -1771,12 +1975,12 @@ public:
     void EvalMultMutableInPlace(Ciphertext<Element>& ciphertext1, Ciphertext<Element>& ciphertext2) const {
         TypeCheck(ciphertext1, ciphertext2);
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext1->GetKeyTag());
-        if (!evalKeyVec.size()) {
+        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(ciphertext1->GetKeyTag());
+        if (!evalKeyVec->size()) {
             OPENFHE_THROW("Evaluation key has not been generated for EvalMultMutable");
         }
 
-        GetScheme()->EvalMultMutableInPlace(ciphertext1, ciphertext2, evalKeyVec[0]);
+        GetScheme()->EvalMultMutableInPlace(ciphertext1, ciphertext2, (*evalKeyVec)[0]);
     }
 
     /**
@@ -1787,12 +1991,12 @@ public:
     Ciphertext<Element> EvalSquare(ConstCiphertext<Element> ciphertext) const {
         ValidateCiphertext(ciphertext);
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext->GetKeyTag());
-        if (!evalKeyVec.size()) {
+        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(ciphertext->GetKeyTag());
+        if (!evalKeyVec->size()) {
             OPENFHE_THROW("Evaluation key has not been generated for EvalMult");
         }
 
-        return GetScheme()->EvalSquare(ciphertext, evalKeyVec[0]);
+        return GetScheme()->EvalSquare(ciphertext, (*evalKeyVec)[0]);
     }
 
     /**
@@ -1803,12 +2007,12 @@ public:
     Ciphertext<Element> EvalSquareMutable(Ciphertext<Element>& ciphertext) const {
         ValidateCiphertext(ciphertext);
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext->GetKeyTag());
-        if (!evalKeyVec.size()) {
+        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(ciphertext->GetKeyTag());
+        if (!evalKeyVec->size()) {
             OPENFHE_THROW("Evaluation key has not been generated for EvalMultMutable");
         }
 
-        return GetScheme()->EvalSquareMutable(ciphertext, evalKeyVec[0]);
+        return GetScheme()->EvalSquareMutable(ciphertext, (*evalKeyVec)[0]);
     }
 
     /**
@@ -1819,12 +2023,12 @@ public:
     void EvalSquareInPlace(Ciphertext<Element>& ciphertext) const {
         ValidateCiphertext(ciphertext);
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext->GetKeyTag());
-        if (!evalKeyVec.size()) {
+        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(ciphertext->GetKeyTag());
+        if (!evalKeyVec->size()) {
             OPENFHE_THROW("Evaluation key has not been generated for EvalMultMutable");
         }
 
-        GetScheme()->EvalSquareInPlace(ciphertext, evalKeyVec[0]);
+        GetScheme()->EvalSquareInPlace(ciphertext, (*evalKeyVec)[0]);
     }
 
     /**
@@ -1849,15 +2053,15 @@ public:
         if (!ciphertext)
             OPENFHE_THROW("Input ciphertext is nullptr");
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext->GetKeyTag());
+        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(ciphertext->GetKeyTag());
 
-        if (evalKeyVec.size() < (ciphertext->NumberCiphertextElements() - 2)) {
+        if (evalKeyVec->size() < (ciphertext->NumberCiphertextElements() - 2)) {
             OPENFHE_THROW(
                 "Insufficient value was used for maxRelinSkDeg to generate "
                 "keys for EvalMult");
         }
 
-        return GetScheme()->Relinearize(ciphertext, evalKeyVec);
+        return GetScheme()->Relinearize(ciphertext, *evalKeyVec);
     }
 
     /**
@@ -1869,14 +2073,14 @@ public:
         if (!ciphertext)
             OPENFHE_THROW("Input ciphertext is nullptr");
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext->GetKeyTag());
-        if (evalKeyVec.size() < (ciphertext->NumberCiphertextElements() - 2)) {
+        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(ciphertext->GetKeyTag());
+        if (evalKeyVec->size() < (ciphertext->NumberCiphertextElements() - 2)) {
             OPENFHE_THROW(
                 "Insufficient value was used for maxRelinSkDeg to generate "
                 "keys for EvalMult");
         }
 
-        GetScheme()->RelinearizeInPlace(ciphertext, evalKeyVec);
+        GetScheme()->RelinearizeInPlace(ciphertext, *evalKeyVec);
     }
 
     /**
@@ -1891,16 +2095,16 @@ public:
         if (!ciphertext1 || !ciphertext2)
             OPENFHE_THROW("Input ciphertext is nullptr");
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext1->GetKeyTag());
+        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(ciphertext1->GetKeyTag());
 
-        if (evalKeyVec.size() <
+        if (evalKeyVec->size() <
             (ciphertext1->NumberCiphertextElements() + ciphertext2->NumberCiphertextElements() - 3)) {
             OPENFHE_THROW(
                 "Insufficient value was used for maxRelinSkDeg to generate "
                 "keys for EvalMult");
         }
 
-        return GetScheme()->EvalMultAndRelinearize(ciphertext1, ciphertext2, evalKeyVec);
+        return GetScheme()->EvalMultAndRelinearize(ciphertext1, ciphertext2, *evalKeyVec);
     }
 
     /**
@@ -2129,8 +2333,8 @@ public:
     Ciphertext<Element> EvalRotate(ConstCiphertext<Element> ciphertext, int32_t index) const {
         ValidateCiphertext(ciphertext);
 
-        auto evalKeyMap = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
-        return GetScheme()->EvalAtIndex(ciphertext, index, evalKeyMap);
+        auto evalKeyMap = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(ciphertext->GetKeyTag());
+        return GetScheme()->EvalAtIndex(ciphertext, index, *evalKeyMap);
     }
 
     /**
@@ -2218,9 +2422,9 @@ public:
    */
     Ciphertext<Element> EvalFastRotationExt(ConstCiphertext<Element> ciphertext, usint index,
                                             const std::shared_ptr<std::vector<Element>> digits, bool addFirst) const {
-        auto evalKeyMap = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
+        auto evalKeyMap = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(ciphertext->GetKeyTag());
 
-        return GetScheme()->EvalFastRotationExt(ciphertext, index, digits, addFirst, evalKeyMap);
+        return GetScheme()->EvalFastRotationExt(ciphertext, index, digits, addFirst, *evalKeyMap);
     }
 
     /**
@@ -2306,6 +2510,30 @@ public:
    */
     Ciphertext<Element> EvalAtIndex(ConstCiphertext<Element> ciphertext, int32_t index) const;
 
+    /**
+   * Rotates a ciphertext by each index of a list using hoisted automorphisms: the digit decomposition
+   * (EvalFastRotationPrecompute) is computed once and the rotations are then run in parallel.
+   * Uses rotation keys stored in a crypto context.
+   * @param ciphertext input ciphertext
+   * @param indices rotation indices (positive index is a left shift, negative index is a right shift)
+   * @return the rotated ciphertexts in the order of indices
+   */
+    std::vector<Ciphertext<Element>> EvalRotateMany(ConstCiphertext<Element> ciphertext,
+                                                    const std::vector<int32_t>& indices) const;
+
+    /**
+   * Only supported for hybrid key switching.
+   * Computes the sum of the rotations of a ciphertext by each index of a list using double hoisting:
+   * the digit decomposition is computed once, the rotations are computed in parallel and accumulated
+   * in the extended CRT basis P*Q, and a single KeySwitchDown (ModDown) brings the sum back to Q.
+   * Uses rotation keys stored in a crypto context.
+   * @param ciphertext input ciphertext
+   * @param indices rotation indices (positive index is a left shift, negative index is a right shift)
+   * @return the sum of the rotated ciphertexts
+   */
+    Ciphertext<Element> EvalRotateManySum(ConstCiphertext<Element> ciphertext,
+                                          const std::vector<int32_t>& indices) const;
+
     //------------------------------------------------------------------------------
     // SHE Leveled Methods Wrapper
     //------------------------------------------------------------------------------
@@ -2321,12 +2549,12 @@ public:
         ValidateCiphertext(ciphertext1);
         ValidateCiphertext(ciphertext2);
 
-        auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext1->GetKeyTag());
-        if (!evalKeyVec.size()) {
+        auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(ciphertext1->GetKeyTag());
+        if (!evalKeyVec->size()) {
             OPENFHE_THROW("Evaluation key has not been generated for EvalMult");
         }
 
-        return GetScheme()->ComposedEvalMult(ciphertext1, ciphertext2, evalKeyVec[0]);
+        return GetScheme()->ComposedEvalMult(ciphertext1, ciphertext2, (*evalKeyVec)[0]);
     }
 
     /**
@@ -2478,12 +2706,12 @@ public:
             return ciphertextVec[0];
         }
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertextVec[0]->GetKeyTag());
-        if (evalKeyVec.size() < (ciphertextVec[0]->NumberCiphertextElements() - 2)) {
+        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(ciphertextVec[0]->GetKeyTag());
+        if (evalKeyVec->size() < (ciphertextVec[0]->NumberCiphertextElements() - 2)) {
             OPENFHE_THROW("Insufficient value was used for maxRelinSkDeg to generate keys");
         }
 
-        return GetScheme()->EvalMultMany(ciphertextVec, evalKeyVec);
+        return GetScheme()->EvalMultMany(ciphertextVec, *evalKeyVec);
     }
 
     //------------------------------------------------------------------------------
@@ -3326,6 +3554,34 @@ public:
         GetScheme()->EvalBootstrapPrecompute(*this, slots);
     }
     /**
+   * Writes the plaintexts precomputed for encoding and decoding by EvalBootstrapSetup/EvalBootstrapPrecompute
+   * to a versioned binary stream, so they can be loaded by other processes instead of being recomputed.
+   * The stream records the ring dimension, the moduli, the number of slots and the level budgets, followed by
+   * the raw coefficients of every plaintext. The data is written in the byte order of the host, which is
+   * recorded in the header: the stream can only be loaded on hosts with the same byte order (and the same
+   * native integer size). LoadEvalBootstrapPrecomputation copies the coefficients; the format is not meant to
+   * be memory-mapped. Supported in CKKS only.
+   *
+   * @param os output stream (should be opened in binary mode)
+   * @param slots number of slots the precomputation was generated for; 0 means ring dimension / 2
+   */
+    void SaveEvalBootstrapPrecomputation(std::ostream& os, uint32_t slots = 0) const {
+        GetScheme()->SaveEvalBootstrapPrecomputation(*this, os, slots);
+    }
+    /**
+   * Loads plaintexts written by SaveEvalBootstrapPrecomputation. It replaces the call to EvalBootstrapSetup,
+   * including the precomputation, for the number of slots stored in the stream. The crypto context must
+   * have the same ring dimension and moduli as the one used to write the stream; the level budgets and the
+   * number of plaintexts in the stream are checked against the ones the number of slots implies. A stream
+   * written on a host with a different byte order is rejected. Supported in CKKS only.
+   *
+   * @param is input stream (should be opened in binary mode)
+   * @return the number of slots of the loaded precomputation
+   */
+    uint32_t LoadEvalBootstrapPrecomputation(std::istream& is) {
+        return GetScheme()->LoadEvalBootstrapPrecomputation(*this, is);
+    }
+    /**
    * Defines the bootstrapping evaluation of ciphertext using either the
    * FFT-like method or the linear method
    *
@@ -3340,6 +3596,31 @@ public:
         return GetScheme()->EvalBootstrap(ciphertext, numIterations, precision);
     }
 
+    /**
+   * Bootstraps a batch of ciphertexts concurrently. Supported in CKKS only.
+   * numWorkers ciphertexts are bootstrapped at the same time and the parallel loops inside every
+   * bootstrapping are capped at machine threads / numWorkers threads, so the split between inter-ciphertext
+   * and intra-operation parallelism can be tuned. The loops only get threads of their own if nested
+   * parallelism is enabled (e.g., OMP_MAX_ACTIVE_LEVELS=2); the OpenMP settings are not changed by the call.
+   * The bootstrapping precomputations and keys are shared read-only by all workers.
+   *
+   * @param ciphertexts the input ciphertexts.
+   * @param numIterations number of iterations to run iterative bootstrapping (Meta-BTS).
+   * @param precision precision of initial bootstrapping algorithm (see EvalBootstrap).
+   * @param numWorkers number of ciphertexts bootstrapped concurrently, at most the batch size; 0 selects
+   * min(batch size, machine threads).
+   * @param stats if not nullptr, receives the wall-clock time and the throughput of the batch.
+   * @return the refreshed ciphertexts in the order of the input.
+   */
+    std::vector<Ciphertext<Element>> EvalBootstrapBatch(const std::vector<Ciphertext<Element>>& ciphertexts,
+                                                        uint32_t numIterations = 1, uint32_t precision = 0,
+                                                        uint32_t numWorkers         = 0,
+                                                        BootstrapBatchStats* stats = nullptr) const {
+        for (const auto& ciphertext : ciphertexts)
+            ValidateCiphertext(ciphertext);
+        return GetScheme()->EvalBootstrapBatch(ciphertexts, numIterations, precision, numWorkers, stats);
+    }
+
     //------------------------------------------------------------------------------
     // Scheme switching Methods
     //------------------------------------------------------------------------------
@@ -36,6 +36,7 @@
 #include "encoding/encodingparams.h"
 #include "schemebase/base-cryptoparameters.h"
 #include "cryptocontextfactory.h"
+#include "math/distributiongenerator.h"
 
 #include <algorithm>
 #include <memory>
@@ -130,6 +131,23 @@ public:
     }
 };
 
+/**
+ * Generates a uniformly random element in EVALUATION format that is fully determined by a seed. Seed-compressed
+ * keys and ciphertexts (see SeedCompression()) store the seed and regenerate the element with the same stream.
+ *
+ * @param seed the seed
+ * @param stream the output stream of the seed, e.g., the digit of an evaluation key
+ * @param params the parameters of the element
+ * @return the element
+ */
+template <typename Element>
+Element GenerateSeededUniform(const PRNGSeed& seed, uint32_t stream,
+                              const std::shared_ptr<typename Element::Params>& params) {
+    typename Element::DugType dug;
+    dug.SetPRNG(PseudoRandomNumberGenerator::CreateSeededPRNG(seed, stream));
+    return Element(dug, params, Format::EVALUATION);
+}
+
 }  // namespace lbcrypto
 
 #endif
@@ -54,6 +54,24 @@ bool PrecomputeCRTTablesAfterDeserializaton();
 void EnablePrecomputeCRTTablesAfterDeserializaton();
 void DisablePrecomputeCRTTablesAfterDeserializaton();
 
+/**
+     * SeedCompression() selects seed-compressed keys and ciphertexts: the uniformly random component of
+     * hybrid evaluation keys, public keys and symmetric CKKS/BGV ciphertexts generated while it is enabled is
+     * derived from a PRNG seed, and serialization stores the seed instead of the element. The element is
+     * regenerated from the seed after deserialization (on first use for evaluation keys).
+     * function's return values:
+     * true:                 seed-compressed objects are generated
+     * false (default value): the random components are sampled and stored in full
+     */
+bool SeedCompression();
+
+/**
+     * Calling EnableSeedCompression() and DisableSeedCompression()
+     * changes the boolean value returned by SeedCompression()
+     */
+void EnableSeedCompression();
+void DisableSeedCompression();
+
 }  // namespace lbcrypto
 
 #endif  // __GLOBALS_H__
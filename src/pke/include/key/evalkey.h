@@ -95,6 +95,17 @@ public:
         OPENFHE_THROW("GetAVector operation not supported");
     }
 
+    /**
+   * Getter function to access Relinearization Element Vector A that keeps the vector alive while the pointer is
+   * held. Throws exception, to be overridden by derived class.
+   *
+   * @return Element vector A.
+   */
+
+    virtual std::shared_ptr<const std::vector<Element>> GetAVectorPtr() const {
+        OPENFHE_THROW("GetAVectorPtr operation not supported");
+    }
+
     /**
    * Setter function to store Relinearization Element Vector B.
    * Throws exception, to be overridden by derived class.
@@ -128,6 +139,17 @@ public:
         OPENFHE_THROW("GetBVector operation not supported");
     }
 
+    /**
+   * Getter function to access Relinearization Element Vector B that keeps the vector alive while the pointer is
+   * held. Throws exception, to be overridden by derived class.
+   *
+   * @return Element vector B.
+   */
+
+    virtual std::shared_ptr<const std::vector<Element>> GetBVectorPtr() const {
+        OPENFHE_THROW("GetBVectorPtr operation not supported");
+    }
+
     /**
    * Setter function to store key switch Element.
    * Throws exception, to be overridden by derived class.
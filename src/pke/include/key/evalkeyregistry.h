@@ -0,0 +1,138 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  Thread-safe registry of evaluation keys by secret key tag
+ */
+
+#ifndef LBCRYPTO_CRYPTO_KEY_EVALKEYREGISTRY_H
+#define LBCRYPTO_CRYPTO_KEY_EVALKEYREGISTRY_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+/**
+ * @namespace lbcrypto
+ * The namespace of lbcrypto
+ */
+namespace lbcrypto {
+
+/**
+ * @brief Copy-on-write map from secret key tags to evaluation keys.
+ * Readers take an immutable snapshot of the map without locks or retries: a read-side critical section is two
+ * atomic counter updates around the copy of the current snapshot pointer, which is wait-free. Writers are serialized
+ * with each other; each update copies the map, which only holds pointers to the keys, publishes the copy and
+ * frees the previous holder of the snapshot once the readers that may still be copying it have left (a grace period
+ * in the sense of RCU, tracked with two reader counters that alternate between grace periods). The keys of a tag are
+ * never modified after they are published: updates replace or erase them, so a reader holding the keys of one tag is
+ * not affected by updates of the same or any other tag.
+ * @tparam Value the keys stored for one tag.
+ */
+template <typename Value>
+class EvalKeyRegistry {
+public:
+    using Map = std::map<std::string, std::shared_ptr<const Value>>;
+
+    EvalKeyRegistry() : m_current(new std::shared_ptr<const Map>(std::make_shared<const Map>())) {}
+
+    ~EvalKeyRegistry() {
+        delete m_current.load(std::memory_order_relaxed);
+    }
+
+    EvalKeyRegistry(const EvalKeyRegistry&)            = delete;
+    EvalKeyRegistry& operator=(const EvalKeyRegistry&) = delete;
+
+    /**
+   * @return the current contents of the registry, which stay unchanged for as long as they are held.
+   */
+    std::shared_ptr<const Map> Snapshot() const {
+        // any counter works for correctness since writers wait for both; alternating them lets writers finish
+        auto& readers = m_readers[m_epoch.load(std::memory_order_relaxed) & 1].count;
+        readers.fetch_add(1, std::memory_order_seq_cst);
+        std::shared_ptr<const Map> snapshot = *m_current.load(std::memory_order_seq_cst);
+        readers.fetch_sub(1, std::memory_order_release);
+        return snapshot;
+    }
+
+    /**
+   * @return the keys for the given tag or nullptr if there are none.
+   */
+    std::shared_ptr<const Value> Find(const std::string& keyTag) const {
+        const auto snapshot = Snapshot();
+        const auto it       = snapshot->find(keyTag);
+        return (it == snapshot->end()) ? nullptr : it->second;
+    }
+
+    /**
+   * Applies update to a copy of the contents and publishes the copy. If update throws, nothing is published.
+   * update may insert, replace or erase entries but must not modify the keys the entries point to.
+   *
+   * @param update callable taking a Map&.
+   */
+    template <typename Func>
+    void Update(Func&& update) {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        auto next = std::make_shared<Map>(**m_current.load(std::memory_order_relaxed));
+        update(*next);
+        auto holder = std::make_unique<std::shared_ptr<const Map>>(std::move(next));
+        std::unique_ptr<std::shared_ptr<const Map>> previous(
+            m_current.exchange(holder.release(), std::memory_order_seq_cst));
+        // a reader that registers after a counter is seen at zero loads the new holder (all these accesses are
+        // sequentially consistent), so the previous one can be freed once both counters were seen at zero
+        for (uint32_t phase = 0; phase < 2; ++phase) {
+            const auto& readers = m_readers[m_epoch.fetch_add(1, std::memory_order_seq_cst) & 1].count;
+            while (readers.load(std::memory_order_seq_cst) != 0)
+                std::this_thread::yield();
+        }
+    }
+
+private:
+    struct alignas(64) ReaderCount {
+        std::atomic<uint64_t> count{0};
+    };
+
+    // holder of the current snapshot; readers copy the shared_ptr it holds
+    std::atomic<std::shared_ptr<const Map>*> m_current;
+    mutable ReaderCount m_readers[2];
+    std::atomic<uint32_t> m_epoch{0};
+    std::mutex m_writeMutex;
+};
+
+}  // namespace lbcrypto
+
+#endif
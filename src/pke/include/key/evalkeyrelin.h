@@ -34,8 +34,11 @@
 
 #include "key/evalkeyrelin-fwd.h"
 #include "key/evalkey.h"
+#include "key/evalkeystore.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <utility>
@@ -63,26 +66,33 @@ public:
    */
     explicit EvalKeyRelinImpl(CryptoContext<Element> cc = 0) : EvalKeyImpl<Element>(cc) {}
 
-    virtual ~EvalKeyRelinImpl() {}
+    virtual ~EvalKeyRelinImpl() {
+        ReleaseStore();
+    }
 
     /**
    * Copy constructor
    *
    *@param &rhs key to copy from
    */
-    explicit EvalKeyRelinImpl(const EvalKeyRelinImpl<Element>& rhs)
-        : EvalKeyImpl<Element>(rhs.GetCryptoContext()), m_rKey(rhs.m_rKey) {}
+    explicit EvalKeyRelinImpl(const EvalKeyRelinImpl<Element>& rhs) : EvalKeyImpl<Element>(rhs.GetCryptoContext()) {
+        m_rKey = rhs.Materialize();
+        CopySeed(rhs);
+    }
 
     /**
-   * Move constructor
+   * Move constructor. Not noexcept: a key read from an EvalKeyStore is moved as a plain key, which reads it
+   * from the store if it is not loaded.
    *
    *@param &rhs key to move from
    */
-    explicit EvalKeyRelinImpl(EvalKeyRelinImpl<Element>&& rhs) noexcept
-        : EvalKeyImpl<Element>(rhs.GetCryptoContext()), m_rKey(std::move(rhs.m_rKey)) {}
+    explicit EvalKeyRelinImpl(EvalKeyRelinImpl<Element>&& rhs) : EvalKeyImpl<Element>(rhs.GetCryptoContext()) {
+        m_rKey = rhs.TakeKey();
+        CopySeed(rhs);
+    }
 
     operator bool() const {
-        return static_cast<bool>(this->context) && m_rKey.size() != 0;
+        return static_cast<bool>(this->context) && (m_store != nullptr || m_rKey->size() != 0);
     }
 
     /**
@@ -91,8 +101,11 @@ public:
    * @param &rhs key to copy from
    */
     EvalKeyRelinImpl<Element>& operator=(const EvalKeyRelinImpl<Element>& rhs) {
+        auto rKey = rhs.Materialize();
+        ReleaseStore();
         this->context = rhs.context;
-        this->m_rKey  = rhs.m_rKey;
+        this->m_rKey  = std::move(rKey);
+        CopySeed(rhs);
         return *this;
     }
 
@@ -102,9 +115,12 @@ public:
    * @param &rhs key to move from
    */
     EvalKeyRelinImpl<Element>& operator=(EvalKeyRelinImpl<Element>&& rhs) {
+        auto rKey = rhs.TakeKey();
+        ReleaseStore();
         this->context = rhs.context;
         rhs.context   = 0;
-        m_rKey        = std::move(rhs.m_rKey);
+        m_rKey        = std::move(rKey);
+        CopySeed(rhs);
         return *this;
     }
 
@@ -115,7 +131,9 @@ public:
    * @param &a is the Element vector to be copied.
    */
     virtual void SetAVector(const std::vector<Element>& a) {
-        m_rKey.insert(m_rKey.begin() + 0, a);
+        auto& rKey = MutableKey();
+        rKey.insert(rKey.begin() + 0, a);
+        m_seeded = false;
     }
 
     /**
@@ -125,17 +143,104 @@ public:
    * @param &&a is the Element vector to be moved.
    */
     virtual void SetAVector(std::vector<Element>&& a) {
-        m_rKey.insert(m_rKey.begin() + 0, std::move(a));
+        auto& rKey = MutableKey();
+        rKey.insert(rKey.begin() + 0, std::move(a));
+        m_seeded = false;
     }
 
     /**
    * Getter function to access Relinearization Element Vector A.
-   * Overrides base class implementation.
+   * Overrides base class implementation. For a key read from an EvalKeyStore with a memory budget, the reference
+   * is only valid until the store unloads the key; use GetAVectorPtr() to keep the vector alive.
    *
    * @return Element vector A.
    */
     virtual const std::vector<Element>& GetAVector() const {
-        return m_rKey.at(0);
+        return Materialize()->at(0);
+    }
+
+    /**
+   * Getter function to access Relinearization Element Vector A.
+   * Overrides base class implementation.
+   *
+   * @return Element vector A, which stays valid while the pointer is held even if the key is unloaded.
+   */
+    virtual std::shared_ptr<const std::vector<Element>> GetAVectorPtr() const {
+        return Pin(0);
+    }
+
+    /**
+   * Records that every element of vector A was generated by GenerateSeededUniform() from the given seed, with
+   * the index of the element as the stream and the parameters of the matching element of vector B.
+   * Serialization then stores the seed instead of vector A.
+   * Must be called after SetAVector and SetBVector.
+   *
+   * @param &seed is the seed of vector A.
+   */
+    void SetAVectorSeed(const PRNGSeed& seed) {
+        m_seed         = seed;
+        m_seeded       = true;
+        m_seedExpanded = true;
+    }
+
+    /**
+   * @return true if vector A can be regenerated from a seed.
+   */
+    bool IsSeeded() const {
+        return m_seeded;
+    }
+
+    /**
+   * Turns the key into a placeholder for the key with the given automorphism index in an EvalKeyStore.
+   * Vectors A and B are read from the store when they are first accessed and may be unloaded by the store
+   * afterwards, in which case they are read again on their next access.
+   *
+   * @param store the store holding the key.
+   * @param index automorphism index of the key in the store.
+   */
+    void SetStore(const std::shared_ptr<EvalKeyStore<Element>>& store, uint32_t index) {
+        ReleaseStore();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_rKey       = std::make_shared<KeyVectors>();
+        m_seeded     = false;
+        m_store      = store;
+        m_storeIndex = index;
+        m_seedExpanded.store(true, std::memory_order_release);
+        m_loaded.store(false, std::memory_order_release);
+    }
+
+    /**
+   * Drops vectors A and B of a key read from an EvalKeyStore; they are read again on their next access.
+   * Vectors pinned by GetAVectorPtr()/GetBVectorPtr() are freed when the last pointer is released.
+   * Does nothing for other keys.
+   */
+    void Unload() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_store)
+            return;
+        m_loaded.store(false, std::memory_order_release);
+        m_rKey = std::make_shared<KeyVectors>();
+    }
+
+    /**
+   * @return false if the key is a placeholder whose vectors have not been read from its EvalKeyStore.
+   */
+    bool IsLoaded() const {
+        return m_loaded.load(std::memory_order_acquire);
+    }
+
+    /**
+   * Moves vectors A and B out of the key, which is left empty. The vectors are copied only if they are shared
+   * with a copy of the key or pinned by a reader.
+   *
+   * @return vectors A and B of the key.
+   */
+    std::vector<std::vector<Element>> TakeVectors() {
+        ExpandAVector();
+        auto rKey = TakeKey();
+        if (rKey.use_count() == 1)
+            return std::move(*rKey);
+        return *rKey;
     }
 
     /**
@@ -145,7 +250,8 @@ public:
    * @param &b is the Element vector to be copied.
    */
     virtual void SetBVector(const std::vector<Element>& b) {
-        m_rKey.insert(m_rKey.begin() + 1, b);
+        auto& rKey = MutableKey();
+        rKey.insert(rKey.begin() + 1, b);
     }
 
     /**
@@ -155,17 +261,29 @@ public:
    * @param &&b is the Element vector to be moved.
    */
     virtual void SetBVector(std::vector<Element>&& b) {
-        m_rKey.insert(m_rKey.begin() + 1, std::move(b));
+        auto& rKey = MutableKey();
+        rKey.insert(rKey.begin() + 1, std::move(b));
     }
 
     /**
    * Getter function to access Relinearization Element Vector B.
-   * Overrides base class implementation.
+   * Overrides base class implementation. For a key read from an EvalKeyStore with a memory budget, the reference
+   * is only valid until the store unloads the key; use GetBVectorPtr() to keep the vector alive.
    *
    * @return Element vector B.
    */
     virtual const std::vector<Element>& GetBVector() const {
-        return m_rKey.at(1);
+        return Materialize()->at(1);
+    }
+
+    /**
+   * Getter function to access Relinearization Element Vector B.
+   * Overrides base class implementation.
+   *
+   * @return Element vector B, which stays valid while the pointer is held even if the key is unloaded.
+   */
+    virtual std::shared_ptr<const std::vector<Element>> GetBVectorPtr() const {
+        return Pin(1);
     }
 
     /**
@@ -233,8 +351,10 @@ public:
     }
 
     virtual void ClearKeys() {
-        m_rKey.clear();
+        ReleaseStore();
+        m_rKey = std::make_shared<KeyVectors>();
         m_dcrtKeys.clear();
+        m_seeded = false;
     }
 
     bool key_compare(const EvalKeyImpl<Element>& other) const {
@@ -243,13 +363,15 @@ public:
         if (!CryptoObject<Element>::operator==(other))
             return false;
 
-        if (this->m_rKey.size() != oth.m_rKey.size())
+        const auto rKey    = this->PinAll();
+        const auto othRKey = oth.PinAll();
+        if (rKey->size() != othRKey->size())
             return false;
-        for (size_t i = 0; i < this->m_rKey.size(); i++) {
-            if (this->m_rKey[i].size() != oth.m_rKey[i].size())
+        for (size_t i = 0; i < rKey->size(); i++) {
+            if ((*rKey)[i].size() != (*othRKey)[i].size())
                 return false;
-            for (size_t j = 0; j < this->m_rKey[i].size(); j++) {
-                if (this->m_rKey[i][j] != oth.m_rKey[i][j])
+            for (size_t j = 0; j < (*rKey)[i].size(); j++) {
+                if ((*rKey)[i][j] != (*othRKey)[i][j])
                     return false;
             }
         }
@@ -258,8 +380,18 @@ public:
 
     template <class Archive>
     void save(Archive& ar, std::uint32_t const version) const {
+        const auto rKey = PinAll();
         ar(::cereal::base_class<EvalKeyImpl<Element>>(this));
-        ar(::cereal::make_nvp("k", m_rKey));
+        ar(::cereal::make_nvp("sd", m_seeded));
+        if (m_seeded) {
+            // an empty vector A is followed by its seed
+            KeyVectors seededKey{std::vector<Element>(), rKey->at(1)};
+            ar(::cereal::make_nvp("k", seededKey));
+            ar(::cereal::make_nvp("s", m_seed));
+        }
+        else {
+            ar(::cereal::make_nvp("k", *rKey));
+        }
     }
 
     template <class Archive>
@@ -269,18 +401,147 @@ public:
                           " is from a later version of the library");
         }
         ar(::cereal::base_class<EvalKeyImpl<Element>>(this));
-        ar(::cereal::make_nvp("k", m_rKey));
+        // seed-compressed keys exist since version 2, which records whether the key is seeded
+        m_seeded = false;
+        if (version >= 2)
+            ar(::cereal::make_nvp("sd", m_seeded));
+        m_rKey = std::make_shared<KeyVectors>();
+        ar(::cereal::make_nvp("k", *m_rKey));
+        if (m_seeded) {
+            if (m_rKey->size() != 2 || !(*m_rKey)[0].empty() || (*m_rKey)[1].empty())
+                OPENFHE_THROW("a seeded evaluation key must hold an empty vector A and a non-empty vector B");
+            ar(::cereal::make_nvp("s", m_seed));
+        }
+        // vector A is regenerated on first use
+        m_seedExpanded = !m_seeded;
     }
     std::string SerializedObjectName() const {
         return "EvalKeyRelin";
     }
     static uint32_t SerializedVersion() {
-        return 1;
+        return 2;
     }
 
 private:
-    // private member to store vector of vector of Element.
-    std::vector<std::vector<Element>> m_rKey;
+    using KeyVectors = std::vector<std::vector<Element>>;
+
+    // the vectors of a key that is being modified; copies them first if they are shared with a copy of the key
+    // or pinned by a reader
+    KeyVectors& MutableKey() {
+        if (m_rKey.use_count() > 1)
+            m_rKey = std::make_shared<KeyVectors>(*m_rKey);
+        return *m_rKey;
+    }
+
+    // the materialized vectors, kept alive for the caller even if the store unloads the key meanwhile
+    std::shared_ptr<const KeyVectors> PinAll() const {
+        return Materialize();
+    }
+
+    std::shared_ptr<const std::vector<Element>> Pin(size_t i) const {
+        auto rKey = PinAll();
+        return std::shared_ptr<const std::vector<Element>>(rKey, &rKey->at(i));
+    }
+
+    void CopySeed(const EvalKeyRelinImpl<Element>& rhs) {
+        m_seed         = rhs.m_seed;
+        m_seeded       = rhs.m_seeded;
+        m_seedExpanded = rhs.m_seedExpanded.load(std::memory_order_acquire);
+    }
+
+    // makes both vectors available and returns them: reads a placeholder key from its store and regenerates
+    // vector A of a deserialized seed-compressed key; safe to call from several threads. The store may unload the
+    // key at any time, so m_rKey of a placeholder is only read and replaced with m_mutex held.
+    std::shared_ptr<KeyVectors> Materialize() const {
+        if (m_store)
+            return LoadFromStore();
+        ExpandAVector();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_rKey;
+    }
+
+    // returns the vectors of a placeholder key, reading them from the store if they are not loaded
+    std::shared_ptr<KeyVectors> LoadFromStore() const {
+        std::shared_ptr<KeyVectors> rKey;
+        size_t bytes = 0;
+        bool read    = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_loaded.load(std::memory_order_relaxed)) {
+                rKey = m_rKey;
+            }
+            else {
+                read = true;
+                rKey = std::make_shared<KeyVectors>(m_store->Load(m_storeIndex));
+                for (const auto& v : *rKey) {
+                    for (const auto& e : v)
+                        bytes += size_t(e.GetRingDimension()) * e.GetNumOfElements() * sizeof(uint64_t);
+                }
+                m_rKey = rKey;
+                m_loaded.store(true, std::memory_order_release);
+            }
+        }
+        // may unload keys of the store, this one included, so it is called without holding the lock; rKey keeps
+        // the vectors for the caller
+        if (read)
+            m_store->Loaded(m_storeIndex, bytes);
+        else
+            m_store->Touch(m_storeIndex);
+        return rKey;
+    }
+
+    // takes the vectors out of the key and turns it into an empty plain key
+    std::shared_ptr<KeyVectors> TakeKey() {
+        std::shared_ptr<KeyVectors> rKey = m_store ? LoadFromStore() : m_rKey;
+        ReleaseStore();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_rKey = std::make_shared<KeyVectors>();
+        return rKey;
+    }
+
+    // turns a placeholder into a plain key that keeps its current vectors
+    void ReleaseStore() {
+        std::shared_ptr<EvalKeyStore<Element>> store;
+        bool loaded = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            store  = std::move(m_store);
+            loaded = m_loaded.exchange(true, std::memory_order_acq_rel);
+        }
+        if (store && loaded)
+            store->Unloaded(m_storeIndex);
+    }
+
+    void ExpandAVector() const {
+        if (m_seedExpanded.load(std::memory_order_acquire))
+            return;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_seedExpanded.load(std::memory_order_relaxed))
+            return;
+        const auto& b = m_rKey->at(1);
+        std::vector<Element> a;
+        a.reserve(b.size());
+        for (size_t i = 0; i < b.size(); ++i)
+            a.push_back(GenerateSeededUniform<Element>(m_seed, i, b[i].GetParams()));
+        // vector A is only generated before the vectors are handed out, so nobody reads them yet
+        (*m_rKey)[0] = std::move(a);
+        m_seedExpanded.store(true, std::memory_order_release);
+    }
+
+    // vectors A and B; shared with copies of the key and with the readers that pinned them, and replaced
+    // (never modified in place) once handed out. Guarded by m_mutex for keys read from an EvalKeyStore
+    mutable std::shared_ptr<KeyVectors> m_rKey{std::make_shared<KeyVectors>()};
+
+    // seed of vector A for seed-compressed keys
+    PRNGSeed m_seed{};
+    bool m_seeded{false};
+    mutable std::atomic<bool> m_seedExpanded{true};
+    mutable std::mutex m_mutex;
+
+    // store of a key that is read on first use
+    std::shared_ptr<EvalKeyStore<Element>> m_store;
+    uint32_t m_storeIndex{0};
+    mutable std::atomic<bool> m_loaded{true};
 
     // Used for hybrid key switching
     std::vector<DCRTPoly> m_dcrtKeys;
@@ -0,0 +1,383 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  Read-on-demand storage for evaluation keys saved with CryptoContextImpl::SerializeEvalAutomorphismKeyStore()
+ */
+
+#ifndef LBCRYPTO_CRYPTO_KEY_EVALKEYSTORE_H
+#define LBCRYPTO_CRYPTO_KEY_EVALKEYSTORE_H
+
+#include "key/evalkey-fwd.h"
+#include "key/evalkeyrelin-fwd.h"
+#include "utils/exception.h"
+
+#ifdef PARALLEL
+    #include <omp.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @namespace lbcrypto
+ * The namespace of lbcrypto
+ */
+namespace lbcrypto {
+
+/**
+ * @brief Read-only stream buffer over a serialized key, so that the key can be deserialized without copying it
+ * into a string stream.
+ */
+class EvalKeyBlobBuffer : public std::streambuf {
+public:
+    EvalKeyBlobBuffer(char* data, size_t size) {
+        setg(data, data, data + size);
+    }
+};
+
+/**
+ * @brief Backing store of evaluation keys that are read from an indexed key file when they are first used.
+ * The keys handed out by the store are EvalKeyRelinImpl placeholders that call Load() on first access. When a
+ * memory budget is set, the least recently used keys are unloaded once the loaded keys exceed the budget; unloaded
+ * keys are read again on their next use. Keys are only unloaded outside of OpenMP parallel regions, so the keys
+ * used by a parallel loop stay valid until the loop ends and the budget may be exceeded temporarily.
+ * The keys may be used from several threads at the same time: a key can be unloaded while another thread uses it,
+ * and the vectors returned by GetAVectorPtr()/GetBVectorPtr() stay valid until the pointers are released.
+ * @tparam Element a ring element.
+ */
+template <class Element>
+class EvalKeyStore {
+public:
+    // deserializes one key from its serialized blob
+    using KeyReader = std::function<EvalKey<Element>(std::istream&)>;
+
+    // offset and size of every key blob in the file, by automorphism index
+    using KeyIndex = std::map<uint32_t, std::pair<uint64_t, uint64_t>>;
+
+    /**
+   * @param filename key file with the key blobs
+   * @param index position of every key blob in the file
+   * @param reader deserializes a key blob
+   * @param memoryBudget maximum number of bytes of loaded keys; 0 means no limit
+   */
+    EvalKeyStore(const std::string& filename, KeyIndex index, KeyReader reader, size_t memoryBudget = 0)
+        : m_file(filename, std::ios::in | std::ios::binary),
+          m_index(std::move(index)),
+          m_reader(std::move(reader)),
+          m_budget(memoryBudget) {
+        if (!m_file.is_open())
+            OPENFHE_THROW("Cannot open the key store file [" + filename + "]");
+    }
+
+    /**
+   * Records the placeholder key the store loads for the given automorphism index, so that the store can unload it.
+   */
+    void Register(uint32_t index, const std::shared_ptr<EvalKeyRelinImpl<Element>>& key) {
+        std::lock_guard<std::mutex> lock(m_lruMutex);
+        m_keys[index] = key;
+    }
+
+    /**
+   * Reads the key for the given automorphism index from the key file.
+   *
+   * @return vectors A and B of the key.
+   */
+    std::vector<std::vector<Element>> Load(uint32_t index) {
+        auto it = m_index.find(index);
+        if (it == m_index.end())
+            OPENFHE_THROW("No key for index [" + std::to_string(index) + "] in the key store");
+
+        std::string blob(it->second.second, '\0');
+        {
+            std::lock_guard<std::mutex> lock(m_fileMutex);
+            m_file.clear();
+            m_file.seekg(static_cast<std::streamoff>(it->second.first));
+            m_file.read(&blob[0], static_cast<std::streamsize>(blob.size()));
+            if (!m_file)
+                OPENFHE_THROW("Cannot read the key for index [" + std::to_string(index) + "] from the key store");
+        }
+        EvalKeyBlobBuffer buffer(&blob[0], blob.size());
+        std::istream is(&buffer);
+        // the key was just deserialized and is not shared, so its vectors are moved out of it
+        auto key = std::static_pointer_cast<EvalKeyRelinImpl<Element>>(m_reader(is));
+        return key->TakeVectors();
+    }
+
+    /**
+   * Marks a freshly loaded key as the most recently used one and unloads the least recently used keys if the
+   * budget is exceeded.
+   *
+   * @param index automorphism index of the loaded key
+   * @param bytes memory used by the key
+   */
+    void Loaded(uint32_t index, size_t bytes) {
+        std::vector<std::shared_ptr<EvalKeyRelinImpl<Element>>> victims;
+        {
+            std::lock_guard<std::mutex> lock(m_lruMutex);
+            auto pos = m_position.find(index);
+            if (pos != m_position.end()) {
+                m_loadedBytes -= pos->second->second;
+                m_lru.erase(pos->second);
+            }
+            m_lru.emplace_front(index, bytes);
+            m_position[index] = m_lru.begin();
+            m_loadedBytes += bytes;
+            SelectVictims(victims);
+        }
+        // unload outside of the lock: a key being loaded holds its own lock while it calls Load()
+        for (auto& key : victims)
+            key->Unload();
+    }
+
+    /**
+   * Marks an already loaded key as the most recently used one. Also unloads the least recently used keys if the
+   * budget was exceeded by keys loaded in a parallel region.
+   */
+    void Touch(uint32_t index) {
+        if (m_budget == 0)
+            return;
+        std::vector<std::shared_ptr<EvalKeyRelinImpl<Element>>> victims;
+        {
+            std::lock_guard<std::mutex> lock(m_lruMutex);
+            auto pos = m_position.find(index);
+            if (pos != m_position.end())
+                m_lru.splice(m_lru.begin(), m_lru, pos->second);
+            SelectVictims(victims);
+        }
+        for (auto& key : victims)
+            key->Unload();
+    }
+
+    /**
+   * Forgets a key that was unloaded or dropped by its owner.
+   */
+    void Unloaded(uint32_t index) {
+        std::lock_guard<std::mutex> lock(m_lruMutex);
+        auto pos = m_position.find(index);
+        if (pos != m_position.end()) {
+            m_loadedBytes -= pos->second->second;
+            m_lru.erase(pos->second);
+            m_position.erase(pos);
+        }
+    }
+
+    size_t GetMemoryBudget() const {
+        return m_budget;
+    }
+
+    /**
+   * @return the number of bytes of keys currently loaded.
+   */
+    size_t GetLoadedBytes() const {
+        std::lock_guard<std::mutex> lock(m_lruMutex);
+        return m_loadedBytes;
+    }
+
+    /**
+   * Writes the header of a key file: the key tag, the serialized crypto context and the offset and size of every
+   * key blob. The header size only depends on the key tag, the context and the number of keys, so the header can be
+   * written again once the key blobs following it are written.
+   */
+    static void WriteHeader(std::ostream& os, const std::string& keyTag, const std::string& context,
+                            const KeyIndex& index) {
+        os.write(MAGIC, sizeof(MAGIC));
+        WriteValue<uint32_t>(os, FORMAT_VERSION);
+        WriteString(os, keyTag);
+        WriteString(os, context);
+        WriteValue<uint64_t>(os, index.size());
+        for (const auto& entry : index) {
+            WriteValue<uint32_t>(os, entry.first);
+            WriteValue<uint64_t>(os, entry.second.first);
+            WriteValue<uint64_t>(os, entry.second.second);
+        }
+        if (!os)
+            OPENFHE_THROW("Cannot write the key store header");
+    }
+
+    /**
+   * Reads the header written by WriteHeader().
+   *
+   * @return the offset and size of every key blob.
+   */
+    static KeyIndex ReadHeader(std::istream& is, std::string& keyTag, std::string& context) {
+        char magic[sizeof(MAGIC)];
+        is.read(magic, sizeof(magic));
+        if (!is || !std::equal(magic, magic + sizeof(magic), MAGIC))
+            OPENFHE_THROW("The file is not a key store");
+        const auto version = ReadValue<uint32_t>(is);
+        if (version > FORMAT_VERSION)
+            OPENFHE_THROW("key store version " + std::to_string(version) + " is from a later version of the library");
+        keyTag  = ReadString(is);
+        context = ReadString(is);
+        KeyIndex index;
+        for (auto n = ReadValue<uint64_t>(is); n > 0; --n) {
+            const auto autoIndex = ReadValue<uint32_t>(is);
+            const auto offset    = ReadValue<uint64_t>(is);
+            index[autoIndex]     = {offset, ReadValue<uint64_t>(is)};
+        }
+        return index;
+    }
+
+    /**
+   * Writes the header of a key stream: the key tag and the number of keys that follow. Every key is written with
+   * WriteStreamKey() as its automorphism index, the size of its blob and the blob, so that a reader can skip keys
+   * without deserializing them and no index has to be written in advance.
+   */
+    static void WriteStreamHeader(std::ostream& os, const std::string& keyTag, uint64_t count) {
+        os.write(STREAM_MAGIC, sizeof(STREAM_MAGIC));
+        WriteValue<uint32_t>(os, FORMAT_VERSION);
+        WriteString(os, keyTag);
+        WriteValue<uint64_t>(os, count);
+        if (!os)
+            OPENFHE_THROW("Cannot write the key stream header");
+    }
+
+    /**
+   * Reads the header written by WriteStreamHeader().
+   *
+   * @return the number of keys in the stream.
+   */
+    static uint64_t ReadStreamHeader(std::istream& is, std::string& keyTag) {
+        char magic[sizeof(STREAM_MAGIC)];
+        is.read(magic, sizeof(magic));
+        if (!is || !std::equal(magic, magic + sizeof(magic), STREAM_MAGIC))
+            OPENFHE_THROW("The stream is not a key stream");
+        const auto version = ReadValue<uint32_t>(is);
+        if (version > FORMAT_VERSION)
+            OPENFHE_THROW("key stream version " + std::to_string(version) + " is from a later version of the library");
+        keyTag = ReadString(is);
+        return ReadValue<uint64_t>(is);
+    }
+
+    /**
+   * Writes one serialized key of a key stream.
+   */
+    static void WriteStreamKey(std::ostream& os, uint32_t index, const std::string& blob) {
+        WriteValue<uint32_t>(os, index);
+        WriteString(os, blob);
+        if (!os)
+            OPENFHE_THROW("Cannot write the key for index [" + std::to_string(index) + "] to the key stream");
+    }
+
+    /**
+   * Reads the automorphism index and the blob size of the next key of a key stream; the blob follows.
+   */
+    static std::pair<uint32_t, uint64_t> ReadStreamKey(std::istream& is) {
+        const auto index = ReadValue<uint32_t>(is);
+        return {index, ReadValue<uint64_t>(is)};
+    }
+
+private:
+    static constexpr char MAGIC[8]           = {'O', 'F', 'H', 'E', 'K', 'E', 'Y', 'S'};
+    static constexpr char STREAM_MAGIC[8]    = {'O', 'F', 'H', 'E', 'K', 'S', 'T', 'R'};
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    template <typename T>
+    static void WriteValue(std::ostream& os, T value) {
+        os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    static T ReadValue(std::istream& is) {
+        T value;
+        if (!is.read(reinterpret_cast<char*>(&value), sizeof(T)))
+            OPENFHE_THROW("Unexpected end of the key data");
+        return value;
+    }
+
+    static void WriteString(std::ostream& os, const std::string& str) {
+        WriteValue<uint64_t>(os, str.size());
+        os.write(str.data(), static_cast<std::streamsize>(str.size()));
+    }
+
+    static std::string ReadString(std::istream& is) {
+        std::string str(ReadValue<uint64_t>(is), '\0');
+        if (!is.read(&str[0], static_cast<std::streamsize>(str.size())))
+            OPENFHE_THROW("Unexpected end of the key data");
+        return str;
+    }
+
+    // removes the least recently used keys from the list until the budget is met, never the most recently used one;
+    // must be called with m_lruMutex held
+    void SelectVictims(std::vector<std::shared_ptr<EvalKeyRelinImpl<Element>>>& victims) {
+        if (m_budget == 0 || InParallel())
+            return;
+        while (m_loadedBytes > m_budget && m_lru.size() > 1) {
+            auto& victim = m_lru.back();
+            auto key     = m_keys[victim.first].lock();
+            if (key)
+                victims.push_back(std::move(key));
+            m_loadedBytes -= victim.second;
+            m_position.erase(victim.first);
+            m_lru.pop_back();
+        }
+    }
+
+    static bool InParallel() {
+#ifdef PARALLEL
+        return omp_in_parallel();
+#else
+        return false;
+#endif
+    }
+
+    std::ifstream m_file;
+    std::mutex m_fileMutex;
+    const KeyIndex m_index;
+    const KeyReader m_reader;
+    const size_t m_budget;
+
+    // loaded keys, most recently used first, with their size in bytes
+    std::list<std::pair<uint32_t, size_t>> m_lru;
+    std::unordered_map<uint32_t, typename std::list<std::pair<uint32_t, size_t>>::iterator> m_position;
+    std::unordered_map<uint32_t, std::weak_ptr<EvalKeyRelinImpl<Element>>> m_keys;
+    size_t m_loadedBytes{0};
+    mutable std::mutex m_lruMutex;
+};
+
+}  // namespace lbcrypto
+
+#endif
@@ -71,7 +71,10 @@ public:
    *@param &rhs PublicKeyImpl to copy from
    */
     explicit PublicKeyImpl(const PublicKeyImpl<Element>& rhs)
-        : Key<Element>(rhs.GetCryptoContext(), rhs.GetKeyTag()), m_h(rhs.m_h) {}
+        : Key<Element>(rhs.GetCryptoContext(), rhs.GetKeyTag()),
+          m_h(rhs.m_h),
+          m_seed(rhs.m_seed),
+          m_seeded(rhs.m_seeded) {}
 
     /**
    * Move constructor
@@ -79,7 +82,10 @@ public:
    *@param &rhs PublicKeyImpl to move from
    */
     explicit PublicKeyImpl(PublicKeyImpl<Element>&& rhs) noexcept
-        : Key<Element>(rhs.GetCryptoContext(), rhs.GetKeyTag()), m_h(std::move(rhs.m_h)) {}
+        : Key<Element>(rhs.GetCryptoContext(), rhs.GetKeyTag()),
+          m_h(std::move(rhs.m_h)),
+          m_seed(rhs.m_seed),
+          m_seeded(rhs.m_seeded) {}
 
     operator bool() const {
         return static_cast<bool>(this->context) && m_h.size() != 0;
@@ -92,7 +98,9 @@ public:
    */
     PublicKeyImpl<Element>& operator=(const PublicKeyImpl<Element>& rhs) {
         CryptoObject<Element>::operator=(rhs);
-        this->m_h = rhs.m_h;
+        this->m_h      = rhs.m_h;
+        this->m_seed   = rhs.m_seed;
+        this->m_seeded = rhs.m_seeded;
         return *this;
     }
 
@@ -103,7 +111,9 @@ public:
    */
     PublicKeyImpl<Element>& operator=(PublicKeyImpl<Element>&& rhs) {
         CryptoObject<Element>::operator=(rhs);
-        m_h = std::move(rhs.m_h);
+        m_h      = std::move(rhs.m_h);
+        m_seed   = rhs.m_seed;
+        m_seeded = rhs.m_seeded;
         return *this;
     }
 
@@ -124,7 +134,8 @@ public:
    * @param &element is the public key Element vector to be copied.
    */
     void SetPublicElements(const std::vector<Element>& element) {
-        m_h = element;
+        m_h      = element;
+        m_seeded = false;
     }
 
     /**
@@ -132,7 +143,8 @@ public:
    * @param &&element is the public key Element vector to be moved.
    */
     void SetPublicElements(std::vector<Element>&& element) {
-        m_h = std::move(element);
+        m_h      = std::move(element);
+        m_seeded = false;
     }
 
     /**
@@ -141,6 +153,7 @@ public:
    */
     void SetPublicElementAtIndex(usint idx, const Element& element) {
         m_h.insert(m_h.begin() + idx, element);
+        m_seeded = false;
     }
 
     /**
@@ -149,6 +162,25 @@ public:
    */
     void SetPublicElementAtIndex(usint idx, Element&& element) {
         m_h.insert(m_h.begin() + idx, std::move(element));
+        m_seeded = false;
+    }
+
+    /**
+   * Records that the second public key Element was generated by GenerateSeededUniform() from the given seed
+   * (stream 0, parameters of the first Element). Serialization then stores the seed instead of the Element.
+   * Must be called after SetPublicElements.
+   * @param &seed is the seed of the second Element.
+   */
+    void SetPublicElementsSeed(const PRNGSeed& seed) {
+        m_seed   = seed;
+        m_seeded = true;
+    }
+
+    /**
+   * @return true if the second public key Element can be regenerated from a seed.
+   */
+    bool IsSeeded() const {
+        return m_seeded;
     }
 
     bool operator==(const PublicKeyImpl& other) const {
@@ -176,7 +208,16 @@ public:
     template <class Archive>
     void save(Archive& ar, std::uint32_t const version) const {
         ar(::cereal::base_class<Key<Element>>(this));
-        ar(::cereal::make_nvp("h", m_h));
+        ar(::cereal::make_nvp("sd", m_seeded));
+        if (m_seeded) {
+            // the first Element alone is followed by the seed of the second one
+            std::vector<Element> h{m_h.at(0)};
+            ar(::cereal::make_nvp("h", h));
+            ar(::cereal::make_nvp("s", m_seed));
+        }
+        else {
+            ar(::cereal::make_nvp("h", m_h));
+        }
     }
 
     template <class Archive>
@@ -186,18 +227,32 @@ public:
                           " is from a later version of the library");
         }
         ar(::cereal::base_class<Key<Element>>(this));
+        // seed-compressed keys exist since version 2, which records whether the key is seeded
+        m_seeded = false;
+        if (version >= 2)
+            ar(::cereal::make_nvp("sd", m_seeded));
         ar(::cereal::make_nvp("h", m_h));
+        if (m_seeded) {
+            if (m_h.size() != 1)
+                OPENFHE_THROW("a seeded public key must hold exactly one element");
+            ar(::cereal::make_nvp("s", m_seed));
+            m_h.push_back(GenerateSeededUniform<Element>(m_seed, 0, m_h[0].GetParams()));
+        }
     }
 
     std::string SerializedObjectName() const {
         return "PublicKey";
     }
     static uint32_t SerializedVersion() {
-        return 1;
+        return 2;
     }
 
 private:
     std::vector<Element> m_h;
+
+    // seed of the second Element for seed-compressed keys
+    PRNGSeed m_seed{};
+    bool m_seeded{false};
 };
 
 }  // namespace lbcrypto
@@ -153,6 +153,11 @@ public:
     Ciphertext<DCRTPoly> EvalBootstrap(ConstCiphertext<DCRTPoly> ciphertext, uint32_t numIterations,
                                        uint32_t precision) const override;
 
+    void SaveEvalBootstrapPrecomputation(const CryptoContextImpl<DCRTPoly>& cc, std::ostream& os,
+                                         uint32_t slots) const override;
+
+    uint32_t LoadEvalBootstrapPrecomputation(const CryptoContextImpl<DCRTPoly>& cc, std::istream& is) override;
+
     //------------------------------------------------------------------------------
     // Find Rotation Indices
     //------------------------------------------------------------------------------
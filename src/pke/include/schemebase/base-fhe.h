@@ -42,6 +42,7 @@
 #include "key/keypair.h"
 #include "scheme/scheme-swch-params.h"
 
+#include <iosfwd>
 #include <memory>
 #include <vector>
 #include <map>
@@ -53,6 +54,22 @@
  */
 namespace lbcrypto {
 
+/**
+ * @brief Throughput of a batch bootstrapped by EvalBootstrapBatch
+ */
+struct BootstrapBatchStats {
+    // number of bootstrapped ciphertexts
+    uint32_t numCiphertexts = 0;
+    // number of ciphertexts bootstrapped concurrently
+    uint32_t numWorkers = 0;
+    // number of threads the parallel loops inside one bootstrapping may use
+    uint32_t threadsPerWorker = 0;
+    // wall-clock time of the batch in milliseconds
+    double timeMs = 0;
+    // bootstrapped ciphertexts per second
+    double throughput = 0;
+};
+
 /**
  * @brief Abstract interface class for LBC PRE algorithms
  * @tparam Element a ring element.
@@ -110,6 +127,31 @@ public:
         OPENFHE_THROW("Not supported");
     }
 
+    /**
+   * Writes the precomputed plaintexts for encoding and decoding of the given number of slots to a
+   * versioned binary stream. Supported in CKKS only.
+   *
+   * @param cc crypto context the precomputation was generated for
+   * @param os output stream
+   * @param slots number of slots the precomputation was generated for
+   */
+    virtual void SaveEvalBootstrapPrecomputation(const CryptoContextImpl<Element>& cc, std::ostream& os,
+                                                 uint32_t slots) const {
+        OPENFHE_THROW("Not supported");
+    }
+
+    /**
+   * Reads precomputed plaintexts for encoding and decoding written by SaveEvalBootstrapPrecomputation
+   * and installs them for the number of slots stored in the stream. Supported in CKKS only.
+   *
+   * @param cc crypto context the precomputation is loaded into
+   * @param is input stream
+   * @return the number of slots of the loaded precomputation
+   */
+    virtual uint32_t LoadEvalBootstrapPrecomputation(const CryptoContextImpl<Element>& cc, std::istream& is) {
+        OPENFHE_THROW("Not supported");
+    }
+
     /**
    * Defines the bootstrapping evaluation of ciphertext
    *
@@ -130,6 +172,24 @@ public:
         OPENFHE_THROW("EvalBootstrap is not implemented for this scheme");
     }
 
+    /**
+   * Bootstraps a batch of ciphertexts. numWorkers ciphertexts are bootstrapped concurrently, and the
+   * parallel loops inside every bootstrapping are capped at machine threads / numWorkers threads, which they
+   * get if nested parallelism is enabled (OMP_MAX_ACTIVE_LEVELS >= 2); otherwise they run on their worker only.
+   * The precomputations are shared read-only by all workers.
+   *
+   * @param ciphertexts the input ciphertexts.
+   * @param numIterations number of iterations to run iterative bootstrapping (Meta-BTS).
+   * @param precision precision of initial bootstrapping algorithm.
+   * @param numWorkers number of ciphertexts bootstrapped concurrently, at most the batch size; 0 selects
+   * min(batch size, machine threads).
+   * @param stats if not nullptr, receives the throughput of the batch.
+   * @return the refreshed ciphertexts in the order of the input.
+   */
+    virtual std::vector<Ciphertext<Element>> EvalBootstrapBatch(const std::vector<Ciphertext<Element>>& ciphertexts,
+                                                                uint32_t numIterations, uint32_t precision,
+                                                                uint32_t numWorkers, BootstrapBatchStats* stats) const;
+
     /**
    * Sets all parameters for switching from CKKS to FHEW
    *
@@ -1402,12 +1402,31 @@ public:
         return;
     }
 
+    void SaveEvalBootstrapPrecomputation(const CryptoContextImpl<Element>& cc, std::ostream& os,
+                                         uint32_t slots = 0) const {
+        VerifyFHEEnabled(__func__);
+        m_FHE->SaveEvalBootstrapPrecomputation(cc, os, slots);
+    }
+
+    uint32_t LoadEvalBootstrapPrecomputation(const CryptoContextImpl<Element>& cc, std::istream& is) {
+        VerifyFHEEnabled(__func__);
+        return m_FHE->LoadEvalBootstrapPrecomputation(cc, is);
+    }
+
     Ciphertext<Element> EvalBootstrap(ConstCiphertext<Element> ciphertext, uint32_t numIterations = 1,
                                       uint32_t precision = 0) const {
         VerifyFHEEnabled(__func__);
         return m_FHE->EvalBootstrap(ciphertext, numIterations, precision);
     }
 
+    std::vector<Ciphertext<Element>> EvalBootstrapBatch(const std::vector<Ciphertext<Element>>& ciphertexts,
+                                                        uint32_t numIterations = 1, uint32_t precision = 0,
+                                                        uint32_t numWorkers         = 0,
+                                                        BootstrapBatchStats* stats = nullptr) const {
+        VerifyFHEEnabled(__func__);
+        return m_FHE->EvalBootstrapBatch(ciphertexts, numIterations, precision, numWorkers, stats);
+    }
+
     // SCHEMESWITCHING methods
 
     LWEPrivateKey EvalCKKStoFHEWSetup(const SchSwchParams& params) {
@@ -430,6 +430,41 @@ public:
         return m_paramsComplPartQ[numTowers][digit];
     }
 
+    /**
+   * Gets the CRT basis Q^(l) = {q_1,...,q_{l+1}}.
+   * Used in Hybrid key switching (ModDown)
+   *
+   * @param l is the number of towers minus one.
+   * @return the precomputed CRT params
+   */
+    const std::shared_ptr<ILDCRTParams<BigInteger>>& GetParamsQlModDown(uint32_t l) const {
+        return m_paramsQlModDown[l];
+    }
+
+    /**
+   * Gets the extended CRT basis Q^(l)*P = {q_1,...,q_{l+1},p_1,...,p_k}.
+   * Used in Hybrid key switching (ModUp)
+   *
+   * @param l is the number of towers minus one.
+   * @return the precomputed CRT params
+   */
+    const std::shared_ptr<ILDCRTParams<BigInteger>>& GetParamsQlP(uint32_t l) const {
+        return m_paramsQlP[l];
+    }
+
+    /**
+   * Gets the CRT basis of the first sublvl+1 towers of the digit part, i.e., the
+   * basis of the last digit of a ciphertext whose last digit is not full.
+   * Used in Hybrid key switching
+   *
+   * @param part is the index of the digit.
+   * @param sublvl is the number of towers in the digit minus one.
+   * @return the precomputed CRT params
+   */
+    const std::shared_ptr<ILDCRTParams<BigInteger>>& GetParamsPartQl(uint32_t part, uint32_t sublvl) const {
+        return m_paramsPartQl[part][sublvl];
+    }
+
     /**
    * Method that returns the precomputed values for QHat^-1 mod qj within a
    * partition of towers, used in HYBRID.
@@ -1429,6 +1464,15 @@ protected:
     // Stores the parameters for complementary {\bar{Q_i},P}
     std::vector<std::vector<std::shared_ptr<ILDCRTParams<BigInteger>>>> m_paramsComplPartQ;
 
+    // Stores the parameters for Q^(l) = {q_1,...,q_{l+1}}
+    std::vector<std::shared_ptr<ILDCRTParams<BigInteger>>> m_paramsQlModDown;
+
+    // Stores the parameters for Q^(l)*P = {q_1,...,q_{l+1},p_1,...,p_k}
+    std::vector<std::shared_ptr<ILDCRTParams<BigInteger>>> m_paramsQlP;
+
+    // Stores the parameters for the first l+1 towers of Q_i
+    std::vector<std::vector<std::shared_ptr<ILDCRTParams<BigInteger>>>> m_paramsPartQl;
+
     // Stores [{(Q_k)^(l)/q_i}^{-1}]_{q_i} for HYBRID
     std::vector<std::vector<std::vector<NativeInteger>>> m_PartQlHatInvModq;
 
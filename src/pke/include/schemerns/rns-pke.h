@@ -113,11 +113,34 @@ public:
     std::shared_ptr<std::vector<DCRTPoly>> EncryptZeroCore(const PrivateKey<DCRTPoly> privateKey,
                                                            const std::shared_ptr<ParmType> params) const override;
 
+    /**
+   * Symmetric encryption of zero whose second ring element is generated by GenerateSeededUniform() from the
+   * given seed, so that it does not have to be serialized.
+   *
+   * @param privateKey private key used for encryption.
+   * @param params the parameters of the ciphertext; nullptr selects the element parameters.
+   * @param seed the seed; nullptr samples the second ring element from the PRNG engine instead.
+   * @return the two ring elements of the ciphertext.
+   */
+    std::shared_ptr<std::vector<DCRTPoly>> EncryptZeroCore(const PrivateKey<DCRTPoly> privateKey,
+                                                           const std::shared_ptr<ParmType> params,
+                                                           const PRNGSeed* seed) const;
+
     std::shared_ptr<std::vector<DCRTPoly>> EncryptZeroCore(const PublicKey<DCRTPoly> publicKey,
                                                            const std::shared_ptr<ParmType> params) const override;
 
     DCRTPoly DecryptCore(const std::vector<DCRTPoly>& cv, const PrivateKey<DCRTPoly> privateKey) const override;
 
+    /**
+   * Symmetric encryption whose second ring element is generated from a fresh seed, so that the ciphertext
+   * serializes as one element plus the seed. Used by Encrypt() when SeedCompression() is enabled.
+   *
+   * @param plaintext copy of the plaintext input.
+   * @param privateKey private key used for encryption.
+   * @return the seeded ciphertext.
+   */
+    Ciphertext<DCRTPoly> EncryptSeeded(DCRTPoly plaintext, const PrivateKey<DCRTPoly> privateKey) const;
+
     /////////////////////////////////////
     // SERIALIZATION
     /////////////////////////////////////
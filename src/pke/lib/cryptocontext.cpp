@@ -40,14 +40,14 @@
 #include "math/chebyshev.h"
 #include "schemerns/rns-scheme.h"
 #include "scheme/ckksrns/ckksrns-cryptoparameters.h"
+#include "utils/parallel.h"
 
 namespace lbcrypto {
 
 template <typename Element>
-std::map<std::string, std::vector<EvalKey<Element>>> CryptoContextImpl<Element>::s_evalMultKeyMap{};
+EvalKeyRegistry<std::vector<EvalKey<Element>>> CryptoContextImpl<Element>::s_evalMultKeyMap{};
 template <typename Element>
-std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>
-    CryptoContextImpl<Element>::s_evalAutomorphismKeyMap{};
+EvalKeyRegistry<std::map<usint, EvalKey<Element>>> CryptoContextImpl<Element>::s_evalAutomorphismKeyMap{};
 
 template <typename Element>
 void CryptoContextImpl<Element>::SetKSTechniqueInScheme() {
@@ -71,11 +71,13 @@ template <typename Element>
 void CryptoContextImpl<Element>::EvalMultKeyGen(const PrivateKey<Element> key) {
     ValidateKey(key);
 
-    if (CryptoContextImpl<Element>::s_evalMultKeyMap.find(key->GetKeyTag()) ==
-        CryptoContextImpl<Element>::s_evalMultKeyMap.end()) {
+    if (!CryptoContextImpl<Element>::s_evalMultKeyMap.Find(key->GetKeyTag())) {
         // the key is not found in the map, so the key has to be generated
-        EvalKey<Element> k                                           = GetScheme()->EvalMultKeyGen(key);
-        CryptoContextImpl<Element>::s_evalMultKeyMap[k->GetKeyTag()] = {k};
+        EvalKey<Element> k = GetScheme()->EvalMultKeyGen(key);
+        auto evalKeys      = std::make_shared<std::vector<EvalKey<Element>>>(1, k);
+        // another thread may have inserted keys for this tag in the meantime; those are kept
+        CryptoContextImpl<Element>::s_evalMultKeyMap.Update(
+            [&](auto& keyMap) { keyMap.emplace(k->GetKeyTag(), evalKeys); });
     }
 }
 
@@ -83,49 +85,48 @@ template <typename Element>
 void CryptoContextImpl<Element>::EvalMultKeysGen(const PrivateKey<Element> key) {
     ValidateKey(key);
 
-    if (CryptoContextImpl<Element>::s_evalMultKeyMap.find(key->GetKeyTag()) ==
-        CryptoContextImpl<Element>::s_evalMultKeyMap.end()) {
+    if (!CryptoContextImpl<Element>::s_evalMultKeyMap.Find(key->GetKeyTag())) {
         // the key is not found in the map, so the key has to be generated
-        const std::vector<EvalKey<Element>>& evalKeys                  = GetScheme()->EvalMultKeysGen(key);
-        CryptoContextImpl<Element>::s_evalMultKeyMap[key->GetKeyTag()] = evalKeys;
+        auto evalKeys = std::make_shared<std::vector<EvalKey<Element>>>(GetScheme()->EvalMultKeysGen(key));
+        CryptoContextImpl<Element>::s_evalMultKeyMap.Update(
+            [&](auto& keyMap) { keyMap.emplace(key->GetKeyTag(), evalKeys); });
     }
 }
 
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalMultKeys() {
-    CryptoContextImpl<Element>::s_evalMultKeyMap.clear();
+    CryptoContextImpl<Element>::s_evalMultKeyMap.Update([](auto& keyMap) { keyMap.clear(); });
 }
 
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalMultKeys(const std::string& id) {
-    auto kd = CryptoContextImpl<Element>::s_evalMultKeyMap.find(id);
-    if (kd != CryptoContextImpl<Element>::s_evalMultKeyMap.end())
-        CryptoContextImpl<Element>::s_evalMultKeyMap.erase(kd);
+    CryptoContextImpl<Element>::s_evalMultKeyMap.Update([&id](auto& keyMap) { keyMap.erase(id); });
 }
 
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalMultKeys(const CryptoContext<Element> cc) {
-    for (auto it = CryptoContextImpl<Element>::s_evalMultKeyMap.begin();
-         it != CryptoContextImpl<Element>::s_evalMultKeyMap.end();) {
-        if (it->second[0]->GetCryptoContext() == cc) {
-            it = CryptoContextImpl<Element>::s_evalMultKeyMap.erase(it);
-        }
-        else {
-            ++it;
+    CryptoContextImpl<Element>::s_evalMultKeyMap.Update([&cc](auto& keyMap) {
+        for (auto it = keyMap.begin(); it != keyMap.end();) {
+            if ((*it->second)[0]->GetCryptoContext() == cc) {
+                it = keyMap.erase(it);
+            }
+            else {
+                ++it;
+            }
         }
-    }
+    });
 }
 
 template <typename Element>
 void CryptoContextImpl<Element>::InsertEvalMultKey(const std::vector<EvalKey<Element>>& vectorToInsert,
                                                    const std::string& keyTag) {
     const std::string tag = (keyTag.empty()) ? vectorToInsert[0]->GetKeyTag() : keyTag;
-    if (CryptoContextImpl<Element>::s_evalMultKeyMap.find(tag) != CryptoContextImpl<Element>::s_evalMultKeyMap.end()) {
+    auto evalKeys         = std::make_shared<std::vector<EvalKey<Element>>>(vectorToInsert);
+    CryptoContextImpl<Element>::s_evalMultKeyMap.Update([&](auto& keyMap) {
         // we do not allow to override the existing key vector if its keyTag is identical to the keyTag of the new keys
-        OPENFHE_THROW("Can not save a EvalMultKeys vector as there is a key vector for the given keyTag");
-    }
-
-    CryptoContextImpl<Element>::s_evalMultKeyMap[tag] = vectorToInsert;
+        if (!keyMap.emplace(tag, evalKeys).second)
+            OPENFHE_THROW("Can not save a EvalMultKeys vector as there is a key vector for the given keyTag");
+    });
 }
 
 /////////////////////////////////////////
@@ -175,39 +176,38 @@ std::shared_ptr<std::map<usint, EvalKey<Element>>> CryptoContextImpl<Element>::E
 }
 
 template <typename Element>
-const std::map<usint, EvalKey<Element>>& CryptoContextImpl<Element>::GetEvalSumKeyMap(const std::string& keyID) {
-    return CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(keyID);
+std::map<std::string, std::vector<EvalKey<Element>>> CryptoContextImpl<Element>::GetAllEvalMultKeys() {
+    std::map<std::string, std::vector<EvalKey<Element>>> keyMap;
+    for (const auto& [tag, evalKeys] : *CryptoContextImpl<Element>::s_evalMultKeyMap.Snapshot())
+        keyMap.emplace(tag, *evalKeys);
+    return keyMap;
 }
 
 template <typename Element>
-std::map<std::string, std::vector<EvalKey<Element>>>& CryptoContextImpl<Element>::GetAllEvalMultKeys() {
-    return CryptoContextImpl<Element>::s_evalMultKeyMap;
-}
-
-template <typename Element>
-const std::vector<EvalKey<Element>>& CryptoContextImpl<Element>::GetEvalMultKeyVector(const std::string& keyID) {
-    auto ekv = CryptoContextImpl<Element>::s_evalMultKeyMap.find(keyID);
-    if (ekv == CryptoContextImpl<Element>::s_evalMultKeyMap.end()) {
+std::shared_ptr<const std::vector<EvalKey<Element>>> CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(
+    const std::string& keyID) {
+    auto ekv = CryptoContextImpl<Element>::s_evalMultKeyMap.Find(keyID);
+    if (!ekv) {
         std::string errMsg(std::string("Call EvalMultKeyGen() to have EvalMultKey available for ID [") + keyID + "].");
         OPENFHE_THROW(errMsg);
     }
-    return ekv->second;
+    return ekv;
 }
 
 template <typename Element>
-std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>&
+std::map<std::string, std::shared_ptr<const std::map<usint, EvalKey<Element>>>>
 CryptoContextImpl<Element>::GetAllEvalAutomorphismKeys() {
-    return CryptoContextImpl<Element>::s_evalAutomorphismKeyMap;
+    return *CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.Snapshot();
 }
 
 template <typename Element>
-std::shared_ptr<std::map<usint, EvalKey<Element>>> CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(
+std::shared_ptr<const std::map<usint, EvalKey<Element>>> CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(
     const std::string& keyID) {
-    auto ekv = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.find(keyID);
-    if (ekv == CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.end()) {
+    auto ekv = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.Find(keyID);
+    if (!ekv) {
         OPENFHE_THROW("EvalAutomorphismKeys are not generated for ID [" + keyID + "].");
     }
-    return ekv->second;
+    return ekv;
 }
 
 template <typename Element>
@@ -216,8 +216,7 @@ std::shared_ptr<std::map<usint, EvalKey<Element>>> CryptoContextImpl<Element>::G
     if (!indexList.size())
         OPENFHE_THROW("indexList is empty");
 
-    std::shared_ptr<std::map<usint, EvalKey<Element>>> keyMap =
-        CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(keyID);
+    const auto keyMap = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(keyID);
 
     // create a return map if specific indices are provided
     std::map<usint, EvalKey<Element>> retMap;
@@ -232,7 +231,7 @@ std::shared_ptr<std::map<usint, EvalKey<Element>>> CryptoContextImpl<Element>::G
 }
 
 template <typename Element>
-std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>&
+std::map<std::string, std::shared_ptr<const std::map<usint, EvalKey<Element>>>>
 CryptoContextImpl<Element>::GetAllEvalSumKeys() {
     return CryptoContextImpl<Element>::GetAllEvalAutomorphismKeys();
 }
@@ -279,7 +278,7 @@ void CryptoContextImpl<Element>::EvalAtIndexKeyGen(const PrivateKey<Element> pri
 
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys() {
-    CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.clear();
+    CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.Update([](auto& keyMap) { keyMap.clear(); });
 }
 
 /**
@@ -288,9 +287,7 @@ void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys() {
  */
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys(const std::string& id) {
-    auto kd = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.find(id);
-    if (kd != CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.end())
-        CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.erase(kd);
+    CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.Update([&id](auto& keyMap) { keyMap.erase(id); });
 }
 
 /**
@@ -300,26 +297,27 @@ void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys(const std::string& id
  */
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys(const CryptoContext<Element> cc) {
-    for (auto it = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.begin();
-         it != CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.end();) {
-        if (it->second->begin()->second->GetCryptoContext() == cc) {
-            it = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.erase(it);
-        }
-        else {
-            ++it;
+    CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.Update([&cc](auto& keyMap) {
+        for (auto it = keyMap.begin(); it != keyMap.end();) {
+            if (it->second->begin()->second->GetCryptoContext() == cc) {
+                it = keyMap.erase(it);
+            }
+            else {
+                ++it;
+            }
         }
-    }
+    });
 }
 
 template <typename Element>
 std::set<uint32_t> CryptoContextImpl<Element>::GetExistingEvalAutomorphismKeyIndices(const std::string& keyTag) {
-    auto keyMapIt = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.find(keyTag);
-    if (keyMapIt == CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.end())
+    const auto keys = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.Find(keyTag);
+    if (!keys)
         // there is no keys for the given id, return empty vector
         return std::set<uint32_t>();
 
     // get all inidices from the existing automorphism key map
-    auto& keyMap = *(keyMapIt->second);
+    const auto& keyMap = *keys;
     std::set<uint32_t> indices;
     for (const auto& [key, _] : keyMap) {
         indices.insert(key);
@@ -348,35 +346,25 @@ void CryptoContextImpl<Element>::InsertEvalAutomorphismKey(
 
     auto mapToInsertIt   = mapToInsert->begin();
     const std::string id = (keyTag.empty()) ? mapToInsertIt->second->GetKeyTag() : keyTag;
-    std::set<uint32_t> existingIndices{CryptoContextImpl<Element>::GetExistingEvalAutomorphismKeyIndices(id)};
-    if (existingIndices.empty()) {
-        // there is no keys for the given id, so we insert full mapToInsert
-        CryptoContextImpl<Element>::s_evalAutomorphismKeyMap[id] = mapToInsert;
-    }
-    else {
-        // get all indices from mapToInsert
-        std::set<uint32_t> newIndices;
-        for (const auto& [key, _] : *mapToInsert) {
-            newIndices.insert(key);
-        }
-
-        // find all indices in mapToInsert that are not in the exising map and
-        // insert those new indices and their corresponding keys to the existing map
-        std::set<uint32_t> indicesToInsert{CryptoContextImpl<Element>::GetUniqueValues(existingIndices, newIndices)};
-        auto keyMapIt = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.find(id);
-        auto& keyMap  = *(keyMapIt->second);
-        for (uint32_t indx : indicesToInsert) {
-            keyMap[indx] = (*mapToInsert)[indx];
+    CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.Update([&](auto& keyMap) {
+        // published key maps are never modified, so the keys for the given id are merged into a new map.
+        // only the indices in mapToInsert that are not in the existing map are inserted
+        auto& keys = keyMap[id];
+        auto merged = keys ? std::make_shared<std::map<uint32_t, EvalKey<Element>>>(*keys) :
+                             std::make_shared<std::map<uint32_t, EvalKey<Element>>>();
+        for (const auto& [indx, key] : *mapToInsert) {
+            merged->emplace(indx, key);
         }
-    }
+        keys = std::move(merged);
+    });
 }
 
 template <typename Element>
 Ciphertext<Element> CryptoContextImpl<Element>::EvalSum(ConstCiphertext<Element> ciphertext, usint batchSize) const {
     ValidateCiphertext(ciphertext);
 
-    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
-    return GetScheme()->EvalSum(ciphertext, batchSize, evalSumKeys);
+    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(ciphertext->GetKeyTag());
+    return GetScheme()->EvalSum(ciphertext, batchSize, *evalSumKeys);
 }
 
 template <typename Element>
@@ -394,8 +382,8 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalSumCols(
     const std::map<usint, EvalKey<Element>>& evalSumKeysRight) const {
     ValidateCiphertext(ciphertext);
 
-    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
-    return GetScheme()->EvalSumCols(ciphertext, numCols, evalSumKeys, evalSumKeysRight);
+    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(ciphertext->GetKeyTag());
+    return GetScheme()->EvalSumCols(ciphertext, numCols, *evalSumKeys, evalSumKeysRight);
 }
 
 template <typename Element>
@@ -408,8 +396,78 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalAtIndex(ConstCiphertext<Elem
         return ciphertext->Clone();
     }
 
-    auto evalAutomorphismKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
-    return GetScheme()->EvalAtIndex(ciphertext, index, evalAutomorphismKeys);
+    auto evalAutomorphismKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(ciphertext->GetKeyTag());
+    return GetScheme()->EvalAtIndex(ciphertext, index, *evalAutomorphismKeys);
+}
+
+template <typename Element>
+void CryptoContextImpl<Element>::CheckRotationKeys(ConstCiphertext<Element> ciphertext,
+                                                   const std::vector<int32_t>& indices) const {
+    const auto evalKeyMap = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(ciphertext->GetKeyTag());
+    // the rotations run in parallel regions, so the keys are looked up here where an exception can be thrown
+    for (const auto index : indices) {
+        if (index == 0)
+            continue;
+        usint autoIndex = FindAutomorphismIndex(index);
+        if (evalKeyMap->find(autoIndex) == evalKeyMap->end())
+            OPENFHE_THROW("EvalKey for index [" + std::to_string(autoIndex) + "] is not found.");
+    }
+}
+
+template <typename Element>
+std::vector<Ciphertext<Element>> CryptoContextImpl<Element>::EvalRotateMany(ConstCiphertext<Element> ciphertext,
+                                                                            const std::vector<int32_t>& indices) const {
+    ValidateCiphertext(ciphertext);
+
+    std::vector<Ciphertext<Element>> result(indices.size());
+    if (indices.empty())
+        return result;
+
+    CheckRotationKeys(ciphertext, indices);
+
+    usint m     = GetCyclotomicOrder();
+    auto digits = EvalFastRotationPrecompute(ciphertext);
+
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(indices.size()))
+    for (size_t i = 0; i < indices.size(); ++i) {
+        result[i] = (indices[i] == 0) ? ciphertext->Clone() : EvalFastRotation(ciphertext, indices[i], m, digits);
+    }
+    return result;
+}
+
+template <typename Element>
+Ciphertext<Element> CryptoContextImpl<Element>::EvalRotateManySum(ConstCiphertext<Element> ciphertext,
+                                                                  const std::vector<int32_t>& indices) const {
+    ValidateCiphertext(ciphertext);
+
+    if (indices.empty())
+        OPENFHE_THROW("The list of rotation indices is empty");
+
+    CheckRotationKeys(ciphertext, indices);
+
+    auto digits = EvalFastRotationPrecompute(ciphertext);
+
+    // rotations in the extended basis P*Q; index 0 only needs c0 and c1 to be raised to P*Q
+    std::vector<Ciphertext<Element>> rotated(indices.size());
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(indices.size()))
+    for (size_t i = 0; i < indices.size(); ++i) {
+        rotated[i] = (indices[i] == 0) ? KeySwitchExt(ciphertext, true) :
+                                         EvalFastRotationExt(ciphertext, indices[i], digits, true);
+    }
+
+    // pairwise tree reduction; the additions of each level are independent
+    for (size_t stride = 1; stride < rotated.size(); stride *= 2) {
+        const size_t pairs = (rotated.size() - 1 + stride) / (2 * stride);
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(pairs))
+        for (size_t i = 0; i < rotated.size() - stride; i += 2 * stride) {
+            auto& acc       = rotated[i]->GetElements();
+            const auto& add = rotated[i + stride]->GetElements();
+            for (size_t j = 0; j < acc.size(); ++j)
+                acc[j] += add[j];
+        }
+    }
+
+    return KeySwitchDown(rotated[0]);
 }
 
 template <typename Element>
@@ -417,8 +475,9 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalMerge(
     const std::vector<Ciphertext<Element>>& ciphertextVector) const {
     ValidateCiphertext(ciphertextVector[0]);
 
-    auto evalAutomorphismKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertextVector[0]->GetKeyTag());
-    return GetScheme()->EvalMerge(ciphertextVector, evalAutomorphismKeys);
+    auto evalAutomorphismKeys =
+        CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(ciphertextVector[0]->GetKeyTag());
+    return GetScheme()->EvalMerge(ciphertextVector, *evalAutomorphismKeys);
 }
 
 template <typename Element>
@@ -428,9 +487,9 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalInnerProduct(ConstCiphertext
     if (ct2 == nullptr || ct1->GetKeyTag() != ct2->GetKeyTag())
         OPENFHE_THROW("Information was not generated with this crypto context");
 
-    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ct1->GetKeyTag());
-    auto ek          = CryptoContextImpl<Element>::GetEvalMultKeyVector(ct1->GetKeyTag());
-    return GetScheme()->EvalInnerProduct(ct1, ct2, batchSize, evalSumKeys, ek[0]);
+    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(ct1->GetKeyTag());
+    auto ek          = CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(ct1->GetKeyTag());
+    return GetScheme()->EvalInnerProduct(ct1, ct2, batchSize, *evalSumKeys, (*ek)[0]);
 }
 
 template <typename Element>
@@ -440,8 +499,8 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalInnerProduct(ConstCiphertext
     if (ct2 == nullptr)
         OPENFHE_THROW("Information was not generated with this crypto context");
 
-    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ct1->GetKeyTag());
-    return GetScheme()->EvalInnerProduct(ct1, ct2, batchSize, evalSumKeys);
+    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(ct1->GetKeyTag());
+    return GetScheme()->EvalInnerProduct(ct1, ct2, batchSize, *evalSumKeys);
 }
 
 template <typename Element>
@@ -35,8 +35,10 @@ namespace lbcrypto {
 
 struct GLOBALS {
     static bool precomputeCRTTables;
+    static bool seedCompression;
 };
 bool GLOBALS::precomputeCRTTables = true;
+bool GLOBALS::seedCompression     = false;
 //=============================================================================
 void EnablePrecomputeCRTTablesAfterDeserializaton() {
     GLOBALS::precomputeCRTTables = true;
@@ -50,5 +52,17 @@ bool PrecomputeCRTTablesAfterDeserializaton() {
     return GLOBALS::precomputeCRTTables;
 }
 //=============================================================================
+void EnableSeedCompression() {
+    GLOBALS::seedCompression = true;
+}
+//=============================================================================
+void DisableSeedCompression() {
+    GLOBALS::seedCompression = false;
+}
+//=============================================================================
+bool SeedCompression() {
+    return GLOBALS::seedCompression;
+}
+//=============================================================================
 
 }  // namespace lbcrypto
@@ -42,6 +42,9 @@
 #include "key/evalkeyrelin.h"
 #include "scheme/ckksrns/ckksrns-cryptoparameters.h"
 #include "ciphertext.h"
+#include "globals.h"
+#include "utils/parallel.h"
+#include "utils/utilities-int.h"
 
 namespace lbcrypto {
 
@@ -99,9 +102,14 @@ EvalKey<DCRTPoly> KeySwitchHYBRID::KeySwitchGenInternal(const PrivateKey<DCRTPol
     std::vector<NativeInteger> PModq = cryptoParams->GetPModq();
     size_t numPerPartQ               = cryptoParams->GetNumPerPartQ();
 
+    // with seed compression, the a's of a single-key evaluation key are derived from one seed
+    const bool seeded   = (ekPrev == nullptr) && SeedCompression();
+    const PRNGSeed seed = seeded ? PseudoRandomNumberGenerator::GenerateSeed() : PRNGSeed{};
+
     for (size_t part = 0; part < numPartQ; ++part) {
-        DCRTPoly a = (ekPrev == nullptr) ? DCRTPoly(dug, paramsQP, Format::EVALUATION) :  // single-key HE
-                                           ekPrev->GetAVector()[part];                                      // threshold HE
+        DCRTPoly a = (ekPrev != nullptr) ? ekPrev->GetAVector()[part] :                       // threshold HE
+                         seeded ? GenerateSeededUniform<DCRTPoly>(seed, part, paramsQP) :  // single-key HE
+                                  DCRTPoly(dug, paramsQP, Format::EVALUATION);
         DCRTPoly e(dgg, paramsQP, Format::EVALUATION);
         DCRTPoly b(paramsQP, Format::EVALUATION, true);
 
@@ -130,6 +138,8 @@ EvalKey<DCRTPoly> KeySwitchHYBRID::KeySwitchGenInternal(const PrivateKey<DCRTPol
 
     ek->SetAVector(std::move(av));
     ek->SetBVector(std::move(bv));
+    if (seeded)
+        ek->SetAVectorSeed(seed);
     ek->SetKeyTag(newKey->GetKeyTag());
     return ek;
 }
@@ -232,12 +242,10 @@ Ciphertext<DCRTPoly> KeySwitchHYBRID::KeySwitchExt(ConstCiphertext<DCRTPoly> cip
 
     const std::vector<DCRTPoly>& cv = ciphertext->GetElements();
 
-    const auto paramsQl  = cv[0].GetParams();
-    const auto paramsP   = cryptoParams->GetParamsP();
-    const auto paramsQlP = cv[0].GetExtendedCRTBasis(paramsP);
+    size_t sizeQl        = cv[0].GetNumOfElements();
+    const auto paramsQlP = cryptoParams->GetParamsQlP(sizeQl - 1);
 
-    size_t sizeQl = paramsQl->GetParams().size();
-    usint sizeCv  = cv.size();
+    usint sizeCv = cv.size();
     std::vector<DCRTPoly> resultElements(sizeCv);
     for (usint k = 0; k < sizeCv; k++) {
         resultElements[k] = DCRTPoly(paramsQlP, Format::EVALUATION, true);
@@ -260,15 +268,8 @@ Ciphertext<DCRTPoly> KeySwitchHYBRID::KeySwitchDown(ConstCiphertext<DCRTPoly> ci
     const auto paramsP   = cryptoParams->GetParamsP();
     const auto paramsQlP = ciphertext->GetElements()[0].GetParams();
 
-    // TODO : (Andrey) precompute paramsQl in cryptoparameters
-    usint sizeQl = paramsQlP->GetParams().size() - paramsP->GetParams().size();
-    std::vector<NativeInteger> moduliQ(sizeQl);
-    std::vector<NativeInteger> rootsQ(sizeQl);
-    for (size_t i = 0; i < sizeQl; i++) {
-        moduliQ[i] = paramsQlP->GetParams()[i]->GetModulus();
-        rootsQ[i]  = paramsQlP->GetParams()[i]->GetRootOfUnity();
-    }
-    auto paramsQl = std::make_shared<typename DCRTPoly::Params>(2 * paramsQlP->GetRingDimension(), moduliQ, rootsQ);
+    usint sizeQl         = paramsQlP->GetParams().size() - paramsP->GetParams().size();
+    const auto& paramsQl = cryptoParams->GetParamsQlModDown(sizeQl - 1);
 
     auto cTilda = ciphertext->GetElements();
 
@@ -299,15 +300,8 @@ DCRTPoly KeySwitchHYBRID::KeySwitchDownFirstElement(ConstCiphertext<DCRTPoly> ci
     const auto paramsP   = cryptoParams->GetParamsP();
     const auto paramsQlP = cTilda[0].GetParams();
 
-    // TODO : (Andrey) precompute paramsQl in cryptoparameters
-    usint sizeQl = paramsQlP->GetParams().size() - paramsP->GetParams().size();
-    std::vector<NativeInteger> moduliQ(sizeQl);
-    std::vector<NativeInteger> rootsQ(sizeQl);
-    for (size_t i = 0; i < sizeQl; i++) {
-        moduliQ[i] = paramsQlP->GetParams()[i]->GetModulus();
-        rootsQ[i]  = paramsQlP->GetParams()[i]->GetRootOfUnity();
-    }
-    auto paramsQl = std::make_shared<typename DCRTPoly::Params>(2 * paramsQlP->GetRingDimension(), moduliQ, rootsQ);
+    usint sizeQl         = paramsQlP->GetParams().size() - paramsP->GetParams().size();
+    const auto& paramsQl = cryptoParams->GetParamsQlModDown(sizeQl - 1);
 
     PlaintextModulus t = (cryptoParams->GetNoiseScale() == 1) ? 0 : cryptoParams->GetPlaintextModulus();
 
@@ -330,13 +324,10 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalKeySwitchPrecomputeC
     const DCRTPoly& c, std::shared_ptr<CryptoParametersBase<DCRTPoly>> cryptoParamsBase) const {
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(cryptoParamsBase);
 
-    const std::shared_ptr<ParmType> paramsQl  = c.GetParams();
-    const std::shared_ptr<ParmType> paramsP   = cryptoParams->GetParamsP();
-    const std::shared_ptr<ParmType> paramsQlP = c.GetExtendedCRTBasis(paramsP);
+    size_t sizeQl                              = c.GetNumOfElements();
+    const std::shared_ptr<ParmType>& paramsQlP = cryptoParams->GetParamsQlP(sizeQl - 1);
 
-    size_t sizeQl  = paramsQl->GetParams().size();
-    size_t sizeP   = paramsP->GetParams().size();
-    size_t sizeQlP = sizeQl + sizeP;
+    size_t sizeQlP = paramsQlP->GetParams().size();
 
     uint32_t alpha = cryptoParams->GetNumPerPartQ();
     // The number of digits of the current ciphertext
@@ -350,21 +341,9 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalKeySwitchPrecomputeC
     // Zero-padding and split
     for (uint32_t part = 0; part < numPartQl; part++) {
         if (part == numPartQl - 1) {
-            auto paramsPartQ = cryptoParams->GetParamsPartQ(part);
-
             uint32_t sizePartQl = sizeQl - alpha * part;
-
-            std::vector<NativeInteger> moduli(sizePartQl);
-            std::vector<NativeInteger> roots(sizePartQl);
-
-            for (uint32_t i = 0; i < sizePartQl; i++) {
-                moduli[i] = paramsPartQ->GetParams()[i]->GetModulus();
-                roots[i]  = paramsPartQ->GetParams()[i]->GetRootOfUnity();
-            }
-
-            auto params = DCRTPoly::Params(paramsPartQ->GetCyclotomicOrder(), moduli, roots);
-
-            partsCt[part] = DCRTPoly(std::make_shared<ParmType>(params), Format::EVALUATION, true);
+            const auto& params  = cryptoParams->GetParamsPartQl(part, sizePartQl - 1);
+            partsCt[part]       = DCRTPoly(params, Format::EVALUATION, true);
         }
         else {
             partsCt[part] = DCRTPoly(cryptoParams->GetParamsPartQ(part), Format::EVALUATION, true);
@@ -377,35 +356,37 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalKeySwitchPrecomputeC
         }
     }
 
-    std::vector<DCRTPoly> partsCtCompl(numPartQl);
     std::vector<DCRTPoly> partsCtExt(numPartQl);
+    // staging for the complementary-basis towers of one digit, owned by this call; ApproxSwitchCRTBasis() writes
+    // into its towers whenever they were already allocated for the same basis
+    DCRTPoly partCtCompl;
 
     for (uint32_t part = 0; part < numPartQl; part++) {
-        auto partCtClone = partsCt[part].Clone();
-        partCtClone.SetFormat(Format::COEFFICIENT);
-
         uint32_t sizePartQl = partsCt[part].GetNumOfElements();
-        partsCtCompl[part]  = partCtClone.ApproxSwitchCRTBasis(
-             cryptoParams->GetParamsPartQ(part), cryptoParams->GetParamsComplPartQ(sizeQl - 1, part),
-             cryptoParams->GetPartQlHatInvModq(part, sizePartQl - 1),
-             cryptoParams->GetPartQlHatInvModqPrecon(part, sizePartQl - 1),
-             cryptoParams->GetPartQlHatModp(sizeQl - 1, part),
-             cryptoParams->GetmodComplPartqBarrettMu(sizeQl - 1, part));
-
-        partsCtCompl[part].SetFormat(Format::EVALUATION);
+        usint startPartIdx  = alpha * part;
+        usint endPartIdx    = startPartIdx + sizePartQl;
 
         partsCtExt[part] = DCRTPoly(paramsQlP, Format::EVALUATION, true);
-
-        usint startPartIdx = alpha * part;
-        usint endPartIdx   = startPartIdx + sizePartQl;
-        for (usint i = 0; i < startPartIdx; i++) {
-            partsCtExt[part].SetElementAtIndex(i, partsCtCompl[part].GetElementAtIndex(i));
-        }
         for (usint i = startPartIdx, idx = 0; i < endPartIdx; i++, idx++) {
             partsCtExt[part].SetElementAtIndex(i, partsCt[part].GetElementAtIndex(idx));
         }
+
+        // the digit is not needed in the EVALUATION representation anymore, so it is converted in place
+        partsCt[part].SetFormat(Format::COEFFICIENT);
+        partsCt[part].ApproxSwitchCRTBasis(
+            cryptoParams->GetParamsPartQ(part), cryptoParams->GetParamsComplPartQ(sizeQl - 1, part),
+            cryptoParams->GetPartQlHatInvModq(part, sizePartQl - 1),
+            cryptoParams->GetPartQlHatInvModqPrecon(part, sizePartQl - 1),
+            cryptoParams->GetPartQlHatModp(sizeQl - 1, part),
+            cryptoParams->GetmodComplPartqBarrettMu(sizeQl - 1, part), &partCtCompl);
+
+        partCtCompl.SetFormat(Format::EVALUATION);
+
+        for (usint i = 0; i < startPartIdx; i++) {
+            partsCtExt[part].SetElementAtIndex(i, partCtCompl.GetElementAtIndex(i));
+        }
         for (usint i = endPartIdx; i < sizeQlP; ++i) {
-            partsCtExt[part].SetElementAtIndex(i, partsCtCompl[part].GetElementAtIndex(i - sizePartQl));
+            partsCtExt[part].SetElementAtIndex(i, partCtCompl.GetElementAtIndex(i - sizePartQl));
         }
     }
 
@@ -439,9 +420,12 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCore(
 std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCoreExt(
     const std::shared_ptr<std::vector<DCRTPoly>> digits, const EvalKey<DCRTPoly> evalKey,
     const std::shared_ptr<ParmType> paramsQl) const {
-    const auto cryptoParams         = std::dynamic_pointer_cast<CryptoParametersRNS>(evalKey->GetCryptoParameters());
-    const std::vector<DCRTPoly>& bv = evalKey->GetBVector();
-    const std::vector<DCRTPoly>& av = evalKey->GetAVector();
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(evalKey->GetCryptoParameters());
+    // pinned, so that a key read from an EvalKeyStore stays valid for the whole inner product
+    const auto bvPtr                = evalKey->GetBVectorPtr();
+    const auto avPtr                = evalKey->GetAVectorPtr();
+    const std::vector<DCRTPoly>& bv = *bvPtr;
+    const std::vector<DCRTPoly>& av = *avPtr;
 
     const std::shared_ptr<ParmType> paramsP   = cryptoParams->GetParamsP();
     const std::shared_ptr<ParmType> paramsQlP = (*digits)[0].GetParams();
@@ -453,6 +437,53 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCoreExt
     DCRTPoly cTilda0(paramsQlP, Format::EVALUATION, true);
     DCRTPoly cTilda1(paramsQlP, Format::EVALUATION, true);
 
+#if defined(HAVE_INT128) && NATIVEINT == 64
+    // Fused inner product: for every coefficient, the products with both key components are summed
+    // over all digits in 128-bit accumulators and reduced only once. A product is below
+    // 2^(2*MAX_MODULUS_SIZE), so the accumulators can hold FUSED_KS_MAX_DIGITS of them.
+    constexpr uint32_t FUSED_KS_MAX_DIGITS = uint32_t(1) << (128 - 2 * MAX_MODULUS_SIZE);
+    const uint32_t numDigits               = digits->size();
+    if (numDigits <= FUSED_KS_MAX_DIGITS) {
+        const usint ringDim = paramsQlP->GetRingDimension();
+        auto& towers0       = cTilda0.GetAllElements();
+        auto& towers1       = cTilda1.GetAllElements();
+
+    #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeQlP))
+        for (usint i = 0; i < sizeQlP; i++) {
+            // the key towers are in the basis Q*P, the digits in Q^(l)*P
+            usint idx = (i < sizeQl) ? i : i - sizeQl + sizeQ;
+
+            std::vector<const NativeVector*> c(numDigits);
+            std::vector<const NativeVector*> b(numDigits);
+            std::vector<const NativeVector*> a(numDigits);
+            for (uint32_t j = 0; j < numDigits; j++) {
+                c[j] = &(*digits)[j].GetElementAtIndex(i).GetValues();
+                b[j] = &bv[j].GetElementAtIndex(idx).GetValues();
+                a[j] = &av[j].GetElementAtIndex(idx).GetValues();
+            }
+
+            const uint64_t qi = towers0[i].GetModulus().ConvertToInt();
+            // floor((2^128 - 1)/qi) equals floor(2^128/qi) as qi is not a power of two
+            const DoubleNativeInt mu = ~DoubleNativeInt(0) / qi;
+
+            for (usint k = 0; k < ringDim; k++) {
+                DoubleNativeInt sum0 = 0;
+                DoubleNativeInt sum1 = 0;
+                for (uint32_t j = 0; j < numDigits; j++) {
+                    uint64_t cjk = (*c[j])[k].ConvertToInt();
+                    sum0 += Mul128(cjk, (*b[j])[k].ConvertToInt());
+                    sum1 += Mul128(cjk, (*a[j])[k].ConvertToInt());
+                }
+                towers0[i][k] = NativeInteger(BarrettUint128ModUint64(sum0, qi, mu));
+                towers1[i][k] = NativeInteger(BarrettUint128ModUint64(sum1, qi, mu));
+            }
+        }
+
+        return std::make_shared<std::vector<DCRTPoly>>(
+            std::initializer_list<DCRTPoly>{std::move(cTilda0), std::move(cTilda1)});
+    }
+#endif
+
     for (uint32_t j = 0; j < digits->size(); j++) {
         const DCRTPoly& cj = (*digits)[j];
         const DCRTPoly& bj = bv[j];
@@ -36,6 +36,7 @@ BFV implementation. See https://eprint.iacr.org/2021/204 for details.
 #define PROFILE
 
 #include "cryptocontext.h"
+#include "globals.h"
 #include "key/privatekey.h"
 #include "key/publickey.h"
 #include "scheme/bfvrns/bfvrns-cryptoparameters.h"
@@ -79,7 +80,11 @@ KeyPair<DCRTPoly> PKEBFVRNS::KeyGenInternal(CryptoContext<DCRTPoly> cc, bool mak
 
     // Public Key Generation
 
-    DCRTPoly a(dug, paramsPK, Format::EVALUATION);
+    // with seed compression enabled, "a" is derived from a fresh seed so that
+    // only the seed has to be stored next to "b" when the key is serialized
+    const bool seeded   = SeedCompression();
+    const PRNGSeed seed = seeded ? PseudoRandomNumberGenerator::GenerateSeed() : PRNGSeed{};
+    DCRTPoly a(seeded ? GenerateSeededUniform<DCRTPoly>(seed, 0, paramsPK) : DCRTPoly(dug, paramsPK, Format::EVALUATION));
     DCRTPoly e(dgg, paramsPK, Format::EVALUATION);
     DCRTPoly b(ns * e - a * s);
 
@@ -91,6 +96,8 @@ KeyPair<DCRTPoly> PKEBFVRNS::KeyGenInternal(CryptoContext<DCRTPoly> cc, bool mak
 
     keyPair.secretKey->SetPrivateElement(std::move(s));
     keyPair.publicKey->SetPublicElements(std::vector<DCRTPoly>{std::move(b), std::move(a)});
+    if (seeded)
+        keyPair.publicKey->SetPublicElementsSeed(seed);
     keyPair.publicKey->SetKeyTag(keyPair.secretKey->GetKeyTag());
 
     return keyPair;
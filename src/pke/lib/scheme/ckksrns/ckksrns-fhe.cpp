@@ -49,8 +49,13 @@
 #include "utils/utilities.h"
 #include "scheme/ckksrns/ckksrns-utils.h"
 
+#include <algorithm>
 #include <cmath>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <set>
+#include <string>
 #include <vector>
 
 namespace lbcrypto {
@@ -337,6 +342,303 @@ void FHECKKSRNS::EvalBootstrapPrecompute(const CryptoContextImpl<DCRTPoly>& cc,
     }
 }
 
+namespace {
+
+// Layout of the stream written by SaveEvalBootstrapPrecomputation, in the byte order of the host that wrote it:
+//   header:     magic, version, byte order mark, sizeof(NativeInteger), ring dimension, slots, correction factor,
+//               dim1, m_paramsEnc, m_paramsDec
+//   parameters: the distinct element parameters of the plaintexts (moduli and roots of unity)
+//   plaintexts: m_U0hatTPre, m_U0Pre, m_U0hatTPreFFT, m_U0PreFFT stored as rows of plaintexts; every
+//               plaintext has its metadata followed by the coefficients of all towers
+// The format is only loaded by copying the coefficients into the towers, so it has no alignment padding. The
+// byte order mark is read back as BOOT_PRECOM_BYTE_ORDER only on hosts with the byte order of the writer.
+constexpr char BOOT_PRECOM_MAGIC[8]               = {'O', 'F', 'H', 'E', 'B', 'T', 'P', 'C'};
+constexpr uint32_t BOOT_PRECOM_VERSION            = 3;
+constexpr uint32_t BOOT_PRECOM_BYTE_ORDER         = 0x01020304;
+constexpr uint32_t BOOT_PRECOM_BYTE_ORDER_SWAPPED = 0x04030201;
+
+class BootPrecomWriter {
+public:
+    explicit BootPrecomWriter(std::ostream& os) : m_os(os) {}
+
+    void WriteBytes(const void* data, size_t bytes) {
+        m_os.write(static_cast<const char*>(data), bytes);
+        if (!m_os)
+            OPENFHE_THROW("Failed to write the bootstrapping precomputation");
+    }
+
+    template <typename T>
+    void Write(const T& value) {
+        WriteBytes(&value, sizeof(T));
+    }
+
+private:
+    std::ostream& m_os;
+};
+
+class BootPrecomReader {
+public:
+    explicit BootPrecomReader(std::istream& is) : m_is(is) {}
+
+    void ReadBytes(void* data, size_t bytes) {
+        m_is.read(static_cast<char*>(data), bytes);
+        if (!m_is)
+            OPENFHE_THROW("Unexpected end of the bootstrapping precomputation");
+    }
+
+    template <typename T>
+    T Read() {
+        T value;
+        ReadBytes(&value, sizeof(T));
+        return value;
+    }
+
+    // reads a count and checks it against the value expected by the crypto context
+    uint32_t ReadCount(uint32_t expected, const std::string& what) {
+        uint32_t count = Read<uint32_t>();
+        if (count != expected)
+            OPENFHE_THROW("Invalid number of " + what + " in the bootstrapping precomputation: " +
+                          std::to_string(count) + " (expected " + std::to_string(expected) + ")");
+        return count;
+    }
+
+private:
+    std::istream& m_is;
+};
+
+}  // namespace
+
+void FHECKKSRNS::SaveEvalBootstrapPrecomputation(const CryptoContextImpl<DCRTPoly>& cc, std::ostream& os,
+                                                 uint32_t numSlots) const {
+    uint32_t M     = cc.GetCyclotomicOrder();
+    uint32_t slots = (numSlots == 0) ? M / 4 : numSlots;
+
+    auto pair = m_bootPrecomMap.find(slots);
+    if (pair == m_bootPrecomMap.end()) {
+        std::string errorMsg(std::string("Precomputations for ") + std::to_string(slots) +
+                             std::string(" slots were not generated") +
+                             std::string(" Need to call EvalBootstrapSetup to proceed"));
+        OPENFHE_THROW(errorMsg);
+    }
+    const std::shared_ptr<CKKSBootstrapPrecom> precom = pair->second;
+
+    if (precom->m_U0hatTPre.empty() && precom->m_U0hatTPreFFT.empty())
+        OPENFHE_THROW("The plaintexts for encoding and decoding were not precomputed. Call EvalBootstrapPrecompute");
+
+    // the flat vectors of the linear method are stored as a single row
+    const std::vector<std::vector<ConstPlaintext>> U0hatTPre{precom->m_U0hatTPre};
+    const std::vector<std::vector<ConstPlaintext>> U0Pre{precom->m_U0Pre};
+    const std::vector<const std::vector<std::vector<ConstPlaintext>>*> groups{
+        &U0hatTPre, &U0Pre, &precom->m_U0hatTPreFFT, &precom->m_U0PreFFT};
+
+    // plaintexts encoded at the same level share their element parameters
+    std::map<const DCRTPoly::Params*, uint32_t> paramsIndex;
+    std::vector<std::shared_ptr<DCRTPoly::Params>> paramsTable;
+    for (const auto* group : groups) {
+        for (const auto& row : *group) {
+            for (const auto& pt : row) {
+                if (pt == nullptr)
+                    continue;
+                const auto& params = pt->GetElement<DCRTPoly>().GetParams();
+                if (paramsIndex.emplace(params.get(), paramsTable.size()).second)
+                    paramsTable.push_back(params);
+            }
+        }
+    }
+
+    BootPrecomWriter writer(os);
+    writer.WriteBytes(BOOT_PRECOM_MAGIC, sizeof(BOOT_PRECOM_MAGIC));
+    writer.Write<uint32_t>(BOOT_PRECOM_VERSION);
+    writer.Write<uint32_t>(BOOT_PRECOM_BYTE_ORDER);
+    writer.Write<uint32_t>(sizeof(NativeInteger));
+    writer.Write<uint32_t>(cc.GetRingDimension());
+    writer.Write<uint32_t>(slots);
+    writer.Write<uint32_t>(m_correctionFactor);
+    writer.Write<uint32_t>(precom->m_dim1);
+    for (const auto* params : {&precom->m_paramsEnc, &precom->m_paramsDec}) {
+        writer.Write<uint32_t>(params->size());
+        for (int32_t p : *params)
+            writer.Write<int32_t>(p);
+    }
+
+    writer.Write<uint32_t>(paramsTable.size());
+    for (const auto& params : paramsTable) {
+        writer.Write<uint32_t>(params->GetParams().size());
+        for (const auto& p : params->GetParams()) {
+            writer.Write<BasicInteger>(p->GetModulus().ConvertToInt<BasicInteger>());
+            writer.Write<BasicInteger>(p->GetRootOfUnity().ConvertToInt<BasicInteger>());
+        }
+    }
+
+    const size_t towerBytes = cc.GetRingDimension() * sizeof(NativeInteger);
+    for (const auto* group : groups) {
+        writer.Write<uint32_t>(group->size());
+        for (const auto& row : *group) {
+            writer.Write<uint32_t>(row.size());
+            for (const auto& pt : row) {
+                writer.Write<uint32_t>(pt != nullptr);
+                if (pt == nullptr)
+                    continue;
+                const DCRTPoly& element = pt->GetElement<DCRTPoly>();
+                writer.Write<uint32_t>(paramsIndex[element.GetParams().get()]);
+                writer.Write<uint32_t>(element.GetFormat());
+                writer.Write<uint32_t>(pt->GetNoiseScaleDeg());
+                writer.Write<uint32_t>(pt->GetLevel());
+                writer.Write<uint32_t>(pt->GetSlots());
+                writer.Write<double>(pt->GetScalingFactor());
+                for (const auto& tower : element.GetAllElements())
+                    writer.WriteBytes(&tower.GetValues()[0], towerBytes);
+            }
+        }
+    }
+}
+
+uint32_t FHECKKSRNS::LoadEvalBootstrapPrecomputation(const CryptoContextImpl<DCRTPoly>& cc, std::istream& is) {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(cc.GetCryptoParameters());
+
+    if (cryptoParams->GetKeySwitchTechnique() != HYBRID)
+        OPENFHE_THROW("CKKS Bootstrapping is only supported for the Hybrid key switching method.");
+
+    BootPrecomReader reader(is);
+    char magic[sizeof(BOOT_PRECOM_MAGIC)];
+    reader.ReadBytes(magic, sizeof(magic));
+    if (!std::equal(std::begin(magic), std::end(magic), std::begin(BOOT_PRECOM_MAGIC)))
+        OPENFHE_THROW("The stream does not contain a bootstrapping precomputation");
+    uint32_t version   = reader.Read<uint32_t>();
+    uint32_t byteOrder = reader.Read<uint32_t>();
+    // the mark of a host with the opposite byte order is read with its bytes reversed
+    if (byteOrder == BOOT_PRECOM_BYTE_ORDER_SWAPPED)
+        OPENFHE_THROW("The bootstrapping precomputation was written on a host with a different byte order");
+    if (version != BOOT_PRECOM_VERSION)
+        OPENFHE_THROW("Unsupported version of the bootstrapping precomputation: " + std::to_string(version));
+    if (byteOrder != BOOT_PRECOM_BYTE_ORDER)
+        OPENFHE_THROW("Invalid byte order mark in the bootstrapping precomputation");
+    if (reader.Read<uint32_t>() != sizeof(NativeInteger))
+        OPENFHE_THROW("The bootstrapping precomputation was written with a different native integer size");
+    uint32_t N = reader.Read<uint32_t>();
+    if (N != cc.GetRingDimension())
+        OPENFHE_THROW("The bootstrapping precomputation was written for ring dimension " + std::to_string(N));
+
+    auto precom     = std::make_shared<CKKSBootstrapPrecom>();
+    precom->m_slots = reader.Read<uint32_t>();
+    if (precom->m_slots == 0 || precom->m_slots > N / 2 || (precom->m_slots & (precom->m_slots - 1)) != 0)
+        OPENFHE_THROW("Invalid number of slots in the bootstrapping precomputation");
+    uint32_t correctionFactor = reader.Read<uint32_t>();
+    precom->m_dim1            = reader.Read<uint32_t>();
+    if (precom->m_dim1 > precom->m_slots)
+        OPENFHE_THROW("Invalid baby step in the bootstrapping precomputation");
+
+    // the FFT parameters must be the ones EvalBootstrapSetup derives from the level budget and the giant step
+    uint32_t logSlots = std::log2(precom->m_slots);
+    if (logSlots == 0)
+        logSlots = 1;
+    for (auto* params : {&precom->m_paramsEnc, &precom->m_paramsDec}) {
+        reader.ReadCount(CKKS_BOOT_PARAMS::TOTAL_ELEMENTS, "level budget parameters");
+        for (auto& p : *params)
+            p = reader.Read<int32_t>();
+        int32_t levelBudget = (*params)[CKKS_BOOT_PARAMS::LEVEL_BUDGET];
+        int32_t giantStep   = (*params)[CKKS_BOOT_PARAMS::GIANT_STEP];
+        if (levelBudget < 1 || static_cast<uint32_t>(levelBudget) > logSlots || giantStep < 1 ||
+            *params != GetCollapsedFFTParams(precom->m_slots, levelBudget, giantStep))
+            OPENFHE_THROW("Invalid level budget parameters in the bootstrapping precomputation");
+    }
+    const auto& paramsEnc = precom->m_paramsEnc;
+    const auto& paramsDec = precom->m_paramsDec;
+    bool isLTBootstrap =
+        (paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET] == 1) && (paramsDec[CKKS_BOOT_PARAMS::LEVEL_BUDGET] == 1);
+
+    // all moduli must come from the moduli of this crypto context
+    std::set<BasicInteger> contextModuli;
+    for (const auto& p : cryptoParams->GetElementParams()->GetParams())
+        contextModuli.insert(p->GetModulus().ConvertToInt<BasicInteger>());
+    for (const auto& p : cryptoParams->GetParamsP()->GetParams())
+        contextModuli.insert(p->GetModulus().ConvertToInt<BasicInteger>());
+
+    // every plaintext is encoded over Q_l or Q_l*P for some level l, so there are at most two parameter sets
+    // per modulus, and none of them has more towers than the context
+    uint32_t M         = cc.GetCyclotomicOrder();
+    uint32_t numParams = reader.Read<uint32_t>();
+    if (numParams > 2 * contextModuli.size())
+        OPENFHE_THROW("Invalid number of element parameters in the bootstrapping precomputation");
+    std::vector<std::shared_ptr<DCRTPoly::Params>> paramsTable(numParams);
+    for (auto& params : paramsTable) {
+        uint32_t numModuli = reader.Read<uint32_t>();
+        if (numModuli == 0 || numModuli > contextModuli.size())
+            OPENFHE_THROW("Invalid number of moduli in the bootstrapping precomputation");
+        std::vector<NativeInteger> moduli(numModuli);
+        std::vector<NativeInteger> roots(moduli.size());
+        for (size_t i = 0; i < moduli.size(); ++i) {
+            BasicInteger q = reader.Read<BasicInteger>();
+            if (contextModuli.count(q) == 0)
+                OPENFHE_THROW("The bootstrapping precomputation was written for different moduli");
+            moduli[i] = q;
+            roots[i]  = reader.Read<BasicInteger>();
+        }
+        params = std::make_shared<ILDCRTParams<DCRTPoly::Integer>>(M, moduli, roots);
+    }
+
+    const size_t towerBytes = N * sizeof(NativeInteger);
+
+    // the shape of each group is fully determined by the slots and the level budget: the linear transforms
+    // are a single row of one plaintext per slot (empty with the FFT-like method), and the FFT-like
+    // transforms have one row per level of the budget, with the collapsed remainder in the first row for
+    // encoding and in the last row for decoding
+    auto fftRowSizes = [](const std::vector<int32_t>& params, bool remFirst) {
+        uint32_t levelBudget = params[CKKS_BOOT_PARAMS::LEVEL_BUDGET];
+        std::vector<uint32_t> sizes(levelBudget, params[CKKS_BOOT_PARAMS::NUM_ROTATIONS]);
+        if (params[CKKS_BOOT_PARAMS::LAYERS_REM] != 0)
+            sizes[remFirst ? 0 : levelBudget - 1] = params[CKKS_BOOT_PARAMS::NUM_ROTATIONS_REM];
+        return sizes;
+    };
+    const std::vector<uint32_t> linearRowSizes{isLTBootstrap ? precom->m_slots : 0};
+    const std::vector<uint32_t> noRows;
+
+    auto readGroup = [&](std::vector<std::vector<ConstPlaintext>>& group, const std::vector<uint32_t>& rowSizes) {
+        group.resize(reader.ReadCount(rowSizes.size(), "rows"));
+        for (size_t r = 0; r < group.size(); ++r) {
+            auto& row = group[r];
+            row.resize(reader.ReadCount(rowSizes[r], "plaintexts in a row"));
+            for (auto& pt : row) {
+                if (reader.Read<uint32_t>() == 0)
+                    continue;
+                uint32_t index = reader.Read<uint32_t>();
+                if (index >= paramsTable.size())
+                    OPENFHE_THROW("Invalid parameter index in the bootstrapping precomputation");
+                auto format            = static_cast<Format>(reader.Read<uint32_t>());
+                uint32_t noiseScaleDeg = reader.Read<uint32_t>();
+                uint32_t level         = reader.Read<uint32_t>();
+                uint32_t slots         = reader.Read<uint32_t>();
+                double scFact          = reader.Read<double>();
+
+                Plaintext p = Plaintext(std::make_shared<CKKSPackedEncoding>(
+                    paramsTable[index], cc.GetEncodingParams(), std::vector<std::complex<double>>(), noiseScaleDeg,
+                    level, scFact, slots));
+
+                // the coefficients are read directly into the storage of the towers
+                DCRTPoly& element = p->GetElement<DCRTPoly>();
+                element           = DCRTPoly(paramsTable[index], format, true);
+                for (auto& tower : element.GetAllElements())
+                    reader.ReadBytes(&tower[0], towerBytes);
+                pt = p;
+            }
+        }
+    };
+
+    std::vector<std::vector<ConstPlaintext>> U0hatTPre;
+    std::vector<std::vector<ConstPlaintext>> U0Pre;
+    readGroup(U0hatTPre, linearRowSizes);
+    readGroup(U0Pre, linearRowSizes);
+    readGroup(precom->m_U0hatTPreFFT, isLTBootstrap ? noRows : fftRowSizes(paramsEnc, true));
+    readGroup(precom->m_U0PreFFT, isLTBootstrap ? noRows : fftRowSizes(paramsDec, false));
+    precom->m_U0hatTPre = std::move(U0hatTPre[0]);
+    precom->m_U0Pre     = std::move(U0Pre[0]);
+
+    m_correctionFactor               = correctionFactor;
+    m_bootPrecomMap[precom->m_slots] = precom;
+
+    return precom->m_slots;
+}
+
 Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphertext, uint32_t numIterations,
                                                uint32_t precision) const {
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
@@ -545,8 +847,8 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         auto ctxtEnc = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0hatTPre, raised) :
                                          EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised);
 
-        auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ctxtEnc->GetKeyTag());
-        auto conj       = Conjugate(ctxtEnc, evalKeyMap);
+        auto evalKeyMap = cc->GetEvalAutomorphismKeyMapPtr(ctxtEnc->GetKeyTag());
+        auto conj       = Conjugate(ctxtEnc, *evalKeyMap);
         auto ctxtEncI   = cc->EvalSub(ctxtEnc, conj);
         cc->EvalAddInPlace(ctxtEnc, conj);
         algo->MultByMonomialInPlace(ctxtEncI, 3 * M / 4);
@@ -645,8 +947,8 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         auto ctxtEnc = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0hatTPre, raised) :
                                          EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised);
 
-        auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ctxtEnc->GetKeyTag());
-        auto conj       = Conjugate(ctxtEnc, evalKeyMap);
+        auto evalKeyMap = cc->GetEvalAutomorphismKeyMapPtr(ctxtEnc->GetKeyTag());
+        auto conj       = Conjugate(ctxtEnc, *evalKeyMap);
         cc->EvalAddInPlace(ctxtEnc, conj);
 
         if (cryptoParams->GetScalingTechnique() == FIXEDMANUAL) {
@@ -2461,11 +2763,20 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalMultExt(ConstCiphertext<DCRTPoly> ciphertex
     Ciphertext<DCRTPoly> result = ciphertext->Clone();
     std::vector<DCRTPoly>& cv   = result->GetElements();
 
-    DCRTPoly pt = plaintext->GetElement<DCRTPoly>();
-    pt.SetFormat(Format::EVALUATION);
-
-    for (auto& c : cv) {
-        c *= pt;
+    // the precomputed plaintexts are already in EVALUATION format and are shared by concurrent
+    // bootstrappings, so they are only read
+    const DCRTPoly& pt = plaintext->GetElement<DCRTPoly>();
+    if (pt.GetFormat() == Format::EVALUATION) {
+        for (auto& c : cv) {
+            c *= pt;
+        }
+    }
+    else {
+        DCRTPoly ptEval = pt;
+        ptEval.SetFormat(Format::EVALUATION);
+        for (auto& c : cv) {
+            c *= ptEval;
+        }
     }
     result->SetNoiseScaleDeg(result->GetNoiseScaleDeg() + plaintext->GetNoiseScaleDeg());
     result->SetScalingFactor(result->GetScalingFactor() * plaintext->GetScalingFactor());
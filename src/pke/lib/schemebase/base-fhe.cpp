@@ -31,9 +31,81 @@
 
 #include "cryptocontext.h"
 #include "schemebase/base-fhe.h"
+#include "utils/parallel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
 
 namespace lbcrypto {
 
+template <class Element>
+std::vector<Ciphertext<Element>> FHEBase<Element>::EvalBootstrapBatch(
+    const std::vector<Ciphertext<Element>>& ciphertexts, uint32_t numIterations, uint32_t precision,
+    uint32_t numWorkers, BootstrapBatchStats* stats) const {
+    const uint32_t batchSize = ciphertexts.size();
+    std::vector<Ciphertext<Element>> result(batchSize);
+
+    // the threads available to the caller, which may itself be a worker of another batch
+    const uint32_t threads = OpenFHEParallelControls.GetThreadLimit(OpenFHEParallelControls.GetMachineThreads());
+    if (numWorkers == 0)
+        numWorkers = threads;
+    if (numWorkers > batchSize)
+        numWorkers = std::max<uint32_t>(batchSize, 1);
+
+    // the loops inside a bootstrapping only get threads of their own if a worker may start a nested parallel
+    // region; the OpenMP nesting settings of the caller are left as they are
+    bool nested = false;
+#ifdef PARALLEL
+    nested = omp_get_max_active_levels() > omp_get_active_level() + 1;
+#endif
+    const uint32_t threadsPerWorker =
+        (numWorkers == 1) ? threads : (nested ? std::max<uint32_t>(threads / numWorkers, 1) : 1);
+
+    auto start = std::chrono::steady_clock::now();
+
+    if (numWorkers == 1) {
+        for (uint32_t i = 0; i < batchSize; ++i)
+            result[i] = EvalBootstrap(ciphertexts[i], numIterations, precision);
+    }
+    else {
+        // exceptions cannot leave a parallel region; the first one is rethrown after the batch
+        std::exception_ptr error;
+#pragma omp parallel num_threads(numWorkers)
+        {
+            // caps the parallel loops inside the bootstrappings of this worker; the cap is per thread, so
+            // concurrent batches do not interfere
+            const int cap = OpenFHEParallelControls.SetThreadCap(threadsPerWorker);
+#pragma omp for schedule(dynamic)
+            for (uint32_t i = 0; i < batchSize; ++i) {
+                try {
+                    result[i] = EvalBootstrap(ciphertexts[i], numIterations, precision);
+                }
+                catch (...) {
+#pragma omp critical
+                    {
+                        if (!error)
+                            error = std::current_exception();
+                    }
+                }
+            }
+            OpenFHEParallelControls.SetThreadCap(cap);
+        }
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    if (stats != nullptr) {
+        double timeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        stats->numCiphertexts   = batchSize;
+        stats->numWorkers       = numWorkers;
+        stats->threadsPerWorker = threadsPerWorker;
+        stats->timeMs           = timeMs;
+        stats->throughput       = (timeMs > 0) ? batchSize * 1000.0 / timeMs : 0;
+    }
+    return result;
+}
+
 template class FHEBase<DCRTPoly>;
 
 }  // namespace lbcrypto
@@ -401,9 +401,16 @@ std::shared_ptr<std::map<uint32_t, EvalKey<Element>>> LeveledSHEBase<Element>::E
     for (auto indx : indexList) {
         (*evalKeys)[indx];
     }
+
+    // every key is sampled from its own stream of a seed drawn on the calling thread, so the keys depend
+    // neither on the number of threads nor on the order in which the threads generate them
+    const PRNGSeed seed = PseudoRandomNumberGenerator::GenerateSeed();
+
     size_t sz = indexList.size();
 #pragma omp parallel for if (sz >= 4)
     for (size_t i = 0; i < sz; ++i) {
+        PseudoRandomNumberGenerator::ScopedPRNG prng(PseudoRandomNumberGenerator::CreateSeededPRNG(seed, indexList[i]));
+
         PrivateKey<Element> privateKeyPermuted = std::make_shared<PrivateKeyImpl<Element>>(cc);
 
         uint32_t index = NativeInteger(indexList[i]).ModInverse(2 * N).ConvertToInt();
@@ -490,10 +497,10 @@ Ciphertext<Element> LeveledSHEBase<Element>::EvalFastRotation(
 
     usint autoIndex = FindAutomorphismIndex(index, m);
 
-    auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
+    auto evalKeyMap = cc->GetEvalAutomorphismKeyMapPtr(ciphertext->GetKeyTag());
     // verify if the key autoIndex exists in the evalKeyMap
-    auto evalKeyIterator = evalKeyMap.find(autoIndex);
-    if (evalKeyIterator == evalKeyMap.end()) {
+    auto evalKeyIterator = evalKeyMap->find(autoIndex);
+    if (evalKeyIterator == evalKeyMap->end()) {
         OPENFHE_THROW("EvalKey for index [" + std::to_string(autoIndex) + "] is not found.");
     }
     auto evalKey = evalKeyIterator->second;
@@ -305,18 +305,19 @@ EvalKey<Element> MultipartyBase<Element>::MultiAddEvalKeys(EvalKey<Element> eval
 
     EvalKey<Element> evalKeySum = std::make_shared<EvalKeyRelinImpl<Element>>(cc);
 
-    const std::vector<Element>& a  = evalKey1->GetAVector();
-    const std::vector<Element>& b1 = evalKey1->GetBVector();
-    const std::vector<Element>& b2 = evalKey2->GetBVector();
+    // pinned, as keys read from an EvalKeyStore may be unloaded when the other key is read
+    const auto a  = evalKey1->GetAVectorPtr();
+    const auto b1 = evalKey1->GetBVectorPtr();
+    const auto b2 = evalKey2->GetBVectorPtr();
 
     std::vector<Element> b;
-    b.reserve(a.size());
+    b.reserve(a->size());
 
-    for (usint i = 0; i < a.size(); i++) {
-        b.push_back(b1[i] + b2[i]);
+    for (usint i = 0; i < a->size(); i++) {
+        b.push_back((*b1)[i] + (*b2)[i]);
     }
 
-    evalKeySum->SetAVector(a);
+    evalKeySum->SetAVector(*a);
     evalKeySum->SetBVector(std::move(b));
 
     return evalKeySum;
@@ -329,19 +330,20 @@ EvalKey<Element> MultipartyBase<Element>::MultiAddEvalMultKeys(EvalKey<Element>
 
     EvalKey<Element> evalKeySum = std::make_shared<EvalKeyRelinImpl<Element>>(cc);
 
-    const std::vector<Element>& a1 = evalKey1->GetAVector();
-    const std::vector<Element>& a2 = evalKey2->GetAVector();
-    const std::vector<Element>& b1 = evalKey1->GetBVector();
-    const std::vector<Element>& b2 = evalKey2->GetBVector();
+    // pinned, as keys read from an EvalKeyStore may be unloaded when the other key is read
+    const auto a1 = evalKey1->GetAVectorPtr();
+    const auto a2 = evalKey2->GetAVectorPtr();
+    const auto b1 = evalKey1->GetBVectorPtr();
+    const auto b2 = evalKey2->GetBVectorPtr();
 
     std::vector<Element> a;
-    a.reserve(a1.size());
+    a.reserve(a1->size());
     std::vector<Element> b;
-    b.reserve(a1.size());
+    b.reserve(a1->size());
 
-    for (usint i = 0; i < a1.size(); i++) {
-        a.push_back(a1[i] + a2[i]);
-        b.push_back(b1[i] + b2[i]);
+    for (usint i = 0; i < a1->size(); i++) {
+        a.push_back((*a1)[i] + (*a2)[i]);
+        b.push_back((*b1)[i] + (*b2)[i]);
     }
 
     evalKeySum->SetAVector(std::move(a));
@@ -362,8 +364,10 @@ EvalKey<Element> MultipartyBase<Element>::MultiMultEvalKey(PrivateKey<Element> p
 
     EvalKey<Element> evalKeyResult = std::make_shared<EvalKeyRelinImpl<Element>>(cc);
 
-    const std::vector<Element>& a0 = evalKey->GetAVector();
-    const std::vector<Element>& b0 = evalKey->GetBVector();
+    const auto a0Ptr               = evalKey->GetAVectorPtr();
+    const auto b0Ptr               = evalKey->GetBVectorPtr();
+    const std::vector<Element>& a0 = *a0Ptr;
+    const std::vector<Element>& b0 = *b0Ptr;
 
     const Element& s = privateKey->GetPrivateElement();
     const auto ns    = cryptoParams->GetNoiseScale();
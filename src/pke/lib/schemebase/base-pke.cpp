@@ -35,6 +35,7 @@
 #include "key/publickey.h"
 #include "schemebase/rlwe-cryptoparameters.h"
 #include "cryptocontext.h"
+#include "globals.h"
 
 namespace lbcrypto {
 
@@ -77,7 +78,11 @@ KeyPair<Element> PKEBase<Element>::KeyGenInternal(CryptoContext<Element> cc, boo
 
     // Public Key Generation
 
-    Element a(dug, paramsPK, Format::EVALUATION);
+    // with seed compression enabled, "a" is derived from a fresh seed so that
+    // only the seed has to be stored next to "b" when the key is serialized
+    const bool seeded   = SeedCompression();
+    const PRNGSeed seed = seeded ? PseudoRandomNumberGenerator::GenerateSeed() : PRNGSeed{};
+    Element a(seeded ? GenerateSeededUniform<Element>(seed, 0, paramsPK) : Element(dug, paramsPK, Format::EVALUATION));
     Element e(dgg, paramsPK, Format::EVALUATION);
     Element b(ns * e - a * s);
 
@@ -89,6 +94,8 @@ KeyPair<Element> PKEBase<Element>::KeyGenInternal(CryptoContext<Element> cc, boo
 
     keyPair.secretKey->SetPrivateElement(std::move(s));
     keyPair.publicKey->SetPublicElements(std::vector<Element>{std::move(b), std::move(a)});
+    if (seeded)
+        keyPair.publicKey->SetPublicElementsSeed(seed);
     keyPair.publicKey->SetKeyTag(keyPair.secretKey->GetKeyTag());
 
     return keyPair;
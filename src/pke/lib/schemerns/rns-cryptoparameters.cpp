@@ -120,6 +120,24 @@ void CryptoParametersRNS::PrecomputeCRTTables(KeySwitchTechnique ksTech, Scaling
                 std::make_shared<ILDCRTParams<BigInteger>>(params[0]->GetCyclotomicOrder(), moduli, roots);
         }
 
+        // Pre-compute the truncated partitions used for the last digit of ciphertexts at lower levels
+        m_paramsPartQl.resize(m_numPartQ);
+        for (uint32_t j = 0; j < m_numPartQ; j++) {
+            const auto& params = m_paramsPartQ[j]->GetParams();
+            m_paramsPartQl[j].resize(params.size());
+            for (uint32_t l = 0; l + 1 < params.size(); l++) {
+                std::vector<NativeInteger> moduli(l + 1);
+                std::vector<NativeInteger> roots(l + 1);
+                for (uint32_t i = 0; i <= l; i++) {
+                    moduli[i] = params[i]->GetModulus();
+                    roots[i]  = params[i]->GetRootOfUnity();
+                }
+                m_paramsPartQl[j][l] =
+                    std::make_shared<ILDCRTParams<BigInteger>>(m_paramsPartQ[j]->GetCyclotomicOrder(), moduli, roots);
+            }
+            m_paramsPartQl[j].back() = m_paramsPartQ[j];
+        }
+
         // Find number and size of individual special primes.
         uint32_t maxBits = moduliPartQ[0].GetLengthForBase(2);
         for (uint32_t j = 1; j < m_numPartQ; j++) {
@@ -174,6 +192,19 @@ void CryptoParametersRNS::PrecomputeCRTTables(KeySwitchTechnique ksTech, Scaling
 
         m_paramsQP = std::make_shared<ILDCRTParams<BigInteger>>(2 * n, moduliQP, rootsQP);
 
+        // Pre-compute the CRT bases Q^(l) and Q^(l)*P for all levels
+        m_paramsQlModDown.resize(sizeQ);
+        m_paramsQlP.resize(sizeQ);
+        for (size_t l = 0; l < sizeQ; l++) {
+            std::vector<NativeInteger> moduliQl(moduliQ.begin(), moduliQ.begin() + l + 1);
+            std::vector<NativeInteger> rootsQl(rootsQ.begin(), rootsQ.begin() + l + 1);
+            m_paramsQlModDown[l] = std::make_shared<ILDCRTParams<BigInteger>>(2 * n, moduliQl, rootsQl);
+
+            moduliQl.insert(moduliQl.end(), moduliP.begin(), moduliP.end());
+            rootsQl.insert(rootsQl.end(), rootsP.begin(), rootsP.end());
+            m_paramsQlP[l] = std::make_shared<ILDCRTParams<BigInteger>>(2 * n, moduliQl, rootsQl);
+        }
+
         // Pre-compute CRT::FFT values for P
         ChineseRemainderTransformFTT<NativeVector>().PreCompute(rootsP, 2 * n, moduliP);
 
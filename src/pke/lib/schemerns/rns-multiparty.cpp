@@ -189,8 +189,10 @@ EvalKey<DCRTPoly> MultipartyRNS::MultiMultEvalKey(PrivateKey<DCRTPoly> privateKe
 
     EvalKey<DCRTPoly> evalKeyResult = std::make_shared<EvalKeyRelinImpl<DCRTPoly>>(evalKey->GetCryptoContext());
 
-    const std::vector<DCRTPoly>& a0 = evalKey->GetAVector();
-    const std::vector<DCRTPoly>& b0 = evalKey->GetBVector();
+    const auto a0Ptr                = evalKey->GetAVectorPtr();
+    const auto b0Ptr                = evalKey->GetBVectorPtr();
+    const std::vector<DCRTPoly>& a0 = *a0Ptr;
+    const std::vector<DCRTPoly>& b0 = *b0Ptr;
 
     const size_t size = a0.size();
 
@@ -33,10 +33,14 @@
 #include "key/privatekey.h"
 #include "key/publickey.h"
 #include "cryptocontext.h"
+#include "globals.h"
 
 namespace lbcrypto {
 
 Ciphertext<DCRTPoly> PKERNS::Encrypt(DCRTPoly plaintext, const PrivateKey<DCRTPoly> privateKey) const {
+    if (SeedCompression())
+        return EncryptSeeded(std::move(plaintext), privateKey);
+
     Ciphertext<DCRTPoly> ciphertext(std::make_shared<CiphertextImpl<DCRTPoly>>(privateKey));
 
     const std::shared_ptr<ParmType> ptxtParams = plaintext.GetParams();
@@ -52,6 +56,24 @@ Ciphertext<DCRTPoly> PKERNS::Encrypt(DCRTPoly plaintext, const PrivateKey<DCRTPo
     return ciphertext;
 }
 
+Ciphertext<DCRTPoly> PKERNS::EncryptSeeded(DCRTPoly plaintext, const PrivateKey<DCRTPoly> privateKey) const {
+    Ciphertext<DCRTPoly> ciphertext(std::make_shared<CiphertextImpl<DCRTPoly>>(privateKey));
+
+    const std::shared_ptr<ParmType> ptxtParams = plaintext.GetParams();
+    const PRNGSeed seed                        = PseudoRandomNumberGenerator::GenerateSeed();
+    std::shared_ptr<std::vector<DCRTPoly>> ba  = EncryptZeroCore(privateKey, ptxtParams, &seed);
+
+    plaintext.SetFormat(EVALUATION);
+
+    (*ba)[0] += plaintext;
+
+    ciphertext->SetElements({std::move((*ba)[0]), std::move((*ba)[1])});
+    ciphertext->SetElementsSeed(seed);
+    ciphertext->SetNoiseScaleDeg(1);
+
+    return ciphertext;
+}
+
 Ciphertext<DCRTPoly> PKERNS::Encrypt(DCRTPoly plaintext, const PublicKey<DCRTPoly> publicKey) const {
     Ciphertext<DCRTPoly> ciphertext(std::make_shared<CiphertextImpl<DCRTPoly>>(publicKey));
 
@@ -109,6 +131,12 @@ DecryptResult PKERNS::Decrypt(ConstCiphertext<DCRTPoly> ciphertext, const Privat
 
 std::shared_ptr<std::vector<DCRTPoly>> PKERNS::EncryptZeroCore(const PrivateKey<DCRTPoly> privateKey,
                                                                const std::shared_ptr<ParmType> params) const {
+    return EncryptZeroCore(privateKey, params, nullptr);
+}
+
+std::shared_ptr<std::vector<DCRTPoly>> PKERNS::EncryptZeroCore(const PrivateKey<DCRTPoly> privateKey,
+                                                               const std::shared_ptr<ParmType> params,
+                                                               const PRNGSeed* seed) const {
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(privateKey->GetCryptoParameters());
 
     const DCRTPoly& s  = privateKey->GetPrivateElement();
@@ -118,13 +146,16 @@ std::shared_ptr<std::vector<DCRTPoly>> PKERNS::EncryptZeroCore(const PrivateKey<
 
     const std::shared_ptr<ParmType> elementParams = (params == nullptr) ? cryptoParams->GetElementParams() : params;
 
-    DCRTPoly a(dug, elementParams, Format::EVALUATION);
+    // c1 is a fresh uniform element; with a seed it is derived from the seed, so that only c0 and the seed
+    // have to be serialized
+    DCRTPoly c1(seed ? GenerateSeededUniform<DCRTPoly>(*seed, 0, elementParams) :
+                       DCRTPoly(dug, elementParams, Format::EVALUATION));
     DCRTPoly e(dgg, elementParams, Format::EVALUATION);
 
     uint32_t sizeQ  = s.GetParams()->GetParams().size();
     uint32_t sizeQl = elementParams->GetParams().size();
 
-    DCRTPoly c0, c1;
+    DCRTPoly c0;
     if (sizeQl != sizeQ) {
         // Clone secret key because we need to drop towers.
         DCRTPoly scopy(s);
@@ -132,13 +163,11 @@ std::shared_ptr<std::vector<DCRTPoly>> PKERNS::EncryptZeroCore(const PrivateKey<
         uint32_t diffQl = sizeQ - sizeQl;
         scopy.DropLastElements(diffQl);
 
-        c0 = a * scopy + ns * e;
-        c1 = -a;
+        c0 = ns * e - c1 * scopy;
     }
     else {
         // Use secret key as is
-        c0 = a * s + ns * e;
-        c1 = -a;
+        c0 = ns * e - c1 * s;
     }
 
     return std::make_shared<std::vector<DCRTPoly>>(std::initializer_list<DCRTPoly>({std::move(c0), std::move(c1)}));
@@ -37,6 +37,10 @@
 #include "UnitTestUtils.h"
 #include "include/gtest/gtest.h"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 using namespace lbcrypto;
 
 class UTGENERAL_CRYPTOCONTEXTS : public ::testing::Test {
@@ -114,3 +118,71 @@ TEST_F(UTGENERAL_CRYPTOCONTEXTS, coexisting_ckks_cryptocontexts) {
     EXPECT_TRUE(checkEquality(values, results->GetRealPackedValue()))
         << "static data for the first cryptocontext may be overriden";
 }
+
+TEST_F(UTGENERAL_CRYPTOCONTEXTS, concurrent_key_registry_updates) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetMultiplicativeDepth(2);
+    parameters.SetScalingModSize(50);
+    parameters.SetRingDim(1024);
+    parameters.SetBatchSize(8);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    // the keys of the first tenant are used while the keys of other tenants are inserted and cleared
+    KeyPair<DCRTPoly> tenant = cc->KeyGen();
+    cc->EvalMultKeyGen(tenant.secretKey);
+    cc->EvalRotateKeyGen(tenant.secretKey, {1});
+
+    std::vector<double> values = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0};
+    Plaintext ptxt             = cc->MakeCKKSPackedPlaintext(values);
+    auto ciphertext            = cc->Encrypt(ptxt, tenant.publicKey);
+
+    std::vector<KeyPair<DCRTPoly>> others;
+    for (size_t i = 0; i < 4; ++i)
+        others.push_back(cc->KeyGen());
+
+    std::atomic<bool> done{false};
+    std::thread writer([&]() {
+        for (size_t round = 0; round < 4; ++round) {
+            for (const auto& kp : others) {
+                cc->EvalMultKeyGen(kp.secretKey);
+                cc->EvalRotateKeyGen(kp.secretKey, {1, 2});
+            }
+            for (const auto& kp : others) {
+                CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys(kp.secretKey->GetKeyTag());
+                CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys(kp.secretKey->GetKeyTag());
+            }
+        }
+        done = true;
+    });
+
+    std::vector<double> rotated(values.begin() + 1, values.end());
+    rotated.push_back(values[0]);
+    std::vector<double> squares(values.size());
+    for (size_t i = 0; i < values.size(); ++i)
+        squares[i] = values[i] * values[i];
+
+    Plaintext results;
+    do {
+        cc->Decrypt(tenant.secretKey, cc->EvalRotate(ciphertext, 1), &results);
+        results->SetLength(values.size());
+        EXPECT_TRUE(checkEquality(rotated, results->GetRealPackedValue(), EPSILON_HIGH))
+            << "EvalRotate fails during key updates";
+
+        cc->Decrypt(tenant.secretKey, cc->EvalMult(ciphertext, ciphertext), &results);
+        results->SetLength(values.size());
+        EXPECT_TRUE(checkEquality(squares, results->GetRealPackedValue(), EPSILON_HIGH))
+            << "EvalMult fails during key updates";
+    } while (!done);
+    writer.join();
+
+    EXPECT_EQ(CryptoContextImpl<DCRTPoly>::GetAllEvalMultKeys().size(), 1U) << "keys of other tenants are left";
+    EXPECT_EQ(CryptoContextImpl<DCRTPoly>::GetAllEvalAutomorphismKeys().size(), 1U) << "keys of other tenants are left";
+
+    CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+    CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+}
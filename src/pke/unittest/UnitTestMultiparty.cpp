@@ -388,11 +388,11 @@ protected:
 
             auto evalMultKey = cc->KeySwitchGen(kp1.secretKey, kp1.secretKey);
             cc->EvalSumKeyGen(kp1.secretKey);
-            auto evalSumKeys =
-                std::make_shared<std::map<usint, EvalKey<Element>>>(cc->GetEvalSumKeyMap(kp1.secretKey->GetKeyTag()));
+            auto evalSumKeys = std::make_shared<std::map<usint, EvalKey<Element>>>(
+                *cc->GetEvalSumKeyMapPtr(kp1.secretKey->GetKeyTag()));
             cc->EvalAtIndexKeyGen(kp1.secretKey, indices);
             auto evalAtIndexKeys = std::make_shared<std::map<usint, EvalKey<Element>>>(
-                cc->GetEvalAutomorphismKeyMap(kp1.secretKey->GetKeyTag()));
+                *cc->GetEvalAutomorphismKeyMapPtr(kp1.secretKey->GetKeyTag()));
             //====================================================================
             KeyPair<Element> kp2 =
                 testData.star ? cc->MultipartyKeyGen(kp1.publicKey) : cc->MultipartyKeyGen(kp1.publicKey, false, true);
@@ -811,7 +811,7 @@ protected:
         // Generate evalsum key part for A
         cc->EvalSumKeyGen(kp1.secretKey);
         auto evalSumKeys =
-            std::make_shared<std::map<usint, EvalKey<DCRTPoly>>>(cc->GetEvalSumKeyMap(kp1.secretKey->GetKeyTag()));
+            std::make_shared<std::map<usint, EvalKey<DCRTPoly>>>(*cc->GetEvalSumKeyMapPtr(kp1.secretKey->GetKeyTag()));
 
         // Round 2 (party B)
         KeyPair<DCRTPoly> kp2 = cc->MultipartyKeyGen(kp1.publicKey);
@@ -40,7 +40,10 @@
 #include "cryptocontext-ser.h"
 #include "scheme/ckksrns/ckksrns-ser.h"
 
+#include <algorithm>
 #include <iostream>
+#include <sstream>
+#include <string>
 #include <vector>
 #include "gtest/gtest.h"
 #include <iterator>
@@ -56,6 +59,8 @@ enum TEST_CASE_TYPE {
     BOOTSTRAP_ITERATIVE,
     BOOTSTRAP_NUM_TOWERS,
     BOOTSTRAP_SERIALIZE,
+    BOOTSTRAP_BATCH,
+    BOOTSTRAP_PRECOM_SAVE_LOAD,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -82,6 +87,12 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case BOOTSTRAP_SERIALIZE:
             typeName = "BOOTSTRAP_SERIALIZE";
             break;
+        case BOOTSTRAP_BATCH:
+            typeName = "BOOTSTRAP_BATCH";
+            break;
+        case BOOTSTRAP_PRECOM_SAVE_LOAD:
+            typeName = "BOOTSTRAP_PRECOM_SAVE_LOAD";
+            break;
         default:
             typeName = "UNKNOWN";
             break;
@@ -311,6 +322,15 @@ static std::vector<TEST_CASE_UTCKKSRNS_BOOT> testCases = {
     { BOOTSTRAP_SERIALIZE, "05", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 4, 4 },   RDIM/2 },
     { BOOTSTRAP_SERIALIZE, "06", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 4, 4 },   RDIM/2 },
     // ==========================================
+    // TestType,       Descr, Scheme,         RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,       Slots
+    { BOOTSTRAP_BATCH, "01", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 0, 0 },   RDIM/2 },
+    { BOOTSTRAP_BATCH, "02", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  8,       SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 },   8 },
+    // ==========================================
+    // TestType,                  Descr, Scheme,         RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,       Slots
+    { BOOTSTRAP_PRECOM_SAVE_LOAD, "01", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 32, 32 }, RDIM/2 },
+    { BOOTSTRAP_PRECOM_SAVE_LOAD, "02", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 0, 0 },   RDIM/2 },
+    { BOOTSTRAP_PRECOM_SAVE_LOAD, "03", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  8,       UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 },   8 },
+    // ==========================================
 };
 // clang-format on
 //===========================================================================================================
@@ -701,6 +721,123 @@ protected:
             UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
         }
     }
+
+    void UnitTest_Bootstrap_Batch(const TEST_CASE_UTCKKSRNS_BOOT& testData,
+                                  const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            cc->EvalBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots);
+
+            auto keyPair = cc->KeyGen();
+            cc->EvalBootstrapKeyGen(keyPair.secretKey, testData.slots);
+            cc->EvalMultKeyGen(keyPair.secretKey);
+
+            constexpr uint32_t BATCH_SIZE = 3;
+            std::vector<std::vector<std::complex<double>>> inputs(BATCH_SIZE);
+            std::vector<Ciphertext<Element>> ciphertexts(BATCH_SIZE);
+            for (uint32_t i = 0; i < BATCH_SIZE; ++i) {
+                inputs[i] = Fill({0.1 * (i + 1), -0.2, 0.3, 0.05 * i}, testData.slots);
+                Plaintext plaintext =
+                    cc->MakeCKKSPackedPlaintext(inputs[i], 1, MULT_DEPTH - 1, nullptr, testData.slots);
+                ciphertexts[i] = cc->Encrypt(keyPair.publicKey, plaintext);
+            }
+
+            // both a single worker and concurrent workers must give the results of EvalBootstrap
+            for (uint32_t numWorkers : {1u, 2u}) {
+                BootstrapBatchStats stats;
+                auto results = cc->EvalBootstrapBatch(ciphertexts, 1, 0, numWorkers, &stats);
+                EXPECT_EQ(results.size(), BATCH_SIZE) << failmsg;
+                EXPECT_EQ(stats.numCiphertexts, BATCH_SIZE) << failmsg;
+                // the requested workers are used even on machines with fewer threads
+                EXPECT_EQ(stats.numWorkers, numWorkers) << failmsg;
+                EXPECT_GE(stats.threadsPerWorker, 1u) << failmsg;
+
+                for (uint32_t i = 0; i < BATCH_SIZE; ++i) {
+                    Plaintext result;
+                    cc->Decrypt(keyPair.secretKey, results[i], &result);
+                    result->SetLength(inputs[i].size());
+                    checkEquality(result->GetCKKSPackedValue(), inputs[i], eps,
+                                  failmsg + " EvalBootstrapBatch fails for ciphertext " + std::to_string(i));
+                }
+            }
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
+
+    void UnitTest_Bootstrap_PrecomSaveLoad(const TEST_CASE_UTCKKSRNS_BOOT& testData,
+                                           const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            cc->EvalBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots);
+
+            // the precomputation does not start at the beginning of the stream
+            std::stringstream s;
+            s << 'x';
+            cc->SaveEvalBootstrapPrecomputation(s, testData.slots);
+            const std::string saved = s.str();
+
+            // drop the precomputed plaintexts and restore them from the stream
+            cc->EvalBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots, 0, false);
+            EXPECT_EQ(s.get(), 'x') << failmsg;
+            EXPECT_EQ(cc->LoadEvalBootstrapPrecomputation(s), testData.slots) << failmsg;
+
+            auto keyPair = cc->KeyGen();
+            cc->EvalBootstrapKeyGen(keyPair.secretKey, testData.slots);
+            cc->EvalMultKeyGen(keyPair.secretKey);
+
+            std::vector<std::complex<double>> input(
+                Fill({0.111111, 0.222222, 0.333333, 0.444444, 0.555555, 0.666666, 0.777777, 0.888888},
+                     testData.slots));
+            Plaintext plaintext = cc->MakeCKKSPackedPlaintext(input, 1, MULT_DEPTH - 1, nullptr, testData.slots);
+            auto ciphertext     = cc->Encrypt(keyPair.publicKey, plaintext);
+
+            auto ciphertextAfter = cc->EvalBootstrap(ciphertext);
+
+            Plaintext result;
+            cc->Decrypt(keyPair.secretKey, ciphertextAfter, &result);
+            result->SetLength(input.size());
+            checkEquality(result->GetCKKSPackedValue(), input, eps,
+                          failmsg + " Bootstrapping with loaded precomputations fails");
+
+            // a truncated stream must be rejected
+            std::string truncated = saved.substr(1, saved.size() / 2);
+            std::stringstream t(truncated);
+            EXPECT_THROW(cc->LoadEvalBootstrapPrecomputation(t), OpenFHEException) << failmsg;
+
+            // so must a level budget the slots do not allow (the first entry of the encoding parameters follows
+            // the magic tag, seven 32-bit header fields and the number of parameters)
+            std::string corrupted = saved.substr(1);
+            uint32_t levelBudget  = 1000;
+            corrupted.replace(8 + 8 * sizeof(uint32_t), sizeof(levelBudget),
+                              reinterpret_cast<const char*>(&levelBudget), sizeof(levelBudget));
+            std::stringstream c(corrupted);
+            EXPECT_THROW(cc->LoadEvalBootstrapPrecomputation(c), OpenFHEException) << failmsg;
+
+            // and a stream written with the other byte order (the byte order mark follows the magic tag and the
+            // version)
+            std::string swapped = saved.substr(1);
+            std::reverse(swapped.begin() + 8 + sizeof(uint32_t), swapped.begin() + 8 + 2 * sizeof(uint32_t));
+            std::stringstream b(swapped);
+            EXPECT_THROW(cc->LoadEvalBootstrapPrecomputation(b), OpenFHEException) << failmsg;
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
 };
 
 //===========================================================================================================
@@ -726,6 +863,12 @@ TEST_P(UTCKKSRNS_BOOT, CKKSRNS) {
         case BOOTSTRAP_SERIALIZE:
             UnitTest_Bootstrap_Serialize(test, test.buildTestName());
             break;
+        case BOOTSTRAP_BATCH:
+            UnitTest_Bootstrap_Batch(test, test.buildTestName());
+            break;
+        case BOOTSTRAP_PRECOM_SAVE_LOAD:
+            UnitTest_Bootstrap_PrecomSaveLoad(test, test.buildTestName());
+            break;
         default:
             break;
     }
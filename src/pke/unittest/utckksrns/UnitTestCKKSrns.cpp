@@ -1484,6 +1484,40 @@ protected:
             results->SetLength(plaintextRight2->GetLength());
             checkEquality(plaintextRight2->GetCKKSPackedValue(), results->GetCKKSPackedValue(), eps,
                           failmsg + " EvalFastRotation(-2) fails");
+
+            /* Testing EvalRotateMany {+2, -2, 0}
+             */
+            auto cRotated = cc->EvalRotateMany(ciphertext1, {2, -2, 0});
+            EXPECT_EQ(cRotated.size(), 3U) << failmsg << " EvalRotateMany returns a wrong number of ciphertexts";
+            cc->Decrypt(kp.secretKey, cRotated[0], &results);
+            results->SetLength(plaintextLeft2->GetLength());
+            checkEquality(plaintextLeft2->GetCKKSPackedValue(), results->GetCKKSPackedValue(), eps,
+                          failmsg + " EvalRotateMany(+2) fails");
+            cc->Decrypt(kp.secretKey, cRotated[1], &results);
+            results->SetLength(plaintextRight2->GetLength());
+            checkEquality(plaintextRight2->GetCKKSPackedValue(), results->GetCKKSPackedValue(), eps,
+                          failmsg + " EvalRotateMany(-2) fails");
+            cc->Decrypt(kp.secretKey, cRotated[2], &results);
+            results->SetLength(plaintext1->GetLength());
+            checkEquality(plaintext1->GetCKKSPackedValue(), results->GetCKKSPackedValue(), eps,
+                          failmsg + " EvalRotateMany(0) fails");
+
+            /* Testing EvalRotateManySum {+2, -2, 0} (hybrid key switching only)
+             */
+            const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(cc->GetCryptoParameters());
+            if (cryptoParams->GetKeySwitchTechnique() == HYBRID) {
+                std::vector<std::complex<double>> vSum(slots);
+                for (uint32_t i = 0; i < slots; i++) {
+                    vSum[i] = vIntsLeftRotate2[i] + vIntsRightRotate2[i] + vectorOfInts1[i];
+                }
+                Plaintext plaintextSum = cc->MakeCKKSPackedPlaintext(vSum, 1, 0, nullptr, testData.slots);
+
+                cResult = cc->EvalRotateManySum(ciphertext1, {2, -2, 0});
+                cc->Decrypt(kp.secretKey, cResult, &results);
+                results->SetLength(plaintextSum->GetLength());
+                checkEquality(plaintextSum->GetCKKSPackedValue(), results->GetCKKSPackedValue(), eps,
+                              failmsg + " EvalRotateManySum fails");
+            }
         }
         catch (std::exception& e) {
             std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
@@ -48,6 +48,7 @@ enum TEST_CASE_TYPE {
     EVAL_SUM_PACKED_ARRAY,
     EVAL_SUM_ROWS,
     EVAL_SUM_COLS,
+    EVAL_AUTOMORPHISM_KEYGEN,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -65,6 +66,9 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case EVAL_SUM_COLS:
             typeName = "EVAL_SUM_COLS";
             break;
+        case EVAL_AUTOMORPHISM_KEYGEN:
+            typeName = "EVAL_AUTOMORPHISM_KEYGEN";
+            break;
         default:
             typeName = "UNKNOWN_UTCKKSRNS_AUTOMORPHISM";
             break;
@@ -193,6 +197,10 @@ static std::vector<TEST_CASE_UTCKKSRNS_AUTOMORPHISM> testCasesUTCKKSRNS_AUTOMORP
     // ==========================================
     // TestType,    Descr,  Scheme,         RDim,     MultDepth,  SModSize, DSize,BatchSz,    SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,  KSTech, ScalTech, LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, Error,               indexList
     { EVAL_SUM_COLS, "01", {CKKSRNS_SCHEME, RING_DIM, DFLT,       DFLT,     DFLT, RING_DIM/2, DFLT,       DFLT,          DFLT,     SEC_LVL, DFLT,   DFLT,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   SUCCESS },
+    // ==========================================
+    // TestType,               Descr,  Scheme,         RDim,     MultDepth,  SModSize, DSize,BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,  KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, Error,               indexList
+    { EVAL_AUTOMORPHISM_KEYGEN, "01", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, DFLT, BATCH,   DFLT,       DFLT,          DFLT,     SEC_LVL, BV,     FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   SUCCESS,             initIndexList },
+    { EVAL_AUTOMORPHISM_KEYGEN, "02", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, DFLT, BATCH,   DFLT,       DFLT,          DFLT,     SEC_LVL, HYBRID, FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   SUCCESS,             initIndexList },
 };
 // clang-format on
 //===========================================================================================================
@@ -440,6 +448,61 @@ protected:
             UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
         }
     }
+
+    void UnitTest_EvalAutomorphismKeyGen(const TEST_CASE_UTCKKSRNS_AUTOMORPHISM& testData,
+                                         const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            KeyPair<Element> kp = cc->KeyGen();
+
+            std::vector<int32_t> indices(testData.indexList);
+            for (auto index : testData.indexList)
+                indices.push_back(-index);
+
+            // the keys depend only on the PRNG of the calling thread, not on the number of threads generating them
+            const PRNGSeed seed = PseudoRandomNumberGenerator::GenerateSeed();
+            auto generateKeys   = [&](bool parallel) {
+                if (parallel)
+                    OpenFHEParallelControls.Enable();
+                else
+                    OpenFHEParallelControls.Disable();
+                CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+                PseudoRandomNumberGenerator::ScopedPRNG prng(PseudoRandomNumberGenerator::CreateSeededPRNG(seed));
+                cc->EvalAtIndexKeyGen(kp.secretKey, indices);
+                return CryptoContextImpl<DCRTPoly>::GetEvalAutomorphismKeyMapPtr(kp.secretKey->GetKeyTag());
+            };
+            const auto sequentialKeys = generateKeys(false);
+            const auto parallelKeys   = generateKeys(true);
+
+            EXPECT_EQ(sequentialKeys->size(), indices.size()) << failmsg << " wrong number of keys";
+            EXPECT_EQ(sequentialKeys->size(), parallelKeys->size()) << failmsg << " wrong number of keys";
+            for (const auto& [indx, key] : *sequentialKeys) {
+                auto it = parallelKeys->find(indx);
+                EXPECT_TRUE(it != parallelKeys->end() && *key == *it->second)
+                    << failmsg << " keys generated in parallel differ for index " << indx;
+            }
+
+            // the generated keys work
+            Plaintext plaintext            = cc->MakeCKKSPackedPlaintext(vector8Complex);
+            Ciphertext<Element> ciphertext = cc->Encrypt(kp.publicKey, plaintext);
+            Plaintext result;
+            cc->Decrypt(kp.secretKey, cc->EvalAtIndex(cc->EvalAtIndex(ciphertext, indices[0]), -indices[0]), &result);
+            result->SetLength(vector8Complex.size());
+            checkEquality(result->GetCKKSPackedValue(), vector8Complex, eps,
+                          failmsg + " EvalAtIndex with keys generated in parallel fails");
+
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
 };
 //===========================================================================================================
 TEST_P(UTCKKSRNS_AUTOMORPHISM, Automorphism) {
@@ -459,6 +522,9 @@ TEST_P(UTCKKSRNS_AUTOMORPHISM, Automorphism) {
         case EVAL_SUM_COLS:
             UnitTest_EvalSumCols(test, test.buildTestName());
             break;
+        case EVAL_AUTOMORPHISM_KEYGEN:
+            UnitTest_EvalAutomorphismKeyGen(test, test.buildTestName());
+            break;
         default:
             break;
     }
@@ -34,7 +34,10 @@
 #include "UnitTestCCParams.h"
 #include "UnitTestCryptoContext.h"
 
+#include <atomic>
+#include <filesystem>
 #include <iostream>
+#include <thread>
 #include <vector>
 #include "gtest/gtest.h"
 
@@ -50,6 +53,9 @@ enum TEST_CASE_TYPE {
     CONTEXT_WITH_SERTYPE = 0,
     KEYS_AND_CIPHERTEXTS,
     NO_CRT_TABLES,
+    SEED_COMPRESSION,
+    KEY_STORE,
+    KEY_STREAM,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -64,6 +70,15 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case NO_CRT_TABLES:
             typeName = "NO_CRT_TABLES";
             break;
+        case SEED_COMPRESSION:
+            typeName = "SEED_COMPRESSION";
+            break;
+        case KEY_STORE:
+            typeName = "KEY_STORE";
+            break;
+        case KEY_STREAM:
+            typeName = "KEY_STREAM";
+            break;
         default:
             typeName = "UNKNOWN";
             break;
@@ -168,6 +183,21 @@ static std::vector<TEST_CASE_UTCKKSRNS_SER> testCases = {
     { NO_CRT_TABLES, "08", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, 0,     BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
 #endif
     // ==========================================
+    // TestType,        Descr, Scheme,         RDim,     MultDepth,  SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech,  EncTech, PREMode
+    { SEED_COMPRESSION, "01", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, 0,     BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+    { SEED_COMPRESSION, "02", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, 0,     BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+#if NATIVEINT != 128
+    { SEED_COMPRESSION, "03", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, 0,     BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+#endif
+    // ==========================================
+    // TestType, Descr, Scheme,         RDim,     MultDepth,  SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech,  EncTech, PREMode
+    { KEY_STORE, "01", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, 0,     BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+    { KEY_STORE, "02", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, 0,     BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+    // ==========================================
+    // TestType,  Descr, Scheme,         RDim,     MultDepth,  SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech,  EncTech, PREMode
+    { KEY_STREAM, "01", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, 0,     BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+    { KEY_STREAM, "02", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, 0,     BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+    // ==========================================
 };
 // clang-format on
 //===========================================================================================================
@@ -187,6 +217,7 @@ protected:
 
         UnitTestContextWithSertype(cc, SerType::JSON, "json");
         UnitTestContextWithSertype(cc, SerType::BINARY, "binary");
+        UnitTestContextWithSertype(cc, SerType::COMPACT, "compact");
     }
 
     template <typename ST>
@@ -376,6 +407,7 @@ protected:
                                     const std::string& failmsg = std::string()) {
         TestKeysAndCiphertexts(testData, SerType::JSON, "json");
         TestKeysAndCiphertexts(testData, SerType::BINARY, "binary");
+        TestKeysAndCiphertexts(testData, SerType::COMPACT, "compact");
     }
 
     template <typename ST>
@@ -454,6 +486,298 @@ protected:
                                           const std::string& failmsg = std::string()) {
         TestDecryptionSerNoCRTTables(testData, SerType::JSON, "json");
         TestDecryptionSerNoCRTTables(testData, SerType::BINARY, "binary");
+        TestDecryptionSerNoCRTTables(testData, SerType::COMPACT, "compact");
+    }
+
+    template <typename ST>
+    void TestSeedCompression(const TEST_CASE_UTCKKSRNS_SER& testData, const ST& sertype,
+                             const std::string& failmsg = std::string()) {
+        try {
+            CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+            CryptoContextImpl<DCRTPoly>::ClearEvalSumKeys();
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+
+            EnableSeedCompression();
+
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            KeyPair<Element> kp = cc->KeyGen();
+            EXPECT_TRUE(kp.publicKey->IsSeeded()) << failmsg << " public key is not seeded";
+            cc->EvalMultKeyGen(kp.secretKey);
+            cc->EvalRotateKeyGen(kp.secretKey, {1});
+
+            std::vector<std::complex<double>> vals = {1.0, 3.0, 5.0, 7.0, 9.0, 2.0, 4.0, 6.0, 8.0, 11.0};
+            Plaintext plaintextShort               = cc->MakeCKKSPackedPlaintext(vals);
+            Ciphertext<DCRTPoly> ciphertext        = cc->Encrypt(kp.secretKey, plaintextShort);
+            EXPECT_TRUE(ciphertext->IsSeeded()) << failmsg << " ciphertext is not seeded";
+
+            // the seeded objects serialize smaller than their fully expanded copies
+            Ciphertext<DCRTPoly> ciphertextFull = ciphertext->Clone();
+            EXPECT_FALSE(ciphertextFull->IsSeeded()) << failmsg << " cloned ciphertext is still seeded";
+            std::stringstream sc, scFull;
+            Serial::Serialize(ciphertext, sc, sertype);
+            Serial::Serialize(ciphertextFull, scFull, sertype);
+            EXPECT_LT(sc.str().size(), scFull.str().size()) << failmsg << " seeded ciphertext is not smaller";
+
+            auto publicKeyFull = std::make_shared<PublicKeyImpl<DCRTPoly>>(*kp.publicKey);
+            publicKeyFull->SetPublicElements(kp.publicKey->GetPublicElements());
+            std::stringstream sp, spFull;
+            Serial::Serialize(kp.publicKey, sp, sertype);
+            Serial::Serialize(publicKeyFull, spFull, sertype);
+            EXPECT_LT(sp.str().size(), spFull.str().size()) << failmsg << " seeded public key is not smaller";
+
+            std::stringstream smult, srot;
+            CryptoContextImpl<DCRTPoly>::SerializeEvalMultKey(smult, sertype, kp.secretKey->GetKeyTag());
+            CryptoContextImpl<DCRTPoly>::SerializeEvalAutomorphismKey(srot, sertype, kp.secretKey->GetKeyTag());
+
+            // everything below must be regenerated from the seeds
+            CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            DisableSeedCompression();
+
+            Ciphertext<DCRTPoly> newC;
+            Serial::Deserialize(newC, sc, sertype);
+            EXPECT_EQ(*ciphertextFull, *newC) << failmsg << " ciphertext mismatch";
+
+            PublicKey<DCRTPoly> newPub;
+            Serial::Deserialize(newPub, sp, sertype);
+            EXPECT_EQ(*publicKeyFull, *newPub) << failmsg << " public key mismatch";
+
+            CryptoContextImpl<DCRTPoly>::DeserializeEvalMultKey(smult, sertype);
+            CryptoContextImpl<DCRTPoly>::DeserializeEvalAutomorphismKey(srot, sertype);
+
+            Plaintext result;
+            cc->Decrypt(kp.secretKey, cc->EvalMult(newC, newC), &result);
+            result->SetLength(plaintextShort->GetLength());
+            std::vector<std::complex<double>> squares(vals.size());
+            for (size_t i = 0; i < vals.size(); ++i)
+                squares[i] = vals[i] * vals[i];
+            checkEquality(squares, result->GetCKKSPackedValue(), eps, failmsg + " EvalMult after seeded keys fails");
+
+            cc->Decrypt(kp.secretKey, cc->EvalRotate(newC, 1), &result);
+            result->SetLength(vals.size() - 1);
+            std::vector<std::complex<double>> rotated(vals.begin() + 1, vals.end());
+            checkEquality(rotated, result->GetCKKSPackedValue(), eps, failmsg + " EvalRotate after seeded keys fails");
+
+            // a public-key encryption under the regenerated key decrypts correctly
+            cc->Decrypt(kp.secretKey, cc->Encrypt(newPub, plaintextShort), &result);
+            result->SetLength(plaintextShort->GetLength());
+            checkEquality(plaintextShort->GetCKKSPackedValue(), result->GetCKKSPackedValue(), eps,
+                          failmsg + " encryption with the seeded public key fails");
+
+            // the seeded evaluation keys serialize smaller than keys generated without seed compression
+            CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            cc->EvalMultKeyGen(kp.secretKey);
+            cc->EvalRotateKeyGen(kp.secretKey, {1});
+            std::stringstream smultFull, srotFull;
+            CryptoContextImpl<DCRTPoly>::SerializeEvalMultKey(smultFull, sertype, kp.secretKey->GetKeyTag());
+            CryptoContextImpl<DCRTPoly>::SerializeEvalAutomorphismKey(srotFull, sertype, kp.secretKey->GetKeyTag());
+            EXPECT_LT(smult.str().size(), smultFull.str().size()) << failmsg << " seeded EvalMult key is not smaller";
+            EXPECT_LT(srot.str().size(), srotFull.str().size()) << failmsg << " seeded rotation keys are not smaller";
+
+            CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+            CryptoContextImpl<DCRTPoly>::ClearEvalSumKeys();
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+        }
+        catch (std::exception& e) {
+            DisableSeedCompression();
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            DisableSeedCompression();
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
+    void UnitTestSeedCompression(const TEST_CASE_UTCKKSRNS_SER& testData, const std::string& failmsg = std::string()) {
+        TestSeedCompression(testData, SerType::JSON, "json");
+        TestSeedCompression(testData, SerType::BINARY, "binary");
+    }
+
+    template <typename ST>
+    void TestKeyStore(const TEST_CASE_UTCKKSRNS_SER& testData, const ST& sertype,
+                      const std::string& failmsg = std::string()) {
+        const auto filename = (std::filesystem::temp_directory_path() / ("UTCKKSRNS_SER_keystore_" + failmsg)).string();
+        try {
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            KeyPair<Element> kp                  = cc->KeyGen();
+            const std::vector<int32_t> rotations = {1, 2, 3, -1};
+            cc->EvalRotateKeyGen(kp.secretKey, rotations);
+
+            std::vector<std::complex<double>> vals = {1.0, 3.0, 5.0, 7.0, 9.0, 2.0, 4.0, 6.0};
+            Plaintext plaintext                    = cc->MakeCKKSPackedPlaintext(vals);
+            Ciphertext<DCRTPoly> ciphertext        = cc->Encrypt(kp.publicKey, plaintext);
+
+            const std::string keyTag = kp.secretKey->GetKeyTag();
+            EXPECT_TRUE(CryptoContextImpl<DCRTPoly>::SerializeEvalAutomorphismKeyStore(filename, sertype, keyTag))
+                << failmsg << " key store serialization failed";
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+
+            // a budget of 1 byte keeps only the key used last in memory
+            EXPECT_TRUE(CryptoContextImpl<DCRTPoly>::DeserializeEvalAutomorphismKeyStore(filename, sertype, 1))
+                << failmsg << " key store deserialization failed";
+
+            const auto keyMap = CryptoContextImpl<DCRTPoly>::GetEvalAutomorphismKeyMapPtr(keyTag);
+            EXPECT_EQ(keyMap->size(), rotations.size()) << failmsg << " wrong number of keys in the store";
+            auto loadedKeys = [&keyMap]() {
+                size_t n = 0;
+                for (const auto& k : *keyMap)
+                    n += std::static_pointer_cast<EvalKeyRelinImpl<DCRTPoly>>(k.second)->IsLoaded();
+                return n;
+            };
+            EXPECT_EQ(loadedKeys(), 0u) << failmsg << " keys are loaded before they are used";
+
+            // rotate twice to use every key again after it was unloaded
+            Plaintext result;
+            for (size_t pass = 0; pass < 2; ++pass) {
+                for (int32_t r : rotations) {
+                    cc->Decrypt(kp.secretKey, cc->EvalRotate(ciphertext, r), &result);
+                    result->SetLength(vals.size());
+                    std::vector<std::complex<double>> expected(vals.size());
+                    const int32_t n = cc->GetEncodingParams()->GetBatchSize();
+                    for (int32_t i = 0; i < static_cast<int32_t>(vals.size()); ++i) {
+                        const int32_t j = ((i + r) % n + n) % n;
+                        expected[i]     = j < static_cast<int32_t>(vals.size()) ? vals[j] : 0.0;
+                    }
+                    checkEquality(expected, result->GetCKKSPackedValue(), eps,
+                                  failmsg + " EvalRotate with a stored key fails for index " + std::to_string(r));
+                    EXPECT_EQ(loadedKeys(), 1u) << failmsg << " the memory budget is not enforced";
+                }
+            }
+
+            // a vector pinned by a reader survives the unloading of its key
+            auto first  = std::static_pointer_cast<EvalKeyRelinImpl<DCRTPoly>>(keyMap->begin()->second);
+            auto second = std::static_pointer_cast<EvalKeyRelinImpl<DCRTPoly>>(std::next(keyMap->begin())->second);
+            const auto pinned = first->GetBVectorPtr();
+            const std::vector<DCRTPoly> copy(*pinned);
+            second->GetBVector();
+            EXPECT_FALSE(first->IsLoaded()) << failmsg << " the key was not unloaded";
+            EXPECT_EQ(*pinned, copy) << failmsg << " a pinned vector was freed by the unloading of its key";
+
+            // keys are loaded and unloaded by several threads at the same time
+            std::vector<std::vector<DCRTPoly>> expectedB;
+            for (const auto& k : *keyMap)
+                expectedB.push_back(*k.second->GetBVectorPtr());
+            std::atomic<size_t> mismatches{0};
+            std::vector<std::thread> threads;
+            for (size_t t = 0; t < 4; ++t) {
+                threads.emplace_back([&, t]() {
+                    for (size_t pass = 0; pass < 16; ++pass) {
+                        const size_t i = (t + pass) % keyMap->size();
+                        try {
+                            if (*std::next(keyMap->begin(), i)->second->GetBVectorPtr() != expectedB[i])
+                                ++mismatches;
+                        }
+                        catch (...) {
+                            ++mismatches;
+                        }
+                    }
+                });
+            }
+            for (auto& thread : threads)
+                thread.join();
+            EXPECT_EQ(mismatches.load(), 0u) << failmsg << " a key was read wrongly while other threads unloaded it";
+
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+            std::filesystem::remove(filename);
+        }
+        catch (std::exception& e) {
+            std::filesystem::remove(filename);
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            std::filesystem::remove(filename);
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
+    void UnitTestKeyStore(const TEST_CASE_UTCKKSRNS_SER& testData, const std::string& failmsg = std::string()) {
+        TestKeyStore(testData, SerType::JSON, failmsg + "_json");
+        TestKeyStore(testData, SerType::BINARY, failmsg + "_binary");
+    }
+
+    template <typename ST>
+    void TestKeyStream(const TEST_CASE_UTCKKSRNS_SER& testData, const ST& sertype,
+                       const std::string& failmsg = std::string()) {
+        try {
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            KeyPair<Element> kp = cc->KeyGen();
+            cc->EvalRotateKeyGen(kp.secretKey, {1, 2, 3, -1});
+            const std::string keyTag = kp.secretKey->GetKeyTag();
+            const auto allKeys       = CryptoContextImpl<DCRTPoly>::GetEvalAutomorphismKeyMapPtr(keyTag);
+
+            std::stringstream s;
+            EXPECT_TRUE(CryptoContextImpl<DCRTPoly>::SerializeEvalAutomorphismKeyStream(s, sertype, keyTag))
+                << failmsg << " key stream serialization failed";
+            const std::string serialized = s.str();
+
+            // all keys
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            std::stringstream sAll(serialized);
+            EXPECT_TRUE(CryptoContextImpl<DCRTPoly>::DeserializeEvalAutomorphismKeyStream(sAll, sertype))
+                << failmsg << " key stream deserialization failed";
+            const auto newKeys = CryptoContextImpl<DCRTPoly>::GetEvalAutomorphismKeyMapPtr(keyTag);
+            EXPECT_EQ(newKeys->size(), allKeys->size()) << failmsg << " wrong number of deserialized keys";
+            for (const auto& [indx, key] : *allKeys) {
+                auto it = newKeys->find(indx);
+                EXPECT_TRUE(it != newKeys->end() && *key == *it->second)
+                    << failmsg << " key mismatch for index " << indx;
+            }
+
+            // a subset of the keys; the other keys are skipped
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            const std::vector<uint32_t> subset = {cc->FindAutomorphismIndex(1), cc->FindAutomorphismIndex(-1)};
+            std::stringstream sSubset(serialized);
+            EXPECT_TRUE(CryptoContextImpl<DCRTPoly>::DeserializeEvalAutomorphismKeyStream(sSubset, sertype, subset))
+                << failmsg << " partial key stream deserialization failed";
+            EXPECT_EQ(CryptoContextImpl<DCRTPoly>::GetEvalAutomorphismKeyMapPtr(keyTag)->size(), subset.size())
+                << failmsg << " wrong number of keys in the subset";
+
+            std::vector<std::complex<double>> vals = {1.0, 3.0, 5.0, 7.0, 9.0, 2.0, 4.0, 6.0};
+            Plaintext plaintext                    = cc->MakeCKKSPackedPlaintext(vals);
+            Ciphertext<DCRTPoly> ciphertext        = cc->Encrypt(kp.publicKey, plaintext);
+            Plaintext result;
+            cc->Decrypt(kp.secretKey, cc->EvalRotate(ciphertext, 1), &result);
+            result->SetLength(vals.size() - 1);
+            std::vector<std::complex<double>> rotated(vals.begin() + 1, vals.end());
+            checkEquality(rotated, result->GetCKKSPackedValue(), eps,
+                          failmsg + " EvalRotate with a streamed key fails");
+
+            std::stringstream sMissing(serialized);
+            EXPECT_THROW(CryptoContextImpl<DCRTPoly>::DeserializeEvalAutomorphismKeyStream(
+                             sMissing, sertype, std::vector<uint32_t>{cc->FindAutomorphismIndex(4)}),
+                         OpenFHEException)
+                << failmsg << " a missing key is not reported";
+
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
+    void UnitTestKeyStream(const TEST_CASE_UTCKKSRNS_SER& testData, const std::string& failmsg = std::string()) {
+        TestKeyStream(testData, SerType::JSON, failmsg + "_json");
+        TestKeyStream(testData, SerType::BINARY, failmsg + "_binary");
     }
 };
 //===========================================================================================================
@@ -467,6 +791,12 @@ TEST_P(UTCKKSRNS_SER, CKKSSer) {
         UnitTestKeysAndCiphertexts(test, test.buildTestName());
     else if (test.testCaseType == NO_CRT_TABLES)
         UnitTestDecryptionSerNoCRTTables(test, test.buildTestName());
+    else if (test.testCaseType == SEED_COMPRESSION)
+        UnitTestSeedCompression(test, test.buildTestName());
+    else if (test.testCaseType == KEY_STORE)
+        UnitTestKeyStore(test, test.buildTestName());
+    else if (test.testCaseType == KEY_STREAM)
+        UnitTestKeyStream(test, test.buildTestName());
 }
 
 INSTANTIATE_TEST_SUITE_P(UnitTests, UTCKKSRNS_SER, ::testing::ValuesIn(testCases), testName);
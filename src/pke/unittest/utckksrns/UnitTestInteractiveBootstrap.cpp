@@ -259,8 +259,8 @@ protected:
 
             // Generate evalsum key
             cc->EvalSumKeyGen(kp1.secretKey);
-            auto evalSumKeys =
-                std::make_shared<std::map<usint, EvalKey<DCRTPoly>>>(cc->GetEvalSumKeyMap(kp1.secretKey->GetKeyTag()));
+            auto evalSumKeys = std::make_shared<std::map<usint, EvalKey<DCRTPoly>>>(
+                *cc->GetEvalSumKeyMapPtr(kp1.secretKey->GetKeyTag()));
 
             kp2 = cc->MultipartyKeyGen(kp1.publicKey);
             if (!kp2.good())